@@ -0,0 +1,154 @@
+// c-api-examples/streaming-zipformer-engine-c-api.c
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+//
+// This file demonstrates how to decode several streams concurrently with
+// the asynchronous streaming recognition engine of sherpa-onnx's C API.
+// clang-format off
+//
+// wget https://github.com/k2-fsa/sherpa-onnx/releases/download/asr-models/sherpa-onnx-streaming-zipformer-en-20M-2023-02-17.tar.bz2
+// tar xvf sherpa-onnx-streaming-zipformer-en-20M-2023-02-17.tar.bz2
+// rm sherpa-onnx-streaming-zipformer-en-20M-2023-02-17.tar.bz2
+//
+// clang-format on
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sherpa-onnx/c-api/c-api.h"
+
+#define NUM_WAVES 3
+
+// Return 1 if it is the last event of a stream
+static int32_t PrintEvent(const SherpaOnnxOnlineRecognizerEngineEvent *e) {
+  if ((e->is_endpoint || e->is_final) && strlen(e->result->text)) {
+    fprintf(stderr, "stream %d: %s\n", e->stream_id, e->result->text);
+  }
+
+  return e->is_final;
+}
+
+int32_t main() {
+  const char *wav_filenames[NUM_WAVES] = {
+      "sherpa-onnx-streaming-zipformer-en-20M-2023-02-17/test_wavs/0.wav",
+      "sherpa-onnx-streaming-zipformer-en-20M-2023-02-17/test_wavs/1.wav",
+      "sherpa-onnx-streaming-zipformer-en-20M-2023-02-17/test_wavs/8k.wav",
+  };
+  const char *encoder_filename =
+      "sherpa-onnx-streaming-zipformer-en-20M-2023-02-17/"
+      "encoder-epoch-99-avg-1.onnx";
+  const char *decoder_filename =
+      "sherpa-onnx-streaming-zipformer-en-20M-2023-02-17/"
+      "decoder-epoch-99-avg-1.onnx";
+  const char *joiner_filename =
+      "sherpa-onnx-streaming-zipformer-en-20M-2023-02-17/"
+      "joiner-epoch-99-avg-1.onnx";
+  const char *tokens_filename =
+      "sherpa-onnx-streaming-zipformer-en-20M-2023-02-17/tokens.txt";
+
+  const SherpaOnnxWave *waves[NUM_WAVES];
+  for (int32_t i = 0; i != NUM_WAVES; ++i) {
+    waves[i] = SherpaOnnxReadWave(wav_filenames[i]);
+    if (waves[i] == NULL) {
+      fprintf(stderr, "Failed to read %s\n", wav_filenames[i]);
+      return -1;
+    }
+  }
+
+  // Recognizer config
+  SherpaOnnxOnlineRecognizerConfig recognizer_config;
+  memset(&recognizer_config, 0, sizeof(recognizer_config));
+  recognizer_config.decoding_method = "greedy_search";
+  recognizer_config.model_config.num_threads = 1;
+  recognizer_config.model_config.provider = "cpu";
+  recognizer_config.model_config.tokens = tokens_filename;
+  recognizer_config.model_config.transducer.encoder = encoder_filename;
+  recognizer_config.model_config.transducer.decoder = decoder_filename;
+  recognizer_config.model_config.transducer.joiner = joiner_filename;
+  recognizer_config.enable_endpoint = 1;
+
+  const SherpaOnnxOnlineRecognizer *recognizer =
+      SherpaOnnxCreateOnlineRecognizer(&recognizer_config);
+
+  if (recognizer == NULL) {
+    fprintf(stderr, "Please check your config!\n");
+    return -1;
+  }
+
+  // Engine config
+  SherpaOnnxOnlineRecognizerEngineConfig engine_config;
+  memset(&engine_config, 0, sizeof(engine_config));
+  engine_config.num_workers = 2;
+  engine_config.max_batch_size = NUM_WAVES;
+
+  // Without a callback, events are retrieved with
+  // SherpaOnnxOnlineRecognizerEngineGetEvent()
+  const SherpaOnnxOnlineRecognizerEngine *engine =
+      SherpaOnnxCreateOnlineRecognizerEngine(recognizer, &engine_config, NULL,
+                                             NULL);
+
+  int32_t stream_ids[NUM_WAVES];
+  for (int32_t i = 0; i != NUM_WAVES; ++i) {
+    stream_ids[i] = SherpaOnnxOnlineRecognizerEngineAddStream(engine, NULL);
+  }
+
+  // simulate streaming. Chunks of all waves are submitted in turn.
+  // You can choose an arbitrary N
+#define N 3200
+
+  float tail_paddings[4800] = {0};
+
+  int32_t max_num_samples = 0;
+  for (int32_t i = 0; i != NUM_WAVES; ++i) {
+    if (waves[i]->num_samples > max_num_samples) {
+      max_num_samples = waves[i]->num_samples;
+    }
+  }
+
+  int32_t num_finished = 0;
+  for (int32_t k = 0; k < max_num_samples; k += N) {
+    for (int32_t i = 0; i != NUM_WAVES; ++i) {
+      const SherpaOnnxWave *wave = waves[i];
+      if (k >= wave->num_samples) {
+        continue;
+      }
+
+      int32_t end = (k + N > wave->num_samples) ? wave->num_samples : (k + N);
+      SherpaOnnxOnlineRecognizerEngineAcceptWaveform(
+          engine, stream_ids[i], wave->sample_rate, wave->samples + k,
+          end - k);
+
+      if (end == wave->num_samples) {
+        SherpaOnnxOnlineRecognizerEngineAcceptWaveform(
+            engine, stream_ids[i], wave->sample_rate, tail_paddings, 4800);
+        SherpaOnnxOnlineRecognizerEngineInputFinished(engine, stream_ids[i]);
+      }
+    }
+
+    // Results are decoded in the background. Take the events that are
+    // available without waiting.
+    const SherpaOnnxOnlineRecognizerEngineEvent *e;
+    while ((e = SherpaOnnxOnlineRecognizerEngineGetEvent(engine, 0))) {
+      num_finished += PrintEvent(e);
+      SherpaOnnxDestroyOnlineRecognizerEngineEvent(e);
+    }
+  }
+
+  while (num_finished < NUM_WAVES) {
+    const SherpaOnnxOnlineRecognizerEngineEvent *e =
+        SherpaOnnxOnlineRecognizerEngineGetEvent(engine, -1);
+    num_finished += PrintEvent(e);
+    SherpaOnnxDestroyOnlineRecognizerEngineEvent(e);
+  }
+
+  SherpaOnnxDestroyOnlineRecognizerEngine(engine);
+  SherpaOnnxDestroyOnlineRecognizer(recognizer);
+
+  for (int32_t i = 0; i != NUM_WAVES; ++i) {
+    SherpaOnnxFreeWave(waves[i]);
+  }
+
+  return 0;
+}
@@ -262,6 +262,8 @@ final class SherpaOnnxOfflineTtsPocketModelConfig extends Struct {
 
   @Int32()
   external int voiceEmbeddingCacheCapacity;
+
+  external Pointer<Utf8> voiceEmbeddingCacheDir;
 }
 
 final class SherpaOnnxOfflineTtsSupertonicModelConfig extends Struct {
@@ -63,6 +63,14 @@ def get_args():
         help="Port of the server",
     )
 
+    parser.add_argument(
+        "--model",
+        type=str,
+        default="",
+        help="Name of the model to use if the server is started with "
+        "--models. Leave it empty to use the default model of the server",
+    )
+
     parser.add_argument(
         "sound_files",
         type=str,
@@ -106,10 +114,15 @@ async def run(
     server_addr: str,
     server_port: int,
     sound_files: List[str],
+    model: str,
 ):
     async with websockets.connect(
         f"ws://{server_addr}:{server_port}"
     ) as websocket:  # noqa
+        if model:
+            # It is used for all files sent over this connection
+            await websocket.send(f"model={model}")
+
         for wave_filename in sound_files:
             logging.info(f"Sending {wave_filename}")
             samples, sample_rate = read_wave(wave_filename)
@@ -148,6 +161,7 @@ async def main():
         server_addr=server_addr,
         server_port=server_port,
         sound_files=sound_files,
+        model=args.model,
     )
 
 
@@ -25,6 +25,7 @@ fn main() {
                     "./sherpa-onnx-pocket-tts-int8-2026-01-26/token_scores.json".into(),
                 ),
                 voice_embedding_cache_capacity: 50,
+                voice_embedding_cache_dir: None,
             },
             num_threads: 2,
             debug: false, // set to true to see verbose logs
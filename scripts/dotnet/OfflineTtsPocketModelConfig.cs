@@ -18,6 +18,7 @@ namespace SherpaOnnx
             VocabJson = "";
             TokenScoresJson = "";
             VoiceEmbeddingCacheCapacity = 50;
+            VoiceEmbeddingCacheDir = "";
         }
 
         [MarshalAs(UnmanagedType.LPStr)]
@@ -42,6 +43,9 @@ namespace SherpaOnnx
         public string TokenScoresJson;
 
         public int VoiceEmbeddingCacheCapacity;
+
+        [MarshalAs(UnmanagedType.LPStr)]
+        public string VoiceEmbeddingCacheDir;
     }
 }
 
@@ -1031,6 +1031,7 @@ type OfflineTtsPocketModelConfig struct {
 	VocabJson                   string // vocab_json
 	TokenScoresJson             string // token_scores_json
 	VoiceEmbeddingCacheCapacity int    // voice_embedding_cache_capacity
+	VoiceEmbeddingCacheDir      string // voice_embedding_cache_dir
 }
 
 type OfflineTtsZipvoiceModelConfig struct {
@@ -1328,6 +1329,9 @@ func NewOfflineTts(config *OfflineTtsConfig) *OfflineTts {
 
 	c.model.pocket.voice_embedding_cache_capacity = C.int(config.Model.Pocket.VoiceEmbeddingCacheCapacity)
 
+	c.model.pocket.voice_embedding_cache_dir = C.CString(config.Model.Pocket.VoiceEmbeddingCacheDir)
+	defer C.free(unsafe.Pointer(c.model.pocket.voice_embedding_cache_dir))
+
 	// supertonic
 	c.model.supertonic.duration_predictor = C.CString(config.Model.Supertonic.DurationPredictor)
 	defer C.free(unsafe.Pointer(c.model.supertonic.duration_predictor))
@@ -22,6 +22,7 @@
 #include "sherpa-onnx/csrc/circular-buffer.h"
 #include "sherpa-onnx/csrc/display.h"
 #include "sherpa-onnx/csrc/file-utils.h"
+#include "sherpa-onnx/csrc/global-thread-pool.h"
 #include "sherpa-onnx/csrc/keyword-spotter.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/offline-diacritization.h"
@@ -30,6 +31,7 @@
 #include "sherpa-onnx/csrc/offline-source-separation.h"
 #include "sherpa-onnx/csrc/offline-speech-denoiser.h"
 #include "sherpa-onnx/csrc/online-punctuation.h"
+#include "sherpa-onnx/csrc/online-recognizer-engine.h"
 #include "sherpa-onnx/csrc/online-recognizer.h"
 #include "sherpa-onnx/csrc/online-speech-denoiser.h"
 #include "sherpa-onnx/csrc/resample.h"
@@ -59,6 +61,14 @@ const char *SherpaOnnxGetOnnxruntimeVersionStr() {
   return sherpa_onnx::GetOnnxruntimeVersionStr();
 }
 
+int32_t SherpaOnnxInitGlobalThreadPools(int32_t intra_op_num_threads,
+                                        int32_t inter_op_num_threads,
+                                        int32_t allow_spinning) {
+  sherpa_onnx::GlobalThreadPoolConfig config(
+      intra_op_num_threads, inter_op_num_threads, allow_spinning != 0);
+  return sherpa_onnx::InitGlobalThreadPools(config);
+}
+
 // On WASM builds, multi-threading is not supported. Clamp num_threads to 1.
 static int32_t GetNumThreads(int32_t num_threads) {
   int32_t n = SHERPA_ONNX_OR(num_threads, 1);
@@ -281,12 +291,8 @@ void SherpaOnnxDecodeMultipleOnlineStreams(
   recognizer->impl->DecodeStreams(ss.data(), n);
 }
 
-const SherpaOnnxOnlineRecognizerResult *SherpaOnnxGetOnlineStreamResult(
-    const SherpaOnnxOnlineRecognizer *recognizer,
-    const SherpaOnnxOnlineStream *stream) {
-  if (!recognizer || !stream) return nullptr;
-  sherpa_onnx::OnlineRecognizerResult result =
-      recognizer->impl->GetResult(stream->impl.get());
+static const SherpaOnnxOnlineRecognizerResult *ConvertOnlineResult(
+    const sherpa_onnx::OnlineRecognizerResult &result) {
   const auto &text = result.text;
 
   auto r = new SherpaOnnxOnlineRecognizerResult;
@@ -346,6 +352,16 @@ const SherpaOnnxOnlineRecognizerResult *SherpaOnnxGetOnlineStreamResult(
   return r;
 }
 
+const SherpaOnnxOnlineRecognizerResult *SherpaOnnxGetOnlineStreamResult(
+    const SherpaOnnxOnlineRecognizer *recognizer,
+    const SherpaOnnxOnlineStream *stream) {
+  if (!recognizer || !stream) return nullptr;
+  sherpa_onnx::OnlineRecognizerResult result =
+      recognizer->impl->GetResult(stream->impl.get());
+
+  return ConvertOnlineResult(result);
+}
+
 void SherpaOnnxDestroyOnlineRecognizerResult(
     const SherpaOnnxOnlineRecognizerResult *r) {
   if (r) {
@@ -411,6 +427,102 @@ int32_t SherpaOnnxOnlineStreamIsEndpoint(
   return recognizer->impl->IsEndpoint(stream->impl.get());
 }
 
+struct SherpaOnnxOnlineRecognizerEngine {
+  std::unique_ptr<sherpa_onnx::OnlineRecognizerEngine> impl;
+};
+
+static const SherpaOnnxOnlineRecognizerEngineEvent *ConvertEngineEvent(
+    const sherpa_onnx::OnlineRecognizerEngineEvent &event) {
+  auto ans = new SherpaOnnxOnlineRecognizerEngineEvent;
+  ans->stream_id = event.stream_id;
+  ans->is_endpoint = event.is_endpoint;
+  ans->is_final = event.is_final;
+  ans->result = ConvertOnlineResult(event.result);
+
+  return ans;
+}
+
+const SherpaOnnxOnlineRecognizerEngine *SherpaOnnxCreateOnlineRecognizerEngine(
+    const SherpaOnnxOnlineRecognizer *recognizer,
+    const SherpaOnnxOnlineRecognizerEngineConfig *config,
+    SherpaOnnxOnlineRecognizerEngineCallback callback, void *arg) {
+  if (!recognizer || !config) return nullptr;
+
+  sherpa_onnx::OnlineRecognizerEngineConfig engine_config;
+  engine_config.num_workers = SHERPA_ONNX_OR(config->num_workers, 1);
+  engine_config.max_batch_size = SHERPA_ONNX_OR(config->max_batch_size, 32);
+
+  if (!engine_config.Validate()) {
+    SHERPA_ONNX_LOGE("Errors in config");
+    return nullptr;
+  }
+
+  sherpa_onnx::OnlineRecognizerEngineCallback cb;
+  if (callback) {
+    cb = [callback, arg](const sherpa_onnx::OnlineRecognizerEngineEvent &e) {
+      auto event = ConvertEngineEvent(e);
+      callback(event, arg);
+      SherpaOnnxDestroyOnlineRecognizerEngineEvent(event);
+    };
+  }
+
+  auto engine = new SherpaOnnxOnlineRecognizerEngine;
+  engine->impl = std::make_unique<sherpa_onnx::OnlineRecognizerEngine>(
+      recognizer->impl.get(), engine_config, std::move(cb));
+
+  return engine;
+}
+
+void SherpaOnnxDestroyOnlineRecognizerEngine(
+    const SherpaOnnxOnlineRecognizerEngine *engine) {
+  delete engine;
+}
+
+int32_t SherpaOnnxOnlineRecognizerEngineAddStream(
+    const SherpaOnnxOnlineRecognizerEngine *engine, const char *hotwords) {
+  if (!engine) return -1;
+  return engine->impl->AddStream(hotwords ? hotwords : "");
+}
+
+int32_t SherpaOnnxOnlineRecognizerEngineAcceptWaveform(
+    const SherpaOnnxOnlineRecognizerEngine *engine, int32_t stream_id,
+    int32_t sample_rate, const float *samples, int32_t n) {
+  if (!engine || !samples) return 0;
+  return engine->impl->AcceptWaveform(stream_id, sample_rate, samples, n);
+}
+
+void SherpaOnnxOnlineRecognizerEngineInputFinished(
+    const SherpaOnnxOnlineRecognizerEngine *engine, int32_t stream_id) {
+  if (!engine) return;
+  engine->impl->InputFinished(stream_id);
+}
+
+const SherpaOnnxOnlineRecognizerEngineEvent *
+SherpaOnnxOnlineRecognizerEngineGetEvent(
+    const SherpaOnnxOnlineRecognizerEngine *engine, int32_t timeout_ms) {
+  if (!engine) return nullptr;
+
+  sherpa_onnx::OnlineRecognizerEngineEvent event;
+  if (!engine->impl->GetEvent(&event, timeout_ms)) {
+    return nullptr;
+  }
+
+  return ConvertEngineEvent(event);
+}
+
+void SherpaOnnxDestroyOnlineRecognizerEngineEvent(
+    const SherpaOnnxOnlineRecognizerEngineEvent *event) {
+  if (!event) return;
+  SherpaOnnxDestroyOnlineRecognizerResult(event->result);
+  delete event;
+}
+
+void SherpaOnnxOnlineRecognizerEngineWait(
+    const SherpaOnnxOnlineRecognizerEngine *engine) {
+  if (!engine) return;
+  engine->impl->Wait();
+}
+
 const SherpaOnnxDisplay *SherpaOnnxCreateDisplay(int32_t max_word_per_line) {
   SherpaOnnxDisplay *ans = new SherpaOnnxDisplay;
   ans->impl = std::make_unique<sherpa_onnx::Display>(max_word_per_line);
@@ -1576,6 +1688,8 @@ static sherpa_onnx::OfflineTtsConfig GetOfflineTtsConfig(
   } else {
     tts_config.model.pocket.voice_embedding_cache_capacity = 50;
   }
+  tts_config.model.pocket.voice_embedding_cache_dir =
+      SHERPA_ONNX_OR(config->model.pocket.voice_embedding_cache_dir, "");
 
   // supertonic
   tts_config.model.supertonic.duration_predictor =
@@ -2220,6 +2334,45 @@ void SherpaOnnxDestroySpokenLanguageIdentificationResult(
   }
 }
 
+const SherpaOnnxSpokenLanguageIdentificationResult *const *
+SherpaOnnxSpokenLanguageIdentificationComputeBatch(
+    const SherpaOnnxSpokenLanguageIdentification *slid,
+    const SherpaOnnxOfflineStream **streams, int32_t n) {
+  if (!slid || !streams || n <= 0) return nullptr;
+
+  std::vector<sherpa_onnx::OfflineStream *> ss(n);
+  for (int32_t i = 0; i != n; ++i) {
+    ss[i] = streams[i]->impl.get();
+  }
+
+  std::vector<std::string> langs = slid->impl->Compute(ss.data(), n);
+
+  SherpaOnnxSpokenLanguageIdentificationResult **ans =
+      new SherpaOnnxSpokenLanguageIdentificationResult *[n];
+  for (int32_t i = 0; i != n; ++i) {
+    const std::string &lang = langs[i];
+    char *c_lang = new char[lang.size() + 1];
+    std::copy(lang.begin(), lang.end(), c_lang);
+    c_lang[lang.size()] = '\0';
+
+    ans[i] = new SherpaOnnxSpokenLanguageIdentificationResult;
+    ans[i]->lang = c_lang;
+  }
+
+  return ans;
+}
+
+void SherpaOnnxDestroySpokenLanguageIdentificationBatchResult(
+    const SherpaOnnxSpokenLanguageIdentificationResult *const *r, int32_t n) {
+  if (!r) return;
+
+  for (int32_t i = 0; i != n; ++i) {
+    SherpaOnnxDestroySpokenLanguageIdentificationResult(r[i]);
+  }
+
+  delete[] r;
+}
+
 struct SherpaOnnxSpeakerEmbeddingExtractor {
   std::unique_ptr<sherpa_onnx::SpeakerEmbeddingExtractor> impl;
 };
@@ -2528,12 +2681,8 @@ const SherpaOnnxOfflineStream *SherpaOnnxAudioTaggingCreateOfflineStream(
   return stream;
 }
 
-const SherpaOnnxAudioEvent *const *SherpaOnnxAudioTaggingCompute(
-    const SherpaOnnxAudioTagging *tagger, const SherpaOnnxOfflineStream *s,
-    int32_t top_k) {
-  std::vector<sherpa_onnx::AudioEvent> events =
-      tagger->impl->Compute(s->impl.get(), top_k);
-
+static const SherpaOnnxAudioEvent *const *ConvertAudioEvents(
+    const std::vector<sherpa_onnx::AudioEvent> &events) {
   int32_t n = static_cast<int32_t>(events.size());
   SherpaOnnxAudioEvent **ans = new SherpaOnnxAudioEvent *[n + 1];
   ans[n] = nullptr;
@@ -2558,6 +2707,12 @@ const SherpaOnnxAudioEvent *const *SherpaOnnxAudioTaggingCompute(
   return ans;
 }
 
+const SherpaOnnxAudioEvent *const *SherpaOnnxAudioTaggingCompute(
+    const SherpaOnnxAudioTagging *tagger, const SherpaOnnxOfflineStream *s,
+    int32_t top_k) {
+  return ConvertAudioEvents(tagger->impl->Compute(s->impl.get(), top_k));
+}
+
 void SherpaOnnxAudioTaggingFreeResults(
     const SherpaOnnxAudioEvent *const *events) {
   auto p = events;
@@ -2574,6 +2729,39 @@ void SherpaOnnxAudioTaggingFreeResults(
   delete[] events;
 }
 
+const SherpaOnnxAudioEvent *const *const *SherpaOnnxAudioTaggingComputeBatch(
+    const SherpaOnnxAudioTagging *tagger,
+    const SherpaOnnxOfflineStream **streams, int32_t n, int32_t top_k) {
+  if (!tagger || !streams || n <= 0) return nullptr;
+
+  std::vector<sherpa_onnx::OfflineStream *> ss(n);
+  for (int32_t i = 0; i != n; ++i) {
+    ss[i] = streams[i]->impl.get();
+  }
+
+  std::vector<std::vector<sherpa_onnx::AudioEvent>> events =
+      tagger->impl->Compute(ss.data(), n, top_k);
+
+  const SherpaOnnxAudioEvent *const **ans =
+      new const SherpaOnnxAudioEvent *const *[n];
+  for (int32_t i = 0; i != n; ++i) {
+    ans[i] = ConvertAudioEvents(events[i]);
+  }
+
+  return ans;
+}
+
+void SherpaOnnxAudioTaggingFreeBatchResults(
+    const SherpaOnnxAudioEvent *const *const *p, int32_t n) {
+  if (!p) return;
+
+  for (int32_t i = 0; i != n; ++i) {
+    SherpaOnnxAudioTaggingFreeResults(p[i]);
+  }
+
+  delete[] p;
+}
+
 struct SherpaOnnxOfflinePunctuation {
   std::unique_ptr<sherpa_onnx::OfflinePunctuation> impl;
 };
@@ -160,6 +160,29 @@ SHERPA_ONNX_API const char *SherpaOnnxGetGitDate();
  */
 SHERPA_ONNX_API const char *SherpaOnnxGetOnnxruntimeVersionStr();
 
+/**
+ * @brief Create onnxruntime thread pools shared by all models that opt in.
+ *
+ * It must be called before any model is created. A model opts in with
+ * `UseGlobalThreadPools=1` in its provider config file, e.g., with
+ * `provider = "cpu:/path/to/config.txt"`. Its `num_threads` is then
+ * ignored.
+ *
+ * @param intra_op_num_threads Number of threads of the shared intra-op pool.
+ *                             0 means one thread per physical core.
+ * @param inter_op_num_threads Number of threads of the shared inter-op pool.
+ * @param allow_spinning 1 to let idle threads spin; 0 to let them block.
+ * @return 1 on success; 0 if the arguments are invalid, the pools have
+ *         already been created, or a model has already been created.
+ *
+ * @code
+ * SherpaOnnxInitGlobalThreadPools(8, 1, 0);
+ * @endcode
+ */
+SHERPA_ONNX_API int32_t SherpaOnnxInitGlobalThreadPools(
+    int32_t intra_op_num_threads, int32_t inter_op_num_threads,
+    int32_t allow_spinning);
+
 /**
  * @brief Check whether a file exists.
  *
@@ -732,6 +755,10 @@ SHERPA_ONNX_API void SherpaOnnxOnlineStreamInputFinished(
  * This is a generic extension point for model-specific or runtime-specific
  * options such as "is_final" for streaming Paraformer.
  *
+ * For streaming transducer and CTC models, "silence_threshold_db" (e.g.,
+ * "-50") skips the model for chunks whose audio energy, in dB relative to
+ * full scale, stays below the given value.
+ *
  * @param stream A pointer returned by SherpaOnnxCreateOnlineStream().
  * @param key Option name.
  * @param value Option value represented as text.
@@ -790,6 +817,178 @@ SHERPA_ONNX_API int32_t
 SherpaOnnxOnlineStreamIsEndpoint(const SherpaOnnxOnlineRecognizer *recognizer,
                                  const SherpaOnnxOnlineStream *stream);
 
+/**
+ * @brief Configuration for SherpaOnnxCreateOnlineRecognizerEngine().
+ */
+typedef struct SherpaOnnxOnlineRecognizerEngineConfig {
+  /** Number of decoding threads. Defaults to 1 when set to 0. */
+  int32_t num_workers;
+
+  /** Maximum number of streams decoded together. Defaults to 32 when set
+   *  to 0. */
+  int32_t max_batch_size;
+} SherpaOnnxOnlineRecognizerEngineConfig;
+
+/**
+ * @brief Event generated by a streaming recognition engine.
+ *
+ * An event is generated when the result of a stream changes, when an
+ * endpoint is detected and when a stream is finished.
+ */
+typedef struct SherpaOnnxOnlineRecognizerEngineEvent {
+  /** ID returned by SherpaOnnxOnlineRecognizerEngineAddStream(). */
+  int32_t stream_id;
+
+  /**
+   * 1 if an endpoint is detected. The stream is reset after this event, so
+   * the next result starts from an empty text.
+   */
+  int32_t is_endpoint;
+
+  /**
+   * 1 for the last event of a stream. The stream ID becomes invalid after
+   * this event.
+   */
+  int32_t is_final;
+
+  /** Recognition result of the stream. */
+  const SherpaOnnxOnlineRecognizerResult *result;
+} SherpaOnnxOnlineRecognizerEngineEvent;
+
+/**
+ * @brief Callback receiving events of a streaming recognition engine.
+ *
+ * It is invoked from a decoding thread. Events of the same stream are
+ * delivered in order and never concurrently. The event is owned by the
+ * engine and is valid only during the call.
+ */
+typedef void (*SherpaOnnxOnlineRecognizerEngineCallback)(
+    const SherpaOnnxOnlineRecognizerEngineEvent *event, void *arg);
+
+/** @brief Asynchronous streaming recognition engine handle. */
+typedef struct SherpaOnnxOnlineRecognizerEngine
+    SherpaOnnxOnlineRecognizerEngine;
+
+/**
+ * @brief Create an engine that decodes many streams asynchronously.
+ *
+ * Audio passed to SherpaOnnxOnlineRecognizerEngineAcceptWaveform() is decoded
+ * by a pool of threads. Streams that are ready at the same time are decoded
+ * together in a batch. Results are delivered to @p callback or, if it is
+ * NULL, queued for SherpaOnnxOnlineRecognizerEngineGetEvent().
+ *
+ * @param recognizer A pointer returned by SherpaOnnxCreateOnlineRecognizer().
+ *                   It must outlive the engine.
+ * @param config Engine configuration.
+ * @param callback Optional callback. Pass NULL to poll for events.
+ * @param arg User data passed to @p callback.
+ * @return A newly allocated engine, or NULL on error. Free it with
+ *         SherpaOnnxDestroyOnlineRecognizerEngine().
+ *
+ * @code
+ * SherpaOnnxOnlineRecognizerEngineConfig engine_config;
+ * memset(&engine_config, 0, sizeof(engine_config));
+ * engine_config.num_workers = 2;
+ * const SherpaOnnxOnlineRecognizerEngine *engine =
+ *     SherpaOnnxCreateOnlineRecognizerEngine(recognizer, &engine_config,
+ *                                            NULL, NULL);
+ * @endcode
+ */
+SHERPA_ONNX_API const SherpaOnnxOnlineRecognizerEngine *
+SherpaOnnxCreateOnlineRecognizerEngine(
+    const SherpaOnnxOnlineRecognizer *recognizer,
+    const SherpaOnnxOnlineRecognizerEngineConfig *config,
+    SherpaOnnxOnlineRecognizerEngineCallback callback, void *arg);
+
+/**
+ * @brief Destroy an engine.
+ *
+ * It waits until all audio received so far is decoded.
+ *
+ * @param engine A pointer returned by SherpaOnnxCreateOnlineRecognizerEngine().
+ */
+SHERPA_ONNX_API void SherpaOnnxDestroyOnlineRecognizerEngine(
+    const SherpaOnnxOnlineRecognizerEngine *engine);
+
+/**
+ * @brief Add a stream to an engine.
+ *
+ * @param engine A pointer returned by SherpaOnnxCreateOnlineRecognizerEngine().
+ * @param hotwords Optional hotwords for this stream. See
+ *                 SherpaOnnxCreateOnlineStreamWithHotwords(). Can be NULL.
+ * @return The ID of the new stream.
+ */
+SHERPA_ONNX_API int32_t SherpaOnnxOnlineRecognizerEngineAddStream(
+    const SherpaOnnxOnlineRecognizerEngine *engine, const char *hotwords);
+
+/**
+ * @brief Submit audio samples of a stream for decoding.
+ *
+ * It copies the samples and returns without waiting for decoding.
+ *
+ * @param engine A pointer returned by SherpaOnnxCreateOnlineRecognizerEngine().
+ * @param stream_id ID returned by SherpaOnnxOnlineRecognizerEngineAddStream().
+ * @param sample_rate Sample rate of the input samples.
+ * @param samples Samples normalized to the range [-1, 1].
+ * @param n Number of samples.
+ * @return 1 on success; 0 if the stream does not exist or has been finished.
+ */
+SHERPA_ONNX_API int32_t SherpaOnnxOnlineRecognizerEngineAcceptWaveform(
+    const SherpaOnnxOnlineRecognizerEngine *engine, int32_t stream_id,
+    int32_t sample_rate, const float *samples, int32_t n);
+
+/**
+ * @brief Signal that no more audio will be submitted for a stream.
+ *
+ * The last event of the stream has @c is_final set.
+ *
+ * @param engine A pointer returned by SherpaOnnxCreateOnlineRecognizerEngine().
+ * @param stream_id ID returned by SherpaOnnxOnlineRecognizerEngineAddStream().
+ */
+SHERPA_ONNX_API void SherpaOnnxOnlineRecognizerEngineInputFinished(
+    const SherpaOnnxOnlineRecognizerEngine *engine, int32_t stream_id);
+
+/**
+ * @brief Retrieve the next queued event.
+ *
+ * Use it only for engines created without a callback.
+ *
+ * @param engine A pointer returned by SherpaOnnxCreateOnlineRecognizerEngine().
+ * @param timeout_ms Wait at most this number of milliseconds. Wait forever
+ *                   if it is negative.
+ * @return The next event, or NULL on timeout. Free it with
+ *         SherpaOnnxDestroyOnlineRecognizerEngineEvent().
+ *
+ * @code
+ * const SherpaOnnxOnlineRecognizerEngineEvent *e;
+ * while ((e = SherpaOnnxOnlineRecognizerEngineGetEvent(engine, 100))) {
+ *   printf("%d: %s\n", e->stream_id, e->result->text);
+ *   SherpaOnnxDestroyOnlineRecognizerEngineEvent(e);
+ * }
+ * @endcode
+ */
+SHERPA_ONNX_API const SherpaOnnxOnlineRecognizerEngineEvent *
+SherpaOnnxOnlineRecognizerEngineGetEvent(
+    const SherpaOnnxOnlineRecognizerEngine *engine, int32_t timeout_ms);
+
+/**
+ * @brief Destroy an event returned by
+ *        SherpaOnnxOnlineRecognizerEngineGetEvent().
+ *
+ * @param event A pointer returned by
+ *              SherpaOnnxOnlineRecognizerEngineGetEvent().
+ */
+SHERPA_ONNX_API void SherpaOnnxDestroyOnlineRecognizerEngineEvent(
+    const SherpaOnnxOnlineRecognizerEngineEvent *event);
+
+/**
+ * @brief Block until all audio submitted so far is decoded.
+ *
+ * @param engine A pointer returned by SherpaOnnxCreateOnlineRecognizerEngine().
+ */
+SHERPA_ONNX_API void SherpaOnnxOnlineRecognizerEngineWait(
+    const SherpaOnnxOnlineRecognizerEngine *engine);
+
 /**
  * @brief Helper for pretty-printing incremental recognition results.
  *
@@ -2369,6 +2568,9 @@ typedef struct SherpaOnnxOfflineTtsPocketModelConfig {
   const char *token_scores_json;
   /** Voice embedding cache capacity. */
   int32_t voice_embedding_cache_capacity;
+  /** Directory for caching voice embeddings on disk. NULL or empty to
+   *  disable the on-disk cache. */
+  const char *voice_embedding_cache_dir;
 } SherpaOnnxOfflineTtsPocketModelConfig;
 
 /** @brief Configuration for a Supertonic TTS model. */
@@ -3076,6 +3278,39 @@ SherpaOnnxSpokenLanguageIdentificationCompute(
 SHERPA_ONNX_API void SherpaOnnxDestroySpokenLanguageIdentificationResult(
     const SherpaOnnxSpokenLanguageIdentificationResult *r);
 
+/**
+ * @brief Run spoken-language identification on multiple offline streams in
+ * batches.
+ *
+ * Streams of similar lengths are processed together, which is faster than
+ * calling SherpaOnnxSpokenLanguageIdentificationCompute() for each stream.
+ *
+ * @param slid A pointer returned by
+ * SherpaOnnxCreateSpokenLanguageIdentification().
+ * @param streams Array of @p n stream pointers returned by
+ *          SherpaOnnxSpokenLanguageIdentificationCreateOfflineStream().
+ * @param n Number of streams in @p streams.
+ * @return A newly allocated array of @p n results. Entry i is for
+ *         streams[i]. Free it with
+ *         SherpaOnnxDestroySpokenLanguageIdentificationBatchResult().
+ */
+SHERPA_ONNX_API const SherpaOnnxSpokenLanguageIdentificationResult *const *
+SherpaOnnxSpokenLanguageIdentificationComputeBatch(
+    const SherpaOnnxSpokenLanguageIdentification *slid,
+    const SherpaOnnxOfflineStream **streams, int32_t n);
+
+/**
+ * @brief Destroy results returned by
+ * SherpaOnnxSpokenLanguageIdentificationComputeBatch().
+ *
+ * @param r A pointer returned by
+ * SherpaOnnxSpokenLanguageIdentificationComputeBatch().
+ * @param n The number of streams passed to
+ *          SherpaOnnxSpokenLanguageIdentificationComputeBatch().
+ */
+SHERPA_ONNX_API void SherpaOnnxDestroySpokenLanguageIdentificationBatchResult(
+    const SherpaOnnxSpokenLanguageIdentificationResult *const *r, int32_t n);
+
 // ============================================================
 // For speaker embedding extraction
 // ============================================================
@@ -3568,6 +3803,46 @@ SherpaOnnxAudioTaggingCompute(const SherpaOnnxAudioTagging *tagger,
 SHERPA_ONNX_API void SherpaOnnxAudioTaggingFreeResults(
     const SherpaOnnxAudioEvent *const *p);
 
+/**
+ * @brief Run audio tagging on multiple offline streams in batches.
+ *
+ * Streams of similar lengths are processed together, which is faster than
+ * calling SherpaOnnxAudioTaggingCompute() for each stream.
+ *
+ * @param tagger A pointer returned by SherpaOnnxCreateAudioTagging().
+ * @param streams Array of @p n stream pointers returned by
+ *                SherpaOnnxAudioTaggingCreateOfflineStream().
+ * @param n Number of streams in @p streams.
+ * @param top_k Number of top results to return per stream, or -1 to use the
+ *              configured default.
+ * @return A newly allocated array of @p n entries. Entry i has the same
+ *         format as the return value of SherpaOnnxAudioTaggingCompute() and
+ *         is for streams[i]. Free it with
+ *         SherpaOnnxAudioTaggingFreeBatchResults().
+ *
+ * @code
+ * const SherpaOnnxOfflineStream *streams[2] = {stream1, stream2};
+ * const SherpaOnnxAudioEvent *const *const *results =
+ *     SherpaOnnxAudioTaggingComputeBatch(tagger, streams, 2, 5);
+ * printf("%s\n", results[1][0]->name);
+ * SherpaOnnxAudioTaggingFreeBatchResults(results, 2);
+ * @endcode
+ */
+SHERPA_ONNX_API const SherpaOnnxAudioEvent *const *const *
+SherpaOnnxAudioTaggingComputeBatch(const SherpaOnnxAudioTagging *tagger,
+                                   const SherpaOnnxOfflineStream **streams,
+                                   int32_t n, int32_t top_k);
+
+/**
+ * @brief Destroy results returned by SherpaOnnxAudioTaggingComputeBatch().
+ *
+ * @param p A pointer returned by SherpaOnnxAudioTaggingComputeBatch().
+ * @param n The number of streams passed to
+ *          SherpaOnnxAudioTaggingComputeBatch().
+ */
+SHERPA_ONNX_API void SherpaOnnxAudioTaggingFreeBatchResults(
+    const SherpaOnnxAudioEvent *const *const *p, int32_t n);
+
 // ============================================================
 // For punctuation
 // ============================================================
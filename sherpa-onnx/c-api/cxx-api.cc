@@ -544,6 +544,8 @@ OfflineTts OfflineTts::Create(const OfflineTtsConfig &config) {
 
   c.model.pocket.voice_embedding_cache_capacity =
       config.model.pocket.voice_embedding_cache_capacity;
+  c.model.pocket.voice_embedding_cache_dir =
+      config.model.pocket.voice_embedding_cache_dir.c_str();
 
   c.model.supertonic.duration_predictor =
       config.model.supertonic.duration_predictor.c_str();
@@ -963,6 +963,8 @@ struct OfflineTtsPocketModelConfig {
   std::string token_scores_json;
   /** Voice embedding cache size. */
   int32_t voice_embedding_cache_capacity = 50;
+  /** Directory for caching voice embeddings on disk. Empty to disable. */
+  std::string voice_embedding_cache_dir;
 };
 
 /** @brief Supertonic model configuration. */
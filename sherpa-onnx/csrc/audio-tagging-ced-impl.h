@@ -6,6 +6,8 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -18,6 +20,7 @@
 #include "sherpa-onnx/csrc/audio-tagging-impl.h"
 #include "sherpa-onnx/csrc/audio-tagging-label-file.h"
 #include "sherpa-onnx/csrc/audio-tagging.h"
+#include "sherpa-onnx/csrc/bucket-by-length.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/math.h"
 #include "sherpa-onnx/csrc/offline-ced-model.h"
@@ -82,7 +85,75 @@ class AudioTaggingCEDImpl : public AudioTaggingImpl {
 
     Ort::Value probs = model_.Forward(std::move(x));
 
-    const float *p = probs.GetTensorData<float>();
+    return ToEvents(probs.GetTensorData<float>(), top_k);
+  }
+
+  std::vector<std::vector<AudioEvent>> Compute(
+      OfflineStream **ss, int32_t n, int32_t top_k = -1) const override {
+    if (top_k < 0) {
+      top_k = config_.top_k;
+    }
+
+    int32_t num_event_classes = model_.NumEventClasses();
+
+    if (top_k > num_event_classes) {
+      top_k = num_event_classes;
+    }
+
+    auto memory_info =
+        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+
+    // WARNING(fangjun): It is fixed to 64 for CED models
+    int32_t feat_dim = 64;
+
+    std::vector<std::vector<float>> features_vec(n);
+    std::vector<int32_t> num_frames(n);
+    for (int32_t i = 0; i != n; ++i) {
+      features_vec[i] = ss[i]->GetFrames();
+      num_frames[i] = features_vec[i].size() / feat_dim;
+    }
+
+    std::vector<std::vector<AudioEvent>> ans(n);
+
+    // CED models do not take the number of valid frames as input, so
+    // padding would change the result. Only inputs of the same length
+    // are processed together.
+    auto batches = BucketByLength(num_frames, kMaxBatchSize, 1);
+
+    std::vector<float> x_vec;
+    for (const auto &batch : batches) {
+      int32_t batch_size = static_cast<int32_t>(batch.size());
+      int32_t this_num_frames = num_frames[batch[0]];
+
+      x_vec.resize(batch_size * this_num_frames * feat_dim);
+      for (int32_t b = 0; b != batch_size; ++b) {
+        const auto &f = features_vec[batch[b]];
+        std::copy(f.begin(), f.begin() + this_num_frames * feat_dim,
+                  x_vec.begin() + b * this_num_frames * feat_dim);
+      }
+
+      std::array<int64_t, 3> shape = {batch_size, this_num_frames, feat_dim};
+
+      Ort::Value x = Ort::Value::CreateTensor(memory_info, x_vec.data(),
+                                              x_vec.size(), shape.data(),
+                                              shape.size());
+
+      Ort::Value probs = model_.Forward(std::move(x));
+
+      const float *p = probs.GetTensorData<float>();
+      for (int32_t b = 0; b != batch_size; ++b) {
+        ans[batch[b]] = ToEvents(p + b * num_event_classes, top_k);
+      }
+    }
+
+    return ans;
+  }
+
+ private:
+  static constexpr int32_t kMaxBatchSize = 16;
+
+  std::vector<AudioEvent> ToEvents(const float *p, int32_t top_k) const {
+    int32_t num_event_classes = model_.NumEventClasses();
 
     std::vector<int32_t> top_k_indexes = TopkIndex(p, num_event_classes, top_k);
 
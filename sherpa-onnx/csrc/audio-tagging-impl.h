@@ -32,6 +32,9 @@ class AudioTaggingImpl {
 
   virtual std::vector<AudioEvent> Compute(OfflineStream *s,
                                           int32_t top_k = -1) const = 0;
+
+  virtual std::vector<std::vector<AudioEvent>> Compute(
+      OfflineStream **ss, int32_t n, int32_t top_k = -1) const = 0;
 };
 
 }  // namespace sherpa_onnx
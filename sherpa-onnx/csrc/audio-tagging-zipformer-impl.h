@@ -6,6 +6,8 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -18,9 +20,11 @@
 #include "sherpa-onnx/csrc/audio-tagging-impl.h"
 #include "sherpa-onnx/csrc/audio-tagging-label-file.h"
 #include "sherpa-onnx/csrc/audio-tagging.h"
+#include "sherpa-onnx/csrc/bucket-by-length.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/math.h"
 #include "sherpa-onnx/csrc/offline-zipformer-audio-tagging-model.h"
+#include "sherpa-onnx/csrc/pad-sequence.h"
 
 namespace sherpa_onnx {
 
@@ -89,7 +93,87 @@ class AudioTaggingZipformerImpl : public AudioTaggingImpl {
 
     Ort::Value probs = model_.Forward(std::move(x), std::move(x_length));
 
-    const float *p = probs.GetTensorData<float>();
+    return ToEvents(probs.GetTensorData<float>(), top_k);
+  }
+
+  std::vector<std::vector<AudioEvent>> Compute(
+      OfflineStream **ss, int32_t n, int32_t top_k = -1) const override {
+    if (top_k < 0) {
+      top_k = config_.top_k;
+    }
+
+    int32_t num_event_classes = model_.NumEventClasses();
+
+    if (top_k > num_event_classes) {
+      top_k = num_event_classes;
+    }
+
+    auto memory_info =
+        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+
+    // WARNING(fangjun): It is fixed to 80 for all models from icefall
+    int32_t feat_dim = 80;
+
+    std::vector<std::vector<float>> features_vec(n);
+    std::vector<int32_t> num_frames(n);
+    for (int32_t i = 0; i != n; ++i) {
+      features_vec[i] = ss[i]->GetFrames();
+      num_frames[i] = features_vec[i].size() / feat_dim;
+    }
+
+    std::vector<std::vector<AudioEvent>> ans(n);
+
+    // Padded frames are masked out using features_length, so we only need
+    // to keep the amount of padding small.
+    auto batches = BucketByLength(num_frames, kMaxBatchSize, 1.5);
+
+    for (const auto &batch : batches) {
+      int32_t batch_size = static_cast<int32_t>(batch.size());
+
+      std::vector<Ort::Value> features;
+      features.reserve(batch_size);
+
+      std::vector<int64_t> features_length_vec(batch_size);
+
+      for (int32_t b = 0; b != batch_size; ++b) {
+        auto &f = features_vec[batch[b]];
+        std::array<int64_t, 2> shape = {num_frames[batch[b]], feat_dim};
+
+        features.push_back(Ort::Value::CreateTensor(
+            memory_info, f.data(), num_frames[batch[b]] * feat_dim,
+            shape.data(), shape.size()));
+        features_length_vec[b] = num_frames[batch[b]];
+      }
+
+      std::vector<const Ort::Value *> features_pointer(batch_size);
+      for (int32_t b = 0; b != batch_size; ++b) {
+        features_pointer[b] = &features[b];
+      }
+
+      Ort::Value x = PadSequence(model_.Allocator(), features_pointer,
+                                 -23.025850929940457f);
+
+      std::array<int64_t, 1> x_length_shape = {batch_size};
+      Ort::Value x_length = Ort::Value::CreateTensor(
+          memory_info, features_length_vec.data(), batch_size,
+          x_length_shape.data(), x_length_shape.size());
+
+      Ort::Value probs = model_.Forward(std::move(x), std::move(x_length));
+
+      const float *p = probs.GetTensorData<float>();
+      for (int32_t b = 0; b != batch_size; ++b) {
+        ans[batch[b]] = ToEvents(p + b * num_event_classes, top_k);
+      }
+    }
+
+    return ans;
+  }
+
+ private:
+  static constexpr int32_t kMaxBatchSize = 16;
+
+  std::vector<AudioEvent> ToEvents(const float *p, int32_t top_k) const {
+    int32_t num_event_classes = model_.NumEventClasses();
 
     std::vector<int32_t> top_k_indexes = TopkIndex(p, num_event_classes, top_k);
 
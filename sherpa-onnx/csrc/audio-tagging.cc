@@ -86,4 +86,9 @@ std::vector<AudioEvent> AudioTagging::Compute(OfflineStream *s,
   return impl_->Compute(s, top_k);
 }
 
+std::vector<std::vector<AudioEvent>> AudioTagging::Compute(
+    OfflineStream **ss, int32_t n, int32_t top_k /*= -1*/) const {
+  return impl_->Compute(ss, n, top_k);
+}
+
 }  // namespace sherpa_onnx
@@ -65,6 +65,13 @@ class AudioTagging {
   // Return top_k AudioEvent. ans[0].prob is the largest of all returned events.
   std::vector<AudioEvent> Compute(OfflineStream *s, int32_t top_k = -1) const;
 
+  // Process n streams in batches. Streams of similar lengths are put into
+  // the same batch.
+  //
+  // ans[i] contains the result for ss[i]
+  std::vector<std::vector<AudioEvent>> Compute(OfflineStream **ss, int32_t n,
+                                               int32_t top_k = -1) const;
+
  private:
   std::unique_ptr<AudioTaggingImpl> impl_;
 };
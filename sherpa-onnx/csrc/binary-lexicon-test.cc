@@ -0,0 +1,125 @@
+// sherpa-onnx/csrc/binary-lexicon-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/binary-lexicon.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace sherpa_onnx {
+
+static std::unique_ptr<BinaryLexicon> CreateLexicon(
+    const std::unordered_map<std::string, std::vector<int32_t>> &word2ids,
+    int32_t num_tokens) {
+  std::ostringstream os;
+  EXPECT_TRUE(BinaryLexicon::Write(word2ids, num_tokens, os));
+
+  std::string s = os.str();
+  std::vector<char> buf(s.begin(), s.end());
+  EXPECT_TRUE(BinaryLexicon::IsBinaryLexicon(buf.data(), buf.size()));
+
+  return std::make_unique<BinaryLexicon>(
+      std::make_unique<MappedFile>(std::move(buf)));
+}
+
+TEST(BinaryLexicon, Lookup) {
+  std::unordered_map<std::string, std::vector<int32_t>> word2ids = {
+      {"hello", {1, 2, 3}},
+      {"world", {4, 5}},
+      {"你好", {6, 7, 8, 9}},
+      {"a", {10}},
+      {"呣", {}},  // a word with an empty pronunciation
+  };
+
+  auto lexicon = CreateLexicon(word2ids, 20);
+  EXPECT_EQ(lexicon->NumTokens(), 20);
+  EXPECT_EQ(lexicon->NumWords(), 5);
+
+  for (const auto &[word, ids] : word2ids) {
+    EXPECT_TRUE(lexicon->Contains(word));
+
+    std::vector<int32_t> v = {100};
+    EXPECT_TRUE(lexicon->Lookup(word, &v));
+
+    std::vector<int32_t> expected = {100};
+    expected.insert(expected.end(), ids.begin(), ids.end());
+    EXPECT_EQ(v, expected);
+  }
+
+  EXPECT_FALSE(lexicon->Contains("hell"));
+  EXPECT_FALSE(lexicon->Contains("worlds"));
+  EXPECT_FALSE(lexicon->Contains(""));
+  EXPECT_FALSE(lexicon->Contains("你"));
+
+  int32_t n = -1;
+  EXPECT_EQ(lexicon->Find("b", &n), nullptr);
+  EXPECT_EQ(n, 0);
+}
+
+TEST(BinaryLexicon, Empty) {
+  auto lexicon = CreateLexicon({}, 5);
+  EXPECT_EQ(lexicon->NumWords(), 0);
+  EXPECT_FALSE(lexicon->Contains("hello"));
+}
+
+TEST(BinaryLexicon, MappedFile) {
+  std::unordered_map<std::string, std::vector<int32_t>> word2ids = {
+      {"abc", {1, 2}},
+      {"abd", {3}},
+  };
+
+  std::string filename = "binary-lexicon-test.bin";
+  {
+    auto os = OpenOutputFile(filename, std::ios::binary);
+    EXPECT_TRUE(BinaryLexicon::Write(word2ids, 4, os));
+  }
+
+  EXPECT_TRUE(BinaryLexicon::IsBinaryLexicon(filename));
+
+  {
+    BinaryLexicon lexicon(filename);
+    std::vector<int32_t> ids;
+    EXPECT_TRUE(lexicon.Lookup("abd", &ids));
+    EXPECT_EQ(ids, std::vector<int32_t>{3});
+  }
+
+  std::remove(filename.c_str());
+}
+
+TEST(BinaryLexicon, NotBinary) {
+  std::string s = "hello h e l l o\n";
+  EXPECT_FALSE(BinaryLexicon::IsBinaryLexicon(s.data(), s.size()));
+}
+
+TEST(BinaryLexicon, ByteOrder) {
+  std::ostringstream os;
+  EXPECT_TRUE(BinaryLexicon::Write({{"hello", {1, 2}}}, 3, os));
+  std::string s = os.str();
+
+  // The byte order mark follows the magic and 5 integers
+  constexpr size_t kOffset = 8 + 5 * sizeof(uint32_t);
+  uint32_t mark = 0;
+  std::memcpy(&mark, s.data() + kOffset, sizeof(mark));
+  EXPECT_EQ(mark, 0x01020304u);
+
+#if GTEST_HAS_DEATH_TEST
+  // As if it was written on a machine with a different byte order
+  std::vector<char> buf(s.begin(), s.end());
+  std::reverse(buf.begin() + kOffset, buf.begin() + kOffset + sizeof(mark));
+
+  EXPECT_DEATH(BinaryLexicon(std::make_unique<MappedFile>(std::move(buf))),
+               "different byte order");
+#endif
+}
+
+}  // namespace sherpa_onnx
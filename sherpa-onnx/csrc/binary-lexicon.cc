@@ -0,0 +1,246 @@
+// sherpa-onnx/csrc/binary-lexicon.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/binary-lexicon.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sherpa-onnx/csrc/macros.h"
+
+namespace sherpa_onnx {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'O', 'L', 'E', 'X', 'B', 'I', 'N'};
+constexpr uint32_t kVersion = 2;
+
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+// kByteOrderMark read on a machine with a different byte order
+constexpr uint32_t kSwappedByteOrderMark = 0x04030201;
+
+struct BinaryLexiconHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_tokens;
+  uint32_t num_words;
+  uint32_t num_ids;
+  uint32_t words_size;
+  uint32_t byte_order;
+};
+
+static_assert(sizeof(BinaryLexiconHeader) == 32, "");
+
+template <typename T>
+void WriteVector(const std::vector<T> &v, std::ostream &os) {
+  os.write(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(T));
+}
+
+}  // namespace
+
+BinaryLexicon::BinaryLexicon(const std::string &filename)
+    : file_(std::make_unique<MappedFile>(filename)) {
+  if (!file_->Size()) {
+#if __OHOS__
+    SHERPA_ONNX_LOGE("Failed to read binary lexicon '%{public}s'",
+                     filename.c_str());
+#else
+    SHERPA_ONNX_LOGE("Failed to read binary lexicon '%s'", filename.c_str());
+#endif
+    SHERPA_ONNX_EXIT(-1);
+  }
+
+  Init();
+}
+
+BinaryLexicon::BinaryLexicon(std::unique_ptr<MappedFile> file)
+    : file_(std::move(file)) {
+  Init();
+}
+
+bool BinaryLexicon::IsBinaryLexicon(const char *data, size_t size) {
+  return size >= sizeof(kMagic) &&
+         std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool BinaryLexicon::IsBinaryLexicon(const std::string &filename) {
+  auto is = OpenInputFile(filename, std::ios::binary);
+  char buf[sizeof(kMagic)];
+  if (!is.read(buf, sizeof(buf))) {
+    return false;
+  }
+
+  return IsBinaryLexicon(buf, sizeof(buf));
+}
+
+void BinaryLexicon::Init() {
+  const char *data = file_->Data();
+  size_t size = file_->Size();
+
+  if (!IsBinaryLexicon(data, size) || size < sizeof(BinaryLexiconHeader)) {
+    SHERPA_ONNX_LOGE("Not a binary lexicon");
+    SHERPA_ONNX_EXIT(-1);
+  }
+
+  BinaryLexiconHeader header;
+  std::memcpy(&header, data, sizeof(header));
+
+  // Integers are read in place, so they must be in the native byte order
+  if (header.byte_order != kByteOrderMark) {
+    if (header.byte_order == kSwappedByteOrderMark) {
+      SHERPA_ONNX_LOGE(
+          "The binary lexicon was created on a machine with a different "
+          "byte order. Please re-create it with sherpa-onnx-compile-lexicon "
+          "on this machine");
+    } else {
+      // e.g., files of version 1, which have 0 here
+      SHERPA_ONNX_LOGE(
+          "Unsupported binary lexicon. Please re-create it with "
+          "sherpa-onnx-compile-lexicon");
+    }
+    SHERPA_ONNX_EXIT(-1);
+  }
+
+  if (header.version != kVersion) {
+    SHERPA_ONNX_LOGE("Unsupported binary lexicon version %d. Expected: %d",
+                     static_cast<int32_t>(header.version),
+                     static_cast<int32_t>(kVersion));
+    SHERPA_ONNX_EXIT(-1);
+  }
+
+  size_t expected_size = sizeof(header) +
+                         2 * (header.num_words + 1ull) * sizeof(uint32_t) +
+                         header.num_ids * sizeof(int32_t) + header.words_size;
+  if (size != expected_size) {
+    SHERPA_ONNX_LOGE(
+        "Corrupted binary lexicon. File size: %d, expected size: %d",
+        static_cast<int32_t>(size), static_cast<int32_t>(expected_size));
+    SHERPA_ONNX_EXIT(-1);
+  }
+
+  num_tokens_ = header.num_tokens;
+  num_words_ = header.num_words;
+
+  const char *p = data + sizeof(header);
+  word_offsets_ = reinterpret_cast<const uint32_t *>(p);
+  p += (num_words_ + 1) * sizeof(uint32_t);
+
+  id_offsets_ = reinterpret_cast<const uint32_t *>(p);
+  p += (num_words_ + 1) * sizeof(uint32_t);
+
+  ids_ = reinterpret_cast<const int32_t *>(p);
+  p += header.num_ids * sizeof(int32_t);
+
+  words_ = p;
+
+  if (word_offsets_[num_words_] != header.words_size ||
+      id_offsets_[num_words_] != header.num_ids) {
+    SHERPA_ONNX_LOGE("Corrupted binary lexicon");
+    SHERPA_ONNX_EXIT(-1);
+  }
+}
+
+int32_t BinaryLexicon::FindWord(const std::string &word) const {
+  std::string_view key(word);
+
+  int32_t lo = 0;
+  int32_t hi = num_words_;
+  while (lo < hi) {
+    int32_t mid = lo + (hi - lo) / 2;
+    std::string_view w(words_ + word_offsets_[mid],
+                       word_offsets_[mid + 1] - word_offsets_[mid]);
+    int32_t c = w.compare(key);
+    if (c == 0) {
+      return mid;
+    } else if (c < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return -1;
+}
+
+const int32_t *BinaryLexicon::Find(const std::string &word,
+                                   int32_t *num_ids) const {
+  int32_t i = FindWord(word);
+  if (i < 0) {
+    *num_ids = 0;
+    return nullptr;
+  }
+
+  *num_ids = id_offsets_[i + 1] - id_offsets_[i];
+  return ids_ + id_offsets_[i];
+}
+
+bool BinaryLexicon::Lookup(const std::string &word,
+                           std::vector<int32_t> *ids) const {
+  int32_t n = 0;
+  const int32_t *p = Find(word, &n);
+  if (!p) {
+    return false;
+  }
+
+  ids->insert(ids->end(), p, p + n);
+  return true;
+}
+
+bool BinaryLexicon::Write(
+    const std::unordered_map<std::string, std::vector<int32_t>> &word2ids,
+    int32_t num_tokens, std::ostream &os) {
+  std::vector<const std::string *> words;
+  words.reserve(word2ids.size());
+  for (const auto &p : word2ids) {
+    words.push_back(&p.first);
+  }
+
+  std::sort(words.begin(), words.end(),
+            [](const std::string *a, const std::string *b) { return *a < *b; });
+
+  std::vector<uint32_t> word_offsets;
+  std::vector<uint32_t> id_offsets;
+  std::vector<int32_t> ids;
+  std::string all_words;
+
+  word_offsets.reserve(words.size() + 1);
+  id_offsets.reserve(words.size() + 1);
+
+  for (const auto *w : words) {
+    word_offsets.push_back(all_words.size());
+    id_offsets.push_back(ids.size());
+
+    const auto &v = word2ids.at(*w);
+    all_words.append(*w);
+    ids.insert(ids.end(), v.begin(), v.end());
+  }
+  word_offsets.push_back(all_words.size());
+  id_offsets.push_back(ids.size());
+
+  BinaryLexiconHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.num_tokens = num_tokens;
+  header.num_words = words.size();
+  header.num_ids = ids.size();
+  header.words_size = all_words.size();
+  header.byte_order = kByteOrderMark;
+
+  os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  WriteVector(word_offsets, os);
+  WriteVector(id_offsets, os);
+  WriteVector(ids, os);
+  os.write(all_words.data(), all_words.size());
+
+  return static_cast<bool>(os);
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,113 @@
+// sherpa-onnx/csrc/binary-lexicon.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#ifndef SHERPA_ONNX_CSRC_BINARY_LEXICON_H_
+#define SHERPA_ONNX_CSRC_BINARY_LEXICON_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sherpa-onnx/csrc/file-utils.h"
+
+namespace sherpa_onnx {
+
+/** A compiled lexicon that can be used in place of lexicon.txt.
+ *
+ * Parsing a large lexicon.txt into a hash map at startup is slow and
+ * memory hungry. A binary lexicon stores the words sorted so that a word
+ * can be found with a binary search directly on the memory-mapped file,
+ * without parsing anything at load time.
+ *
+ * Layout (all integers are 4-byte aligned and in the native byte order of
+ * the machine that wrote the file, so that they can be used in place):
+ *
+ *   char     magic[8]            "SOLEXBIN"
+ *   uint32_t version
+ *   uint32_t num_tokens          number of entries in tokens.txt
+ *   uint32_t num_words
+ *   uint32_t num_ids
+ *   uint32_t words_size          number of bytes of all words
+ *   uint32_t byte_order          0x01020304, to reject files written on
+ *                                a machine with a different byte order
+ *   uint32_t word_offsets[num_words + 1]
+ *   uint32_t id_offsets[num_words + 1]
+ *   int32_t  ids[num_ids]
+ *   char     words[words_size]   sorted words, not null terminated
+ *
+ * Use ./sherpa-onnx-compile-lexicon.cc to convert a lexicon.txt.
+ */
+class BinaryLexicon {
+ public:
+  // Exit the program if the file is not a valid binary lexicon
+  explicit BinaryLexicon(const std::string &filename);
+
+  // Exit the program if the content is not a valid binary lexicon
+  explicit BinaryLexicon(std::unique_ptr<MappedFile> file);
+
+  // Return true if data starts with the magic of a binary lexicon
+  static bool IsBinaryLexicon(const char *data, size_t size);
+
+  static bool IsBinaryLexicon(const std::string &filename);
+
+  /** Write a binary lexicon.
+   *
+   * @param word2ids Map a word to its token IDs. Words should have been
+   *                 converted to lowercase.
+   * @param num_tokens Number of entries in tokens.txt. It is checked when
+   *                   the binary lexicon is loaded.
+   * @param os The output stream. Must be opened in binary mode.
+   *
+   * @return Return true on success.
+   */
+  static bool Write(
+      const std::unordered_map<std::string, std::vector<int32_t>> &word2ids,
+      int32_t num_tokens, std::ostream &os);
+
+  int32_t NumWords() const { return num_words_; }
+  int32_t NumTokens() const { return num_tokens_; }
+
+  bool Contains(const std::string &word) const { return FindWord(word) >= 0; }
+
+  /** Return a pointer to the token IDs of a word.
+   *
+   * @param word The word to look up.
+   * @param num_ids On return, it contains the number of token IDs.
+   *
+   * @return Return nullptr if the word does not exist. The returned pointer
+   *         points into the mapped file and is valid as long as this
+   *         object is alive.
+   */
+  const int32_t *Find(const std::string &word, int32_t *num_ids) const;
+
+  // Return false if the word does not exist. ids is not cleared and the
+  // token IDs are appended to it.
+  bool Lookup(const std::string &word, std::vector<int32_t> *ids) const;
+
+ private:
+  void Init();
+
+  // Return -1 if the word does not exist
+  int32_t FindWord(const std::string &word) const;
+
+ private:
+  std::unique_ptr<MappedFile> file_;
+
+  int32_t num_tokens_ = 0;
+  int32_t num_words_ = 0;
+
+  // They point into file_
+  const uint32_t *word_offsets_ = nullptr;
+  const uint32_t *id_offsets_ = nullptr;
+  const int32_t *ids_ = nullptr;
+  const char *words_ = nullptr;
+};
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_BINARY_LEXICON_H_
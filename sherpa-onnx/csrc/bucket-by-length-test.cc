@@ -0,0 +1,41 @@
+// sherpa-onnx/csrc/bucket-by-length-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/bucket-by-length.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace sherpa_onnx {
+
+TEST(BucketByLength, MaxBatchSize) {
+  std::vector<int32_t> lengths = {5, 3, 4, 3, 5};
+  auto batches = BucketByLength(lengths, 2, 10);
+
+  std::vector<std::vector<int32_t>> expected = {{1, 3}, {2, 0}, {4}};
+  EXPECT_EQ(batches, expected);
+}
+
+TEST(BucketByLength, MaxRatio) {
+  std::vector<int32_t> lengths = {100, 10, 14, 16, 200, 150};
+  auto batches = BucketByLength(lengths, 10, 1.5);
+
+  std::vector<std::vector<int32_t>> expected = {{1, 2}, {3}, {0, 5}, {4}};
+  EXPECT_EQ(batches, expected);
+}
+
+TEST(BucketByLength, EqualLengths) {
+  std::vector<int32_t> lengths = {7, 8, 7, 8};
+  auto batches = BucketByLength(lengths, 10, 1);
+
+  std::vector<std::vector<int32_t>> expected = {{0, 2}, {1, 3}};
+  EXPECT_EQ(batches, expected);
+}
+
+TEST(BucketByLength, Empty) {
+  EXPECT_TRUE(BucketByLength({}, 4, 2).empty());
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,46 @@
+// sherpa-onnx/csrc/bucket-by-length.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/bucket-by-length.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace sherpa_onnx {
+
+std::vector<std::vector<int32_t>> BucketByLength(
+    const std::vector<int32_t> &lengths, int32_t max_batch_size,
+    float max_ratio) {
+  int32_t n = static_cast<int32_t>(lengths.size());
+
+  std::vector<int32_t> indexes(n);
+  std::iota(indexes.begin(), indexes.end(), 0);
+
+  std::stable_sort(indexes.begin(), indexes.end(),
+                   [&lengths](int32_t a, int32_t b) {
+                     return lengths[a] < lengths[b];
+                   });
+
+  max_batch_size = std::max(max_batch_size, 1);
+
+  std::vector<std::vector<int32_t>> ans;
+  for (int32_t i : indexes) {
+    if (!ans.empty()) {
+      auto &last = ans.back();
+      int32_t shortest = lengths[last.front()];
+      if (static_cast<int32_t>(last.size()) < max_batch_size &&
+          lengths[i] <= max_ratio * shortest) {
+        last.push_back(i);
+        continue;
+      }
+    }
+
+    ans.push_back({i});
+  }
+
+  return ans;
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,29 @@
+// sherpa-onnx/csrc/bucket-by-length.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#ifndef SHERPA_ONNX_CSRC_BUCKET_BY_LENGTH_H_
+#define SHERPA_ONNX_CSRC_BUCKET_BY_LENGTH_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace sherpa_onnx {
+
+/** Split items into batches of similar lengths to reduce padding.
+ *
+ * @param lengths  lengths[i] is the length of the i-th item
+ * @param max_batch_size  Maximum number of items in a batch
+ * @param max_ratio  In each batch, the longest item is at most max_ratio
+ *                   times as long as the shortest one. Use 1 to put only
+ *                   items of equal lengths into a batch.
+ *
+ * @return Return a list of batches. Each batch contains indexes into
+ *         `lengths` sorted by length. Every index appears exactly once.
+ */
+std::vector<std::vector<int32_t>> BucketByLength(
+    const std::vector<int32_t> &lengths, int32_t max_batch_size,
+    float max_ratio);
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_BUCKET_BY_LENGTH_H_
@@ -130,27 +130,35 @@ void CircularBuffer::Push(const float *p, int32_t n) {
   std::copy(p + part1_size, p + n, buffer_.begin());
 }
 
-std::vector<float> CircularBuffer::Get(int32_t start_index, int32_t n) const {
+bool CircularBuffer::IsValidRange(int32_t start_index, int32_t n) const {
   if (start_index < head_ || start_index >= tail_) {
     SHERPA_ONNX_LOGE("Invalid start_index: %d. head_: %d, tail_: %d",
                      start_index, head_, tail_);
-    return {};
+    return false;
   }
 
   int32_t size = Size();
   if (n < 0 || n > size) {
     SHERPA_ONNX_LOGE("Invalid n: %d. size: %d", n, size);
-    return {};
+    return false;
   }
 
-  int32_t capacity = static_cast<int32_t>(buffer_.size());
-
   if (start_index - head_ + n > size) {
     SHERPA_ONNX_LOGE("Invalid start_index: %d and n: %d. head_: %d, size: %d",
                      start_index, n, head_, size);
+    return false;
+  }
+
+  return true;
+}
+
+std::vector<float> CircularBuffer::Get(int32_t start_index, int32_t n) const {
+  if (!IsValidRange(start_index, n)) {
     return {};
   }
 
+  int32_t capacity = static_cast<int32_t>(buffer_.size());
+
   int32_t start = start_index % capacity;
 
   if (start + n < capacity) {
@@ -158,15 +166,35 @@ std::vector<float> CircularBuffer::Get(int32_t start_index, int32_t n) const {
   }
 
   std::vector<float> ans(n);
+  CopyTo(start, n, ans.data());
+
+  return ans;
+}
+
+bool CircularBuffer::Get(int32_t start_index, int32_t n, float *out) const {
+  if (!IsValidRange(start_index, n)) {
+    return false;
+  }
 
-  std::copy(buffer_.begin() + start, buffer_.end(), ans.begin());
+  int32_t capacity = static_cast<int32_t>(buffer_.size());
+  CopyTo(start_index % capacity, n, out);
+
+  return true;
+}
+
+void CircularBuffer::CopyTo(int32_t start, int32_t n, float *out) const {
+  int32_t capacity = static_cast<int32_t>(buffer_.size());
+
+  if (start + n <= capacity) {
+    std::copy(buffer_.begin() + start, buffer_.begin() + start + n, out);
+    return;
+  }
 
   int32_t part1_size = capacity - start;
   int32_t part2_size = n - part1_size;
-  std::copy(buffer_.begin(), buffer_.begin() + part2_size,
-            ans.begin() + part1_size);
 
-  return ans;
+  std::copy(buffer_.begin() + start, buffer_.end(), out);
+  std::copy(buffer_.begin(), buffer_.begin() + part2_size, out + part1_size);
 }
 
 void CircularBuffer::Pop(int32_t n) {
@@ -28,6 +28,12 @@ class CircularBuffer {
   // @return Return a vector of size n containing the requested elements
   std::vector<float> Get(int32_t start_index, int32_t n) const;
 
+  // Same as the above one except that it copies the requested elements
+  // to the given buffer, which must have room for n elements.
+  //
+  // @return Return false if the arguments are invalid
+  bool Get(int32_t start_index, int32_t n, float *out) const;
+
   // Remove n elements from the buffer
   //
   // @param n Should be in the range [0, size_]
@@ -49,6 +55,12 @@ class CircularBuffer {
 
   void Resize(int32_t new_capacity);
 
+ private:
+  bool IsValidRange(int32_t start_index, int32_t n) const;
+
+  // @param start Index into buffer_
+  void CopyTo(int32_t start, int32_t n, float *out) const;
+
  private:
   std::vector<float> buffer_;
 
@@ -7,14 +7,20 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <limits.h>
 #include <stdlib.h>
+#include <unistd.h>
+#if !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#endif
 #endif
 
 #include "sherpa-onnx/csrc/macros.h"
@@ -186,4 +192,99 @@ std::string ResolveAbsolutePath(const std::string &path) {
   }
 }
 
+MappedFile::MappedFile(std::vector<char> buffer) : buffer_(std::move(buffer)) {
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string &filename) {
+  HANDLE file = CreateFileW(ToWideString(filename).c_str(), GENERIC_READ,
+                            FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    SHERPA_ONNX_LOGE("Failed to open '%s'", filename.c_str());
+    return;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+
+  if (!mapping) {
+    buffer_ = ReadFile(filename);
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return;
+  }
+
+  void *p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!p) {
+    CloseHandle(mapping);
+    buffer_ = ReadFile(filename);
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return;
+  }
+
+  mapping_ = mapping;
+  data_ = reinterpret_cast<const char *>(p);
+  size_ = static_cast<size_t>(size.QuadPart);
+  mapped_ = true;
+}
+
+MappedFile::~MappedFile() {
+  if (mapped_) {
+    UnmapViewOfFile(data_);
+    CloseHandle(reinterpret_cast<HANDLE>(mapping_));
+  }
+}
+#else
+MappedFile::MappedFile(const std::string &filename) {
+#if !defined(__EMSCRIPTEN__)
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    SHERPA_ONNX_LOGE("Failed to open '%s'", filename.c_str());
+    return;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    return;
+  }
+
+  void *p = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ,
+                 MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (p != MAP_FAILED) {
+    data_ = reinterpret_cast<const char *>(p);
+    size_ = static_cast<size_t>(file_stat.st_size);
+    mapped_ = true;
+    return;
+  }
+#endif
+
+  // mmap is not available. Fall back to reading the whole file
+  buffer_ = ReadFile(filename);
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {
+#if !defined(__EMSCRIPTEN__)
+  if (mapped_) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+#endif
+}
+#endif
+
 }  // namespace sherpa_onnx
@@ -5,6 +5,7 @@
 #ifndef SHERPA_ONNX_CSRC_FILE_UTILS_H_
 #define SHERPA_ONNX_CSRC_FILE_UTILS_H_
 
+#include <cstddef>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -46,6 +47,42 @@ std::vector<char> ReadFile(NativeResourceManager *mgr,
 
 std::string ResolveAbsolutePath(const std::string &path);
 
+/** A read-only view of the content of a file.
+ *
+ * On platforms that support it, the file is memory mapped so that pages are
+ * loaded on demand and shared between processes mapping the same file.
+ * Otherwise, the file is read into memory.
+ */
+class MappedFile {
+ public:
+  // Size() returns 0 if the file cannot be opened.
+  explicit MappedFile(const std::string &filename);
+
+  // Take the ownership of a buffer, e.g., one read from an asset manager.
+  explicit MappedFile(std::vector<char> buffer);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *Data() const { return data_; }
+  size_t Size() const { return size_; }
+
+  // True if the content is memory mapped instead of copied into memory
+  bool IsMapped() const { return mapped_; }
+
+ private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<char> buffer_;
+
+#ifdef _WIN32
+  void *mapping_ = nullptr;  // HANDLE
+#endif
+};
+
 std::ifstream OpenInputFile(const std::string &filename,
                             std::ios_base::openmode mode = std::ios_base::in);
 
@@ -0,0 +1,99 @@
+// sherpa-onnx/csrc/global-thread-pool-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/global-thread-pool.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "onnxruntime_cxx_api.h"  // NOLINT
+#include "sherpa-onnx/csrc/session.h"
+
+namespace sherpa_onnx {
+
+// A serialized ONNX model with a single Identity node, y = x, where x and
+// y are float tensors of shape (1,)
+static const uint8_t kIdentityModel[] = {
+    0x08, 0x07, 0x3a, 0x37, 0x0a, 0x10, 0x0a, 0x01, 0x78, 0x12, 0x01,
+    0x79, 0x22, 0x08, 0x49, 0x64, 0x65, 0x6e, 0x74, 0x69, 0x74, 0x79,
+    0x12, 0x01, 0x67, 0x5a, 0x0f, 0x0a, 0x01, 0x78, 0x12, 0x0a, 0x0a,
+    0x08, 0x08, 0x01, 0x12, 0x04, 0x0a, 0x02, 0x08, 0x01, 0x62, 0x0f,
+    0x0a, 0x01, 0x79, 0x12, 0x0a, 0x0a, 0x08, 0x08, 0x01, 0x12, 0x04,
+    0x0a, 0x02, 0x08, 0x01, 0x42, 0x02, 0x10, 0x0d,
+};
+
+static float RunIdentityModel(const Ort::Env &env,
+                              const Ort::SessionOptions &sess_opts, float x) {
+  Ort::Session sess(env, kIdentityModel, sizeof(kIdentityModel), sess_opts);
+
+  auto memory_info =
+      Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+
+  std::array<int64_t, 1> shape = {1};
+  Ort::Value input = Ort::Value::CreateTensor(memory_info, &x, 1,
+                                              shape.data(), shape.size());
+
+  const char *input_names[] = {"x"};
+  const char *output_names[] = {"y"};
+  auto out = sess.Run({}, input_names, &input, 1, output_names, 1);
+
+  return out[0].GetTensorData<float>()[0];
+}
+
+#if GTEST_HAS_DEATH_TEST
+// It runs in a child process, so the global state of the other tests is
+// not affected
+TEST(GlobalThreadPool, InitAfterModel) {
+  EXPECT_EXIT(
+      {
+        // This is what every model does in its constructor
+        Ort::Env env(ORT_LOGGING_LEVEL_ERROR);
+        Ort::SessionOptions sess_opts = GetSessionOptionsImpl(1, "cpu");
+
+        bool ok = InitGlobalThreadPools(GlobalThreadPoolConfig{});
+        std::exit(!ok && !HasGlobalThreadPools() ? 0 : 1);
+      },
+      testing::ExitedWithCode(0), "");
+}
+#endif
+
+TEST(GlobalThreadPool, OptIn) {
+  EXPECT_FALSE(InitGlobalThreadPools(GlobalThreadPoolConfig(-1, 1, true)));
+  EXPECT_FALSE(HasGlobalThreadPools());
+
+  GlobalThreadPoolConfig config(2, 1, false);
+  ASSERT_TRUE(InitGlobalThreadPools(config));
+  EXPECT_TRUE(HasGlobalThreadPools());
+
+  // It can be called only once
+  EXPECT_FALSE(InitGlobalThreadPools(config));
+  EXPECT_TRUE(HasGlobalThreadPools());
+
+  std::string filename = "./global-thread-pool-test.txt";
+  {
+    std::ofstream os(filename);
+    os << "UseGlobalThreadPools=1\n";
+  }
+
+  // It refers to the environment with the global thread pools
+  Ort::Env env(ORT_LOGGING_LEVEL_ERROR);
+
+  // Creating the session fails if the environment has no global
+  // thread pools
+  Ort::SessionOptions sess_opts = GetSessionOptionsImpl(1, "cpu:" + filename);
+  EXPECT_EQ(RunIdentityModel(env, sess_opts, 2.5f), 2.5f);
+
+  // Sessions that do not opt in still work
+  sess_opts = GetSessionOptionsImpl(1, "cpu");
+  EXPECT_EQ(RunIdentityModel(env, sess_opts, -1.5f), -1.5f);
+
+  std::remove(filename.c_str());
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,92 @@
+// sherpa-onnx/csrc/global-thread-pool.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/global-thread-pool.h"
+
+#include <mutex>  // NOLINT
+#include <sstream>
+#include <string>
+
+#include "onnxruntime_cxx_api.h"  // NOLINT
+#include "sherpa-onnx/csrc/macros.h"
+
+namespace sherpa_onnx {
+
+bool GlobalThreadPoolConfig::Validate() const {
+  if (intra_op_num_threads < 0) {
+    SHERPA_ONNX_LOGE("intra_op_num_threads should be >= 0. Given: %d",
+                     intra_op_num_threads);
+    return false;
+  }
+
+  if (inter_op_num_threads < 0) {
+    SHERPA_ONNX_LOGE("inter_op_num_threads should be >= 0. Given: %d",
+                     inter_op_num_threads);
+    return false;
+  }
+
+  return true;
+}
+
+std::string GlobalThreadPoolConfig::ToString() const {
+  std::ostringstream os;
+
+  os << "GlobalThreadPoolConfig(";
+  os << "intra_op_num_threads=" << intra_op_num_threads << ", ";
+  os << "inter_op_num_threads=" << inter_op_num_threads << ", ";
+  os << "allow_spinning=" << (allow_spinning ? "True" : "False") << ")";
+
+  return os.str();
+}
+
+static std::mutex g_mutex;
+
+// Never freed. It keeps the process-wide environment alive so that it is
+// not re-created without the thread pools once all models are gone.
+static Ort::Env *g_env = nullptr;
+
+// True if a model has been created. The environment it created may still
+// be alive, so global thread pools can no longer be set.
+static bool g_env_created = false;
+
+bool InitGlobalThreadPools(const GlobalThreadPoolConfig &config) {
+  if (!config.Validate()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+  if (g_env) {
+    SHERPA_ONNX_LOGE("Global thread pools have already been created");
+    return false;
+  }
+
+  if (g_env_created) {
+    SHERPA_ONNX_LOGE(
+        "Please call InitGlobalThreadPools() before creating any model. "
+        "The onnxruntime environment of an existing model has no global "
+        "thread pools.");
+    return false;
+  }
+
+  Ort::ThreadingOptions options;
+  options.SetGlobalIntraOpNumThreads(config.intra_op_num_threads);
+  options.SetGlobalInterOpNumThreads(config.inter_op_num_threads);
+  options.SetGlobalSpinControl(config.allow_spinning);
+
+  g_env = new Ort::Env(options, ORT_LOGGING_LEVEL_ERROR, "sherpa-onnx");
+
+  return true;
+}
+
+bool HasGlobalThreadPools() {
+  std::lock_guard<std::mutex> lock(g_mutex);
+  return g_env != nullptr;
+}
+
+void MarkOrtEnvCreated() {
+  std::lock_guard<std::mutex> lock(g_mutex);
+  g_env_created = true;
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,69 @@
+// sherpa-onnx/csrc/global-thread-pool.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#ifndef SHERPA_ONNX_CSRC_GLOBAL_THREAD_POOL_H_
+#define SHERPA_ONNX_CSRC_GLOBAL_THREAD_POOL_H_
+
+#include <string>
+
+namespace sherpa_onnx {
+
+struct GlobalThreadPoolConfig {
+  // Number of threads of the intra-op thread pool shared by all sessions
+  // that opt in. 0 means one thread per physical core.
+  int32_t intra_op_num_threads = 0;
+
+  // Number of threads of the shared inter-op thread pool. It is used only
+  // by models running in parallel execution mode.
+  int32_t inter_op_num_threads = 1;
+
+  // If false, idle threads block instead of spinning. It saves CPU
+  // when many models share the pool and run only now and then.
+  bool allow_spinning = true;
+
+  GlobalThreadPoolConfig() = default;
+
+  GlobalThreadPoolConfig(int32_t intra_op_num_threads,
+                         int32_t inter_op_num_threads, bool allow_spinning)
+      : intra_op_num_threads(intra_op_num_threads),
+        inter_op_num_threads(inter_op_num_threads),
+        allow_spinning(allow_spinning) {}
+
+  bool Validate() const;
+
+  std::string ToString() const;
+};
+
+/** Create the process-wide onnxruntime environment with thread pools
+ * shared by all sessions that opt in.
+ *
+ * onnxruntime keeps a single environment per process and every Ort::Env
+ * refers to it. Its thread pools can be set only when it is created, so
+ * this function must be called before any model is created.
+ *
+ * A session opts in with
+ *
+ *     UseGlobalThreadPools=1
+ *
+ * in its provider config file, e.g., --provider=cpu:/path/to/config.txt.
+ * The num_threads of the model is then ignored.
+ *
+ * @return Return false if the config is invalid, if this function has
+ *         already been called, or if a model has already been created.
+ *         In the last case, onnxruntime would return the environment of
+ *         that model, which has no global thread pools.
+ */
+bool InitGlobalThreadPools(const GlobalThreadPoolConfig &config);
+
+// Return true if InitGlobalThreadPools() has been called successfully.
+bool HasGlobalThreadPools();
+
+// Record that the process-wide onnxruntime environment has been created
+// without global thread pools. It is called by GetSessionOptionsImpl(),
+// i.e., whenever a model is created, since every model creates its
+// Ort::Env before its session options.
+void MarkOrtEnvCreated();
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_GLOBAL_THREAD_POOL_H_
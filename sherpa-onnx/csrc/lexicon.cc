@@ -112,7 +112,9 @@ Lexicon::Lexicon(const std::string &lexicon, const std::string &tokens,
     InitTokens(is);
   }
 
-  {
+  if (BinaryLexicon::IsBinaryLexicon(lexicon)) {
+    InitBinaryLexicon(std::make_unique<BinaryLexicon>(lexicon));
+  } else {
     auto is = OpenInputFile(lexicon);
     InitLexicon(is);
   }
@@ -136,8 +138,13 @@ Lexicon::Lexicon(Manager *mgr, const std::string &lexicon,
 
   {
     auto buf = ReadFile(mgr, lexicon);
-    std::istringstream is(std::string(buf.data(), buf.size()));
-    InitLexicon(is);
+    if (BinaryLexicon::IsBinaryLexicon(buf.data(), buf.size())) {
+      InitBinaryLexicon(std::make_unique<BinaryLexicon>(
+          std::make_unique<MappedFile>(std::move(buf))));
+    } else {
+      std::istringstream is(std::string(buf.data(), buf.size()));
+      InitLexicon(is);
+    }
   }
 
   InitPunctuations(punctuations);
@@ -238,14 +245,14 @@ std::vector<TokenIDs> Lexicon::ConvertTextToTokenIdsChinese(
       continue;
     }
 
-    if (!word2ids_.count(w)) {
+    int32_t num_ids = 0;
+    const int32_t *token_ids = FindWord(w, &num_ids);
+    if (!token_ids) {
       SHERPA_ONNX_LOGE("OOV %s. Ignore it!", w.c_str());
       continue;
     }
 
-    const auto &token_ids = word2ids_.at(w);
-    this_sentence.insert(this_sentence.end(), token_ids.begin(),
-                         token_ids.end());
+    this_sentence.insert(this_sentence.end(), token_ids, token_ids + num_ids);
   }
 
   if (sil != -1) {
@@ -315,14 +322,14 @@ std::vector<TokenIDs> Lexicon::ConvertTextToTokenIdsNotChinese(
       continue;
     }
 
-    if (!word2ids_.count(w)) {
+    int32_t num_ids = 0;
+    const int32_t *token_ids = FindWord(w, &num_ids);
+    if (!token_ids) {
       SHERPA_ONNX_LOGE("OOV %s. Ignore it!", w.c_str());
       continue;
     }
 
-    const auto &token_ids = word2ids_.at(w);
-    this_sentence.insert(this_sentence.end(), token_ids.begin(),
-                         token_ids.end());
+    this_sentence.insert(this_sentence.end(), token_ids, token_ids + num_ids);
     this_sentence.push_back(blank);
   }
 
@@ -389,6 +396,34 @@ void Lexicon::InitLexicon(std::istream &is) {
   }
 }
 
+void Lexicon::InitBinaryLexicon(std::unique_ptr<BinaryLexicon> lexicon) {
+  if (lexicon->NumTokens() != static_cast<int32_t>(token2id_.size())) {
+    SHERPA_ONNX_LOGE(
+        "The binary lexicon was compiled with %d tokens, but tokens.txt has "
+        "%d tokens. Please re-generate it.",
+        lexicon->NumTokens(), static_cast<int32_t>(token2id_.size()));
+    SHERPA_ONNX_EXIT(-1);
+  }
+
+  binary_lexicon_ = std::move(lexicon);
+}
+
+const int32_t *Lexicon::FindWord(const std::string &w,
+                                 int32_t *num_ids) const {
+  if (binary_lexicon_) {
+    return binary_lexicon_->Find(w, num_ids);
+  }
+
+  auto it = word2ids_.find(w);
+  if (it == word2ids_.end()) {
+    *num_ids = 0;
+    return nullptr;
+  }
+
+  *num_ids = static_cast<int32_t>(it->second.size());
+  return it->second.data();
+}
+
 void Lexicon::InitPunctuations(const std::string &punctuations) {
   std::vector<std::string> punctuation_list;
   SplitStringToVector(punctuations, " ", false, &punctuation_list);
@@ -13,6 +13,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "sherpa-onnx/csrc/binary-lexicon.h"
 #include "sherpa-onnx/csrc/offline-tts-frontend.h"
 
 namespace sherpa_onnx {
@@ -22,6 +23,9 @@ class Lexicon : public OfflineTtsFrontend {
   Lexicon() = default;  // for subclasses
                         //
   // Note: for models from piper, we won't use this class.
+  //
+  // lexicon can be either a lexicon.txt or a binary lexicon generated
+  // by ./sherpa-onnx-compile-lexicon.cc
   Lexicon(const std::string &lexicon, const std::string &tokens,
           const std::string &punctuations, const std::string &language,
           bool debug = false);
@@ -44,8 +48,12 @@ class Lexicon : public OfflineTtsFrontend {
   void InitLanguage(const std::string &lang);
   void InitTokens(std::istream &is);
   void InitLexicon(std::istream &is);
+  void InitBinaryLexicon(std::unique_ptr<BinaryLexicon> lexicon);
   void InitPunctuations(const std::string &punctuations);
 
+  // Return nullptr if w is not in the lexicon
+  const int32_t *FindWord(const std::string &w, int32_t *num_ids) const;
+
  private:
   enum class Language {
     kNotChinese,
@@ -55,6 +63,8 @@ class Lexicon : public OfflineTtsFrontend {
 
  private:
   std::unordered_map<std::string, std::vector<int32_t>> word2ids_;
+  // Used in place of word2ids_ if a binary lexicon is given
+  std::unique_ptr<BinaryLexicon> binary_lexicon_;
   std::unordered_set<std::string> punctuations_;
   std::unordered_map<std::string, int32_t> token2id_;
   Language language_ = Language::kUnknown;
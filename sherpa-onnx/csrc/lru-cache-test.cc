@@ -0,0 +1,81 @@
+// sherpa-onnx/csrc/lru-cache-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/lru-cache.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace sherpa_onnx {
+
+TEST(LruCache, GetAndPut) {
+  LruCache<std::string, int32_t> cache(2);
+
+  int32_t v = 0;
+  EXPECT_FALSE(cache.Get("a", &v));
+
+  cache.Put("a", 1);
+  EXPECT_TRUE(cache.Get("a", &v));
+  EXPECT_EQ(v, 1);
+
+  cache.Put("a", 2);
+  EXPECT_TRUE(cache.Get("a", &v));
+  EXPECT_EQ(v, 2);
+  EXPECT_EQ(cache.Size(), 1u);
+}
+
+TEST(LruCache, Evict) {
+  LruCache<std::string, int32_t> cache(2);
+  cache.Put("a", 1);
+  cache.Put("b", 2);
+
+  int32_t v = 0;
+  // "a" becomes the most recently used one, so "b" is evicted
+  EXPECT_TRUE(cache.Get("a", &v));
+  cache.Put("c", 3);
+
+  EXPECT_EQ(cache.Size(), 2u);
+  EXPECT_TRUE(cache.Get("a", &v));
+  EXPECT_FALSE(cache.Get("b", &v));
+  EXPECT_TRUE(cache.Get("c", &v));
+  EXPECT_EQ(v, 3);
+}
+
+TEST(LruCache, ZeroCapacity) {
+  LruCache<std::string, int32_t> cache(0);
+  cache.Put("a", 1);
+
+  int32_t v = 0;
+  EXPECT_FALSE(cache.Get("a", &v));
+  EXPECT_EQ(cache.Size(), 0u);
+}
+
+TEST(LruCache, SetCapacity) {
+  LruCache<std::string, int32_t> cache(3);
+  cache.Put("a", 1);
+  cache.Put("b", 2);
+  cache.Put("c", 3);
+
+  int32_t v = 0;
+  EXPECT_TRUE(cache.Get("a", &v));
+
+  // "b" and "c" are the least recently used ones
+  cache.SetCapacity(1);
+  EXPECT_EQ(cache.Size(), 1u);
+  EXPECT_TRUE(cache.Get("a", &v));
+  EXPECT_FALSE(cache.Get("b", &v));
+  EXPECT_FALSE(cache.Get("c", &v));
+
+  cache.SetCapacity(2);
+  cache.Put("d", 4);
+  EXPECT_EQ(cache.Size(), 2u);
+
+  cache.SetCapacity(0);
+  EXPECT_EQ(cache.Size(), 0u);
+  cache.Put("e", 5);
+  EXPECT_FALSE(cache.Get("e", &v));
+}
+
+}  // namespace sherpa_onnx
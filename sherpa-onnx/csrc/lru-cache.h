@@ -0,0 +1,97 @@
+// sherpa-onnx/csrc/lru-cache.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#ifndef SHERPA_ONNX_CSRC_LRU_CACHE_H_
+#define SHERPA_ONNX_CSRC_LRU_CACHE_H_
+
+#include <cstddef>
+#include <list>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <utility>
+
+namespace sherpa_onnx {
+
+// A thread-safe cache that evicts the least recently used item when
+// it is full. A capacity of 0 disables caching.
+template <typename Key, typename Value>
+class LruCache {
+ public:
+  explicit LruCache(size_t capacity) : capacity_(capacity) {}
+
+  // Return true and copy the cached value to *value if key is found.
+  bool Get(const Key &key, Value *value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return false;
+    }
+
+    // Move to front (most recently used)
+    if (it->second != lru_list_.begin()) {
+      lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+    }
+
+    *value = it->second->second;
+    return true;
+  }
+
+  void Put(const Key &key, Value value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (capacity_ == 0) {
+      return;
+    }
+
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+      it->second->second = std::move(value);
+      if (it->second != lru_list_.begin()) {
+        lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+      }
+      return;
+    }
+
+    if (lru_list_.size() >= capacity_) {
+      map_.erase(lru_list_.back().first);
+      lru_list_.pop_back();
+    }
+
+    lru_list_.emplace_front(key, std::move(value));
+    map_[key] = lru_list_.begin();
+  }
+
+  // Evict the least recently used items if there are more than capacity.
+  void SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+
+    while (lru_list_.size() > capacity_) {
+      map_.erase(lru_list_.back().first);
+      lru_list_.pop_back();
+    }
+  }
+
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_list_.size();
+  }
+
+ private:
+  using ListNode = std::pair<Key, Value>;
+  using ListIt = typename std::list<ListNode>::iterator;
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+
+  // Front = most recently used
+  std::list<ListNode> lru_list_;
+
+  // Key -> iterator into lru_list_
+  std::unordered_map<Key, ListIt> map_;
+};
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_LRU_CACHE_H_
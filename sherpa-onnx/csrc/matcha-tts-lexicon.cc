@@ -29,6 +29,7 @@
 #include "espeak-ng/speak_lib.h"
 #include "phoneme_ids.hpp"  // NOLINT
 #include "phonemize.hpp"    // NOLINT
+#include "sherpa-onnx/csrc/binary-lexicon.h"
 #include "sherpa-onnx/csrc/file-utils.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/onnx-utils.h"
@@ -161,6 +162,12 @@ class MatchaTtsLexicon::Impl {
     for (const auto &f : files) {
       auto buf = ReadFile(mgr, f);
 
+      if (BinaryLexicon::IsBinaryLexicon(buf.data(), buf.size())) {
+        InitBinaryLexicon(std::make_unique<BinaryLexicon>(
+            std::make_unique<MappedFile>(std::move(buf))));
+        continue;
+      }
+
       std::istringstream is(std::string(buf.data(), buf.size()));
       InitLexicon(is);
     }
@@ -260,7 +267,8 @@ class MatchaTtsLexicon::Impl {
     std::vector<TokenIDs> ans;
     std::vector<int64_t> this_sentence;
 
-    PhraseMatcher matcher(&all_words_, words, debug_);
+    PhraseMatcher matcher(
+        [this](const std::string &w) { return HasWord(w); }, words, debug_);
 
     int32_t blank = token2id_.at(" ");
 
@@ -316,15 +324,15 @@ class MatchaTtsLexicon::Impl {
  private:
   std::vector<int32_t> ConvertWordToIds(const std::string &w) const {
     std::vector<int32_t> ans;
-    if (word2ids_.count(w)) {
-      ans = word2ids_.at(w);
+    if (LookupWord(w, &ans)) {
+      // found in the lexicon
     } else if (token2id_.count(w)) {
       ans = {token2id_.at(w)};
     } else {
       if (ContainsCJK(w)) {
         std::vector<std::string> words = SplitUtf8(w);
         for (const auto &word : words) {
-          if (word2ids_.count(word)) {
+          if (HasWord(word)) {
             auto ids = ConvertWordToIds(word);
             ans.insert(ans.end(), ids.begin(), ids.end());
           }
@@ -386,11 +394,62 @@ class MatchaTtsLexicon::Impl {
     std::vector<std::string> files;
     SplitStringToVector(lexicon, ",", false, &files);
     for (const auto &f : files) {
+      if (BinaryLexicon::IsBinaryLexicon(f)) {
+        InitBinaryLexicon(std::make_unique<BinaryLexicon>(f));
+        continue;
+      }
+
       auto is = OpenInputFile(f);
       InitLexicon(is);
     }
   }
 
+  void InitBinaryLexicon(std::unique_ptr<BinaryLexicon> lexicon) {
+    if (lexicon->NumTokens() != static_cast<int32_t>(token2id_.size())) {
+      SHERPA_ONNX_LOGE(
+          "The binary lexicon was compiled with %d tokens, but tokens.txt has "
+          "%d tokens. Please re-generate it.",
+          lexicon->NumTokens(), static_cast<int32_t>(token2id_.size()));
+      SHERPA_ONNX_EXIT(-1);
+    }
+
+    binary_lexicons_.push_back(std::move(lexicon));
+  }
+
+  // Words from lexicon.txt take precedence over those from binary lexicons
+  bool HasWord(const std::string &w) const {
+    if (word2ids_.count(w)) {
+      return true;
+    }
+
+    for (const auto &b : binary_lexicons_) {
+      if (b->Contains(w)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Return false if w is not in the lexicon
+  bool LookupWord(const std::string &w, std::vector<int32_t> *ids) const {
+    ids->clear();
+
+    auto it = word2ids_.find(w);
+    if (it != word2ids_.end()) {
+      *ids = it->second;
+      return true;
+    }
+
+    for (const auto &b : binary_lexicons_) {
+      if (b->Lookup(w, ids)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
   void InitLexicon(std::istream &is) {
     std::string word;
     std::vector<std::string> token_list;
@@ -439,16 +498,14 @@ class MatchaTtsLexicon::Impl {
 
       word2ids_.insert({std::move(word), std::move(ids)});
     }
-
-    for (const auto &[key, _] : word2ids_) {
-      all_words_.insert(key);
-    }
   }
 
  private:
   // lexicon.txt is saved in word2ids_
   std::unordered_map<std::string, std::vector<int32_t>> word2ids_;
-  std::unordered_set<std::string> all_words_;
+
+  // Pre-compiled lexicons, see ./binary-lexicon.h
+  std::vector<std::unique_ptr<BinaryLexicon>> binary_lexicons_;
 
   // tokens.txt is saved in token2id_
   std::unordered_map<std::string, int32_t> token2id_;
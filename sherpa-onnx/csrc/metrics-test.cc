@@ -0,0 +1,105 @@
+// sherpa-onnx/csrc/metrics-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/metrics.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace sherpa_onnx {
+
+TEST(Metrics, CounterAndGauge) {
+  MetricsRegistry registry;
+  Counter *c = registry.AddCounter("decoded_total", "Decoded utterances");
+  Gauge *g = registry.AddGauge("queued", "Queued streams");
+
+  c->Inc();
+  c->Inc(2);
+  g->Inc(3);
+  g->Dec();
+
+  EXPECT_EQ(c->Value(), 3);
+  EXPECT_EQ(g->Value(), 2);
+
+  std::string expected =
+      "# HELP decoded_total Decoded utterances\n"
+      "# TYPE decoded_total counter\n"
+      "decoded_total 3\n"
+      "# HELP queued Queued streams\n"
+      "# TYPE queued gauge\n"
+      "queued 2\n";
+  EXPECT_EQ(registry.ToString(), expected);
+}
+
+TEST(Metrics, GaugeFunc) {
+  MetricsRegistry registry;
+  int32_t n = 5;
+  registry.AddGauge("connections", "Connections", [&n]() { return n; });
+
+  n = 7;
+  std::string expected =
+      "# HELP connections Connections\n"
+      "# TYPE connections gauge\n"
+      "connections 7\n";
+  EXPECT_EQ(registry.ToString(), expected);
+}
+
+TEST(Metrics, Histogram) {
+  MetricsRegistry registry;
+  Histogram *h = registry.AddHistogram("batch_size", "Batch size", {1, 2, 4});
+
+  h->Observe(1);
+  h->Observe(3);
+  h->Observe(4);
+  h->Observe(10);
+
+  std::vector<int64_t> counts;
+  double sum = 0;
+  h->Get(&counts, &sum);
+
+  EXPECT_EQ(counts, (std::vector<int64_t>{1, 1, 3, 4}));
+  EXPECT_EQ(sum, 18);
+
+  std::string expected =
+      "# HELP batch_size Batch size\n"
+      "# TYPE batch_size histogram\n"
+      "batch_size_bucket{le=\"1\"} 1\n"
+      "batch_size_bucket{le=\"2\"} 1\n"
+      "batch_size_bucket{le=\"4\"} 3\n"
+      "batch_size_bucket{le=\"+Inf\"} 4\n"
+      "batch_size_sum 18\n"
+      "batch_size_count 4\n";
+  EXPECT_EQ(registry.ToString(), expected);
+}
+
+TEST(Metrics, NonIntegerValues) {
+  MetricsRegistry registry;
+  Histogram *h = registry.AddHistogram("latency_seconds", "Latency",
+                                       {0.005, 0.1, 0.25, 2.5});
+  Gauge *g = registry.AddGauge("rtf", "Real time factor");
+
+  h->Observe(0.1);
+  h->Observe(0.2);
+  g->Set(1.0 / 3);
+
+  std::string expected =
+      "# HELP latency_seconds Latency\n"
+      "# TYPE latency_seconds histogram\n"
+      "latency_seconds_bucket{le=\"0.005\"} 0\n"
+      "latency_seconds_bucket{le=\"0.1\"} 1\n"
+      "latency_seconds_bucket{le=\"0.25\"} 2\n"
+      "latency_seconds_bucket{le=\"2.5\"} 2\n"
+      "latency_seconds_bucket{le=\"+Inf\"} 2\n"
+      // 0.1 + 0.2 is not exactly 0.3
+      "latency_seconds_sum 0.30000000000000004\n"
+      "latency_seconds_count 2\n"
+      "# HELP rtf Real time factor\n"
+      "# TYPE rtf gauge\n"
+      "rtf 0.3333333333333333\n";
+  EXPECT_EQ(registry.ToString(), expected);
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,195 @@
+// sherpa-onnx/csrc/metrics.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace sherpa_onnx {
+
+static void AtomicAdd(std::atomic<double> *a, double v) {
+  double old = a->load();
+  while (!a->compare_exchange_weak(old, old + v)) {
+  }
+}
+
+static void FormatValue(double v, std::ostream *os) {
+  if (std::isinf(v)) {
+    *os << (v > 0 ? "+Inf" : "-Inf");
+  } else if (std::isnan(v)) {
+    *os << "NaN";
+  } else {
+    // Use the shortest form that reads back as v, e.g., 0.1 instead of
+    // 0.10000000000000001, so that bucket labels are the configured values
+    char buf[32];
+    for (int32_t precision = 15; precision <= 17; ++precision) {
+      snprintf(buf, sizeof(buf), "%.*g", precision, v);
+      if (std::strtod(buf, nullptr) == v) {
+        break;
+      }
+    }
+    *os << buf;
+  }
+}
+
+void Counter::Inc(double v /*= 1*/) { AtomicAdd(&value_, v); }
+
+void Gauge::Inc(double v /*= 1*/) { AtomicAdd(&value_, v); }
+
+Histogram::Histogram(std::vector<double> buckets)
+    : buckets_(std::move(buckets)), counts_(buckets_.size() + 1) {
+  std::sort(buckets_.begin(), buckets_.end());
+}
+
+void Histogram::Observe(double v) {
+  // The last entry of counts_ is for +Inf
+  int32_t i = std::lower_bound(buckets_.begin(), buckets_.end(), v) -
+              buckets_.begin();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  counts_[i] += 1;
+  sum_ += v;
+}
+
+void Histogram::Get(std::vector<int64_t> *counts, double *sum) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  counts->resize(counts_.size());
+
+  int64_t n = 0;
+  for (size_t i = 0; i != counts_.size(); ++i) {
+    n += counts_[i];
+    (*counts)[i] = n;
+  }
+
+  *sum = sum_;
+}
+
+Counter *MetricsRegistry::AddCounter(const std::string &name,
+                                     const std::string &help) {
+  Entry e;
+  e.name = name;
+  e.help = help;
+  e.counter = std::make_unique<Counter>();
+  Counter *ans = e.counter.get();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back(std::move(e));
+
+  return ans;
+}
+
+Gauge *MetricsRegistry::AddGauge(const std::string &name,
+                                 const std::string &help) {
+  Entry e;
+  e.name = name;
+  e.help = help;
+  e.gauge = std::make_unique<Gauge>();
+  Gauge *ans = e.gauge.get();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back(std::move(e));
+
+  return ans;
+}
+
+void MetricsRegistry::AddGauge(const std::string &name,
+                               const std::string &help,
+                               std::function<double()> f) {
+  Entry e;
+  e.name = name;
+  e.help = help;
+  e.gauge_func = std::move(f);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back(std::move(e));
+}
+
+Histogram *MetricsRegistry::AddHistogram(const std::string &name,
+                                         const std::string &help,
+                                         std::vector<double> buckets) {
+  Entry e;
+  e.name = name;
+  e.help = help;
+  e.histogram = std::make_unique<Histogram>(std::move(buckets));
+  Histogram *ans = e.histogram.get();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_back(std::move(e));
+
+  return ans;
+}
+
+std::string MetricsRegistry::ToString() const {
+  std::ostringstream os;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &e : entries_) {
+    os << "# HELP " << e.name << " " << e.help << "\n";
+
+    if (e.counter) {
+      os << "# TYPE " << e.name << " counter\n";
+      os << e.name << " ";
+      FormatValue(e.counter->Value(), &os);
+      os << "\n";
+    } else if (e.gauge || e.gauge_func) {
+      os << "# TYPE " << e.name << " gauge\n";
+      os << e.name << " ";
+      FormatValue(e.gauge ? e.gauge->Value() : e.gauge_func(), &os);
+      os << "\n";
+    } else if (e.histogram) {
+      std::vector<int64_t> counts;
+      double sum = 0;
+      e.histogram->Get(&counts, &sum);
+
+      const auto &buckets = e.histogram->Buckets();
+
+      os << "# TYPE " << e.name << " histogram\n";
+      for (size_t i = 0; i != buckets.size(); ++i) {
+        os << e.name << "_bucket{le=\"";
+        FormatValue(buckets[i], &os);
+        os << "\"} " << counts[i] << "\n";
+      }
+      os << e.name << "_bucket{le=\"+Inf\"} " << counts.back() << "\n";
+
+      os << e.name << "_sum ";
+      FormatValue(sum, &os);
+      os << "\n";
+
+      os << e.name << "_count " << counts.back() << "\n";
+    }
+  }
+
+  return os.str();
+}
+
+int64_t GetResidentMemoryBytes() {
+#if defined(__linux__)
+  // The second field is the number of resident pages
+  std::ifstream is("/proc/self/statm");
+  int64_t size = 0;
+  int64_t resident = 0;
+  if (!(is >> size >> resident)) {
+    return 0;
+  }
+
+  return resident * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,110 @@
+// sherpa-onnx/csrc/metrics.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#ifndef SHERPA_ONNX_CSRC_METRICS_H_
+#define SHERPA_ONNX_CSRC_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+namespace sherpa_onnx {
+
+// A value that only increases, e.g., number of decoded utterances.
+// All methods are thread-safe.
+class Counter {
+ public:
+  void Inc(double v = 1);
+  double Value() const { return value_.load(); }
+
+ private:
+  std::atomic<double> value_{0};
+};
+
+// A value that can go up and down, e.g., number of queued streams.
+// All methods are thread-safe.
+class Gauge {
+ public:
+  void Set(double v) { value_.store(v); }
+  void Inc(double v = 1);
+  void Dec(double v = 1) { Inc(-v); }
+  double Value() const { return value_.load(); }
+
+ private:
+  std::atomic<double> value_{0};
+};
+
+// Count observed values, e.g., latencies, in buckets.
+// All methods are thread-safe.
+class Histogram {
+ public:
+  // @param buckets Upper bounds of the buckets in increasing order.
+  //                A bucket for +Inf is added implicitly.
+  explicit Histogram(std::vector<double> buckets);
+
+  void Observe(double v);
+
+  // counts[i] is the number of observed values <= buckets[i]. The last
+  // entry is the total number of observed values.
+  void Get(std::vector<int64_t> *counts, double *sum) const;
+
+  const std::vector<double> &Buckets() const { return buckets_; }
+
+ private:
+  std::vector<double> buckets_;
+
+  mutable std::mutex mutex_;
+  std::vector<int64_t> counts_;  // not cumulative
+  double sum_ = 0;
+};
+
+// It owns a set of metrics and formats them in the text format of
+// Prometheus, so that they can be scraped from an HTTP endpoint.
+//
+// Metrics are usually added at startup and updated from any thread.
+class MetricsRegistry {
+ public:
+  // The returned pointers are valid as long as this object is alive.
+  //
+  // @param name  Name of the metric, e.g., sherpa_onnx_decoded_total
+  // @param help  Description of the metric
+  Counter *AddCounter(const std::string &name, const std::string &help);
+
+  Gauge *AddGauge(const std::string &name, const std::string &help);
+
+  // The value of the gauge is computed by calling f when metrics are
+  // formatted, e.g., the size of a queue.
+  void AddGauge(const std::string &name, const std::string &help,
+                std::function<double()> f);
+
+  Histogram *AddHistogram(const std::string &name, const std::string &help,
+                          std::vector<double> buckets);
+
+  // Return metrics in the text format of Prometheus
+  std::string ToString() const;
+
+ private:
+  struct Entry {
+    std::string name;
+    std::string help;
+    std::unique_ptr<Counter> counter;
+    std::unique_ptr<Gauge> gauge;
+    std::function<double()> gauge_func;
+    std::unique_ptr<Histogram> histogram;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+};
+
+// Return the resident memory of this process in bytes. Return 0 if it
+// is not supported on the current platform.
+int64_t GetResidentMemoryBytes();
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_METRICS_H_
@@ -33,8 +33,8 @@ class OfflineCtTransformerModel::Impl {
         env_(ORT_LOGGING_LEVEL_ERROR),
         sess_opts_(GetSessionOptions(config)),
         allocator_{} {
-    sess_ = std::make_unique<Ort::Session>(
-        env_, SHERPA_ONNX_TO_ORT_PATH(config_.ct_transformer), sess_opts_);
+    sess_ = CreateSession(env_, config_.ct_transformer, sess_opts_,
+                          &mapped_model_);
     Init(nullptr, 0);
   }
 
@@ -144,6 +144,8 @@ class OfflineCtTransformerModel::Impl {
   Ort::SessionOptions sess_opts_;
   Ort::AllocatorWithDefaultOptions allocator_;
 
+  // Non-null if the model is memory mapped. It must outlive sess_
+  std::unique_ptr<MappedFile> mapped_model_;
   std::unique_ptr<Ort::Session> sess_;
 
   std::vector<std::string> input_names_;
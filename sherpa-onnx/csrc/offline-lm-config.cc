@@ -18,6 +18,9 @@ void OfflineLMConfig::Register(ParseOptions *po) {
                "Number of threads to run the neural network of LM model");
   po->Register("lm-provider", &lm_provider,
                "Specify a provider to LM model use: cpu, cuda, coreml");
+  po->Register("lm-lazy-init", &lm_lazy_init,
+               "true to load the LM on first use instead of at startup. It "
+               "reduces startup time at the cost of a slower first request");
   po->Register("lodr-fst", &lodr_fst, "Path to LODR FST model.");
   po->Register("lodr-scale", &lodr_scale, "LODR scale.");
   po->Register("lodr-backoff-id", &lodr_backoff_id,
@@ -44,6 +47,7 @@ std::string OfflineLMConfig::ToString() const {
   os << "OfflineLMConfig(";
   os << "model=\"" << model << "\", ";
   os << "scale=" << scale << ", ";
+  os << "lm_lazy_init=" << (lm_lazy_init ? "True" : "False") << ", ";
   os << "lodr_scale=" << lodr_scale << ", ";
   os << "lodr_fst=\"" << lodr_fst << "\", ";
   os << "lodr_backoff_id=" << lodr_backoff_id << ")";
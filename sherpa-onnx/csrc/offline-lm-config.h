@@ -19,6 +19,9 @@ struct OfflineLMConfig {
   int32_t lm_num_threads = 1;
   std::string lm_provider = "cpu";
 
+  // If true, the LM is loaded on first use instead of at startup
+  bool lm_lazy_init = false;
+
   // LODR
   std::string lodr_fst;
   float lodr_scale = 0.01;
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -23,7 +24,37 @@
 
 namespace sherpa_onnx {
 
+namespace {
+
+// Load the LM on first use. See OfflineLMConfig::lm_lazy_init
+class LazyOfflineLM : public OfflineLM {
+ public:
+  explicit LazyOfflineLM(const OfflineLMConfig &config)
+      : OfflineLM(config), config_(config) {
+    // LODR is handled by the base class of this object
+    config_.lodr_fst.clear();
+  }
+
+  Ort::Value Rescore(Ort::Value x, Ort::Value x_lens) override {
+    std::call_once(init_flag_,
+                   [this]() { lm_ = std::make_unique<OfflineRnnLM>(config_); });
+
+    return lm_->Rescore(std::move(x), std::move(x_lens));
+  }
+
+ private:
+  OfflineLMConfig config_;
+  std::once_flag init_flag_;
+  std::unique_ptr<OfflineLM> lm_;
+};
+
+}  // namespace
+
 std::unique_ptr<OfflineLM> OfflineLM::Create(const OfflineLMConfig &config) {
+  if (config.lm_lazy_init) {
+    return std::make_unique<LazyOfflineLM>(config);
+  }
+
   return std::make_unique<OfflineRnnLM>(config);
 }
 
@@ -6,6 +6,8 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <utility>
@@ -32,57 +34,82 @@ class OfflinePunctuationCtTransformerImpl : public OfflinePunctuationImpl {
       : config_(config), model_(mgr, config.model) {}
 
   std::string AddPunctuation(const std::string &text) const override {
-    if (text.empty()) {
-      return {};
-    }
-
-    std::vector<std::string> tokens = SplitUtf8(text);
-    std::vector<int32_t> token_ids;
-    token_ids.reserve(tokens.size());
+    return AddPunctuationBatch({text})[0];
+  }
 
-    const auto &meta_data = model_.GetModelMetadata();
+  std::vector<std::string> AddPunctuationBatch(
+      const std::vector<std::string> &texts) const override {
+    int32_t num_texts = static_cast<int32_t>(texts.size());
 
-    for (const auto &t : tokens) {
-      std::string token = ToLowerCase(t);
-      if (meta_data.token2id.count(token)) {
-        token_ids.push_back(meta_data.token2id.at(token));
-      } else {
-        token_ids.push_back(meta_data.unk_id);
-      }
+    std::vector<Document> docs(num_texts);
+    for (int32_t i = 0; i != num_texts; ++i) {
+      Tokenize(texts[i], &docs[i]);
     }
 
+    const auto &meta_data = model_.GetModelMetadata();
+    int32_t num_punctuations = meta_data.num_punctuations;
+
     auto memory_info =
         Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
 
-    int32_t segment_size = 20;
-    int32_t max_len = 200;
-    int32_t num_segments =
-        ceil((static_cast<float>(token_ids.size()) + segment_size - 1) /
-             segment_size);
+    // Segments of a document depend on the result of the previous segment,
+    // so in each step we run the next segment of every unfinished document
+    // in a padded batch.
+    std::vector<int32_t> active;
+    std::vector<int32_t> starts;
+    std::vector<int32_t> lens;
+    std::vector<int32_t> x_vec;
+
+    while (true) {
+      active.clear();
+      starts.clear();
+      lens.clear();
+
+      int32_t max_len = 0;
+      for (int32_t i = 0; i != num_texts; ++i) {
+        Document &d = docs[i];
+        if (d.i >= d.num_segments) {
+          continue;
+        }
 
-    std::vector<int32_t> punctuations;
-    int32_t last = -1;
-    for (int32_t i = 0; i != num_segments; ++i) {
-      int32_t this_start = i * segment_size;         // included
-      int32_t this_end = this_start + segment_size;  // not included
-      if (this_end > static_cast<int32_t>(token_ids.size())) {
-        this_end = token_ids.size();
+        int32_t this_start = d.i * kSegmentSize;         // included
+        int32_t this_end = this_start + kSegmentSize;  // not included
+        if (this_end > static_cast<int32_t>(d.token_ids.size())) {
+          this_end = d.token_ids.size();
+        }
+
+        if (d.last != -1) {
+          this_start = d.last;
+        }
+        // token_ids[this_start:this_end] is sent to the model
+
+        active.push_back(i);
+        starts.push_back(this_start);
+        lens.push_back(this_end - this_start);
+        max_len = std::max(max_len, this_end - this_start);
       }
 
-      if (last != -1) {
-        this_start = last;
+      if (active.empty()) {
+        break;
       }
-      // token_ids[this_start:this_end] is sent to the model
 
-      std::array<int64_t, 2> x_shape = {1, this_end - this_start};
+      int32_t batch_size = static_cast<int32_t>(active.size());
+
+      x_vec.assign(batch_size * max_len, 0);
+      for (int32_t b = 0; b != batch_size; ++b) {
+        const auto &ids = docs[active[b]].token_ids;
+        std::copy(ids.begin() + starts[b], ids.begin() + starts[b] + lens[b],
+                  x_vec.begin() + b * max_len);
+      }
+
+      std::array<int64_t, 2> x_shape = {batch_size, max_len};
       Ort::Value x =
-          Ort::Value::CreateTensor(memory_info, token_ids.data() + this_start,
-                                   x_shape[1], x_shape.data(), x_shape.size());
+          Ort::Value::CreateTensor(memory_info, x_vec.data(), x_vec.size(),
+                                   x_shape.data(), x_shape.size());
 
-      int64_t len_shape = 1;
-      int32_t len = x_shape[1];
-      Ort::Value x_len =
-          Ort::Value::CreateTensor(memory_info, &len, 1, &len_shape, 1);
+      int64_t len_shape = batch_size;
+      Ort::Value x_len = Ort::Value::CreateTensor(
+          memory_info, lens.data(), lens.size(), &len_shape, 1);
 
       Ort::Value out = model_.Forward(std::move(x), std::move(x_len));
 
@@ -90,59 +117,128 @@ class OfflinePunctuationCtTransformerImpl : public OfflinePunctuationImpl {
       std::vector<int64_t> out_shape =
           out.GetTensorTypeAndShapeInfo().GetShape();
 
-      assert(out_shape[0] == 1);
-      assert(out_shape[1] == len);
-      assert(out_shape[2] == meta_data.num_punctuations);
-
-      std::vector<int32_t> this_punctuations;
-      this_punctuations.reserve(len);
+      assert(out_shape[0] == batch_size);
+      assert(out_shape[1] == max_len);
+      assert(out_shape[2] == num_punctuations);
 
       const float *p = out.GetTensorData<float>();
-      for (int32_t k = 0; k != len; ++k, p += meta_data.num_punctuations) {
-        auto index = static_cast<int32_t>(std::distance(
-            p, std::max_element(p, p + meta_data.num_punctuations)));
-        this_punctuations.push_back(index);
-      }  // for (int32_t k = 0; k != len; ++k, p += meta_data.num_punctuations)
-
-      int32_t dot_index = -1;
-      int32_t comma_index = -1;
-
-      for (int32_t m = static_cast<int32_t>(this_punctuations.size()) - 2;
-           m >= 1; --m) {
-        int32_t punct_id = this_punctuations[m];
-
-        if (punct_id == meta_data.dot_id || punct_id == meta_data.quest_id) {
-          dot_index = m;
-          break;
-        }
+      for (int32_t b = 0; b != batch_size; ++b) {
+        ProcessSegment(p + b * out_shape[1] * num_punctuations, starts[b],
+                       lens[b], &docs[active[b]]);
+      }
+    }
 
-        if (comma_index == -1 && punct_id == meta_data.comma_id) {
-          comma_index = m;
-        }
-      }  // for (int32_t k = this_punctuations.size() - 1; k >= 1; --k)
+    std::vector<std::string> ans(num_texts);
+    for (int32_t i = 0; i != num_texts; ++i) {
+      ans[i] = Decode(texts[i], &docs[i]);
+    }
 
-      if (dot_index == -1 && len >= max_len && comma_index != -1) {
-        dot_index = comma_index;
-        this_punctuations[dot_index] = meta_data.dot_id;
-      }
+    return ans;
+  }
 
-      if (dot_index == -1) {
-        if (last == -1) {
-          last = this_start;
-        }
+ private:
+  static constexpr int32_t kSegmentSize = 20;
+  static constexpr int32_t kMaxLen = 200;
 
-        if (i == num_segments - 1) {
-          dot_index = static_cast<int32_t>(this_punctuations.size()) - 1;
-        }
+  // Decoding state of a single input text
+  struct Document {
+    std::vector<std::string> tokens;
+    std::vector<int32_t> token_ids;
+    int32_t num_segments = 0;
+    int32_t i = 0;  // index of the next segment to process
+    int32_t last = -1;
+    std::vector<int32_t> punctuations;
+  };
+
+  void Tokenize(const std::string &text, Document *d) const {
+    if (text.empty()) {
+      return;
+    }
+
+    d->tokens = SplitUtf8(text);
+    d->token_ids.reserve(d->tokens.size());
+
+    const auto &meta_data = model_.GetModelMetadata();
+
+    for (const auto &t : d->tokens) {
+      std::string token = ToLowerCase(t);
+      if (meta_data.token2id.count(token)) {
+        d->token_ids.push_back(meta_data.token2id.at(token));
       } else {
-        last = this_start + dot_index + 1;
+        d->token_ids.push_back(meta_data.unk_id);
+      }
+    }
+
+    d->num_segments =
+        ceil((static_cast<float>(d->token_ids.size()) + kSegmentSize - 1) /
+             kSegmentSize);
+  }
+
+  // @param p Model output for this segment. Its shape is
+  //          (len, num_punctuations)
+  void ProcessSegment(const float *p, int32_t this_start, int32_t len,
+                      Document *d) const {
+    const auto &meta_data = model_.GetModelMetadata();
+
+    std::vector<int32_t> this_punctuations;
+    this_punctuations.reserve(len);
+
+    for (int32_t k = 0; k != len; ++k, p += meta_data.num_punctuations) {
+      auto index = static_cast<int32_t>(std::distance(
+          p, std::max_element(p, p + meta_data.num_punctuations)));
+      this_punctuations.push_back(index);
+    }  // for (int32_t k = 0; k != len; ++k, p += meta_data.num_punctuations)
+
+    int32_t dot_index = -1;
+    int32_t comma_index = -1;
+
+    for (int32_t m = static_cast<int32_t>(this_punctuations.size()) - 2;
+         m >= 1; --m) {
+      int32_t punct_id = this_punctuations[m];
+
+      if (punct_id == meta_data.dot_id || punct_id == meta_data.quest_id) {
+        dot_index = m;
+        break;
+      }
+
+      if (comma_index == -1 && punct_id == meta_data.comma_id) {
+        comma_index = m;
+      }
+    }  // for (int32_t k = this_punctuations.size() - 1; k >= 1; --k)
+
+    if (dot_index == -1 && len >= kMaxLen && comma_index != -1) {
+      dot_index = comma_index;
+      this_punctuations[dot_index] = meta_data.dot_id;
+    }
+
+    if (dot_index == -1) {
+      if (d->last == -1) {
+        d->last = this_start;
       }
 
-      if (dot_index != -1) {
-        punctuations.insert(punctuations.end(), this_punctuations.begin(),
-                            this_punctuations.begin() + (dot_index + 1));
+      if (d->i == d->num_segments - 1) {
+        dot_index = static_cast<int32_t>(this_punctuations.size()) - 1;
       }
-    }  // for (int32_t i = 0; i != num_segments; ++i)
+    } else {
+      d->last = this_start + dot_index + 1;
+    }
+
+    if (dot_index != -1) {
+      d->punctuations.insert(d->punctuations.end(), this_punctuations.begin(),
+                             this_punctuations.begin() + (dot_index + 1));
+    }
+
+    ++d->i;
+  }
+
+  std::string Decode(const std::string &text, Document *d) const {
+    if (text.empty()) {
+      return {};
+    }
+
+    const auto &meta_data = model_.GetModelMetadata();
+    const auto &punctuations = d->punctuations;
+    auto &tokens = d->tokens;
 
     if (punctuations.empty()) {
       return text + meta_data.id2punct[meta_data.dot_id];
@@ -24,6 +24,9 @@ class OfflinePunctuationImpl {
       Manager *mgr, const OfflinePunctuationConfig &config);
 
   virtual std::string AddPunctuation(const std::string &text) const = 0;
+
+  virtual std::vector<std::string> AddPunctuationBatch(
+      const std::vector<std::string> &texts) const = 0;
 };
 
 }  // namespace sherpa_onnx
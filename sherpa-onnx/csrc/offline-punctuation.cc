@@ -5,6 +5,7 @@
 #include "sherpa-onnx/csrc/offline-punctuation.h"
 
 #include <string>
+#include <vector>
 
 #if __ANDROID_API__ >= 9
 #include "android/asset_manager.h"
@@ -22,6 +23,10 @@ namespace sherpa_onnx {
 
 void OfflinePunctuationConfig::Register(ParseOptions *po) {
   model.Register(po);
+
+  po->Register("punctuation-lazy-init", &lazy_init,
+               "true to load the punctuation model on first use instead of "
+               "at startup");
 }
 
 bool OfflinePunctuationConfig::Validate() const {
@@ -36,18 +41,25 @@ std::string OfflinePunctuationConfig::ToString() const {
   std::ostringstream os;
 
   os << "OfflinePunctuationConfig(";
-  os << "model=" << model.ToString() << ")";
+  os << "model=" << model.ToString() << ", ";
+  os << "lazy_init=" << (lazy_init ? "True" : "False") << ")";
 
   return os.str();
 }
 
 OfflinePunctuation::OfflinePunctuation(const OfflinePunctuationConfig &config)
-    : impl_(OfflinePunctuationImpl::Create(config)) {}
+    : config_(config) {
+  if (!config.lazy_init) {
+    impl_ = OfflinePunctuationImpl::Create(config);
+  }
+}
 
 template <typename Manager>
 OfflinePunctuation::OfflinePunctuation(Manager *mgr,
                                        const OfflinePunctuationConfig &config)
-    : impl_(OfflinePunctuationImpl::Create(mgr, config)) {}
+    : config_(config),
+      // lazy_init is ignored when reading models from an asset manager
+      impl_(OfflinePunctuationImpl::Create(mgr, config)) {}
 
 #if __ANDROID_API__ >= 9
 template OfflinePunctuation::OfflinePunctuation(
@@ -61,8 +73,23 @@ template OfflinePunctuation::OfflinePunctuation(
 
 OfflinePunctuation::~OfflinePunctuation() = default;
 
+OfflinePunctuationImpl *OfflinePunctuation::Impl() const {
+  std::call_once(init_flag_, [this]() {
+    if (!impl_) {
+      impl_ = OfflinePunctuationImpl::Create(config_);
+    }
+  });
+
+  return impl_.get();
+}
+
 std::string OfflinePunctuation::AddPunctuation(const std::string &text) const {
-  return impl_->AddPunctuation(text);
+  return Impl()->AddPunctuation(text);
+}
+
+std::vector<std::string> OfflinePunctuation::AddPunctuationBatch(
+    const std::vector<std::string> &texts) const {
+  return Impl()->AddPunctuationBatch(texts);
 }
 
 }  // namespace sherpa_onnx
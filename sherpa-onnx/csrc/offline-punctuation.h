@@ -5,6 +5,7 @@
 #define SHERPA_ONNX_CSRC_OFFLINE_PUNCTUATION_H_
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
@@ -16,6 +17,9 @@ namespace sherpa_onnx {
 struct OfflinePunctuationConfig {
   OfflinePunctuationModelConfig model;
 
+  // If true, the model is loaded on first use instead of at startup
+  bool lazy_init = false;
+
   OfflinePunctuationConfig() = default;
 
   explicit OfflinePunctuationConfig(const OfflinePunctuationModelConfig &model)
@@ -41,8 +45,21 @@ class OfflinePunctuation {
   // Add punctuation to the input text and return it.
   std::string AddPunctuation(const std::string &text) const;
 
+  // Same as AddPunctuation() but for many texts. It is faster than calling
+  // AddPunctuation() for each text since segments of different texts
+  // are processed by the model together.
+  std::vector<std::string> AddPunctuationBatch(
+      const std::vector<std::string> &texts) const;
+
  private:
-  std::unique_ptr<OfflinePunctuationImpl> impl_;
+  OfflinePunctuationImpl *Impl() const;
+
+ private:
+  OfflinePunctuationConfig config_;
+
+  // If config_.lazy_init is true, impl_ is created on first use
+  mutable std::once_flag init_flag_;
+  mutable std::unique_ptr<OfflinePunctuationImpl> impl_;
 };
 
 }  // namespace sherpa_onnx
@@ -294,7 +294,7 @@ class OfflineRecognizerCtcImpl : public OfflineRecognizerImpl {
 
  private:
   // Decode a single stream.
-  // Some models do not support batch size > 1, e.g., WeNet CTC models.
+  // Some models do not support batch size > 1, e.g., TeleSpeech CTC models.
   void DecodeStream(OfflineStream *s) const {
     auto memory_info =
         Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
@@ -912,24 +912,42 @@ OfflineRecognizerImpl::OfflineRecognizerImpl(
 
 std::string OfflineRecognizerImpl::ApplyInverseTextNormalization(
     std::string text) const {
-  text = RemoveInvalidUtf8Sequences(text);
+  if (itn_list_.empty()) {
+    return RemoveInvalidUtf8Sequences(text);
+  }
 
-  if (!itn_list_.empty()) {
-    for (const auto &tn : itn_list_) {
-      text = tn->Normalize(text);
-    }
+  // The same text is often normalized again, e.g., partial results of
+  // a stream or common short utterances, so results are memoized.
+  std::string ans;
+  if (itn_cache_.Get(text, &ans)) {
+    return ans;
+  }
+
+  ans = RemoveInvalidUtf8Sequences(text);
+  for (const auto &tn : itn_list_) {
+    ans = tn->Normalize(ans);
   }
 
-  return text;
+  itn_cache_.Put(text, ans);
+
+  return ans;
 }
 
 std::string OfflineRecognizerImpl::ApplyHomophoneReplacer(
     std::string text) const {
-  if (hr_) {
-    text = hr_->Apply(text);
+  if (!hr_) {
+    return text;
+  }
+
+  std::string ans;
+  if (hr_cache_.Get(text, &ans)) {
+    return ans;
   }
 
-  return text;
+  ans = hr_->Apply(text);
+  hr_cache_.Put(text, ans);
+
+  return ans;
 }
 
 void OfflineRecognizerImpl::SetConfig(const OfflineRecognizerConfig &config) {
@@ -11,6 +11,7 @@
 
 #include "kaldifst/csrc/text-normalizer.h"
 #include "sherpa-onnx/csrc/homophone-replacer.h"
+#include "sherpa-onnx/csrc/lru-cache.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/offline-recognizer.h"
 #include "sherpa-onnx/csrc/offline-stream.h"
@@ -58,6 +59,13 @@ class OfflineRecognizerImpl {
   // config.rule_fars is not empty
   std::vector<std::unique_ptr<kaldifst::TextNormalizer>> itn_list_;
   std::unique_ptr<HomophoneReplacer> hr_;
+
+  // Number of memoized results of ITN and of the homophone replacer
+  static constexpr size_t kPostProcessingCacheCapacity = 1000;
+  mutable LruCache<std::string, std::string> itn_cache_{
+      kPostProcessingCacheCapacity};
+  mutable LruCache<std::string, std::string> hr_cache_{
+      kPostProcessingCacheCapacity};
 };
 
 }  // namespace sherpa_onnx
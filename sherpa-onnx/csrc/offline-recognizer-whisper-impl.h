@@ -116,24 +116,36 @@ class OfflineRecognizerWhisperImpl : public OfflineRecognizerImpl {
     int32_t actual_frames =
         std::min(num_frames + tail_padding_frames, max_num_frames);
 
-    std::array<int64_t, 3> shape{1, actual_frames, feat_dim};
+    // The encoder output may have been cached in the stream, e.g., by
+    // SpokenLanguageIdentification with the option keep_encoder_output
+    std::vector<Ort::Value> encoder_out =
+        s->TakeEncoderOutput(OfflineWhisperModel::EncoderOutputKey(
+            config_.model_config.whisper.encoder, actual_frames));
 
-    Ort::Value mel = Ort::Value::CreateTensor<float>(
-        model_->Allocator(), shape.data(), shape.size());
+    try {
+      if (encoder_out.size() != 2) {
+        std::array<int64_t, 3> shape{1, actual_frames, feat_dim};
 
-    float *p_mel = mel.GetTensorMutableData<float>();
-    std::copy(f.data(), f.data() + num_frames * feat_dim, p_mel);
+        Ort::Value mel = Ort::Value::CreateTensor<float>(
+            model_->Allocator(), shape.data(), shape.size());
 
-    std::fill_n(p_mel + num_frames * feat_dim,
-                (actual_frames - num_frames) * feat_dim, 0);
+        float *p_mel = mel.GetTensorMutableData<float>();
+        std::copy(f.data(), f.data() + num_frames * feat_dim, p_mel);
 
-    mel = Transpose12(model_->Allocator(), &mel);
+        std::fill_n(p_mel + num_frames * feat_dim,
+                    (actual_frames - num_frames) * feat_dim, 0);
 
-    try {
-      auto cross_kv = model_->ForwardEncoder(std::move(mel));
+        mel = Transpose12(model_->Allocator(), &mel);
+
+        auto cross_kv = model_->ForwardEncoder(std::move(mel));
+
+        encoder_out.clear();
+        encoder_out.push_back(std::move(cross_kv.first));
+        encoder_out.push_back(std::move(cross_kv.second));
+      }
 
-      auto results = decoder_->Decode(std::move(cross_kv.first),
-                                      std::move(cross_kv.second), num_frames);
+      auto results = decoder_->Decode(std::move(encoder_out[0]),
+                                      std::move(encoder_out[1]), num_frames);
 
       auto r = Convert(results[0], symbol_table_);
       s->SetResult(r);
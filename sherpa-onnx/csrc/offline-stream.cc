@@ -256,6 +256,23 @@ class OfflineStream::Impl {
     return default_value;
   }
 
+  void SetEncoderOutput(const std::string &key, std::vector<Ort::Value> out) {
+    encoder_output_key_ = key;
+    encoder_output_ = std::move(out);
+  }
+
+  std::vector<Ort::Value> TakeEncoderOutput(const std::string &key) {
+    if (encoder_output_.empty() || key != encoder_output_key_) {
+      return {};
+    }
+
+    encoder_output_key_.clear();
+
+    std::vector<Ort::Value> ans;
+    ans.swap(encoder_output_);
+    return ans;
+  }
+
  private:
   // see
   // https://github.com/pytorch/audio/blob/main/src/torchaudio/functional/functional.py#L359
@@ -316,6 +333,9 @@ class OfflineStream::Impl {
   std::vector<float> samples_;
 
   std::unordered_map<std::string, std::string> options_;
+
+  std::string encoder_output_key_;
+  std::vector<Ort::Value> encoder_output_;
 };
 
 OfflineStream::OfflineStream(const FeatureExtractorConfig &config /*= {}*/,
@@ -381,6 +401,16 @@ float OfflineStream::GetOptionFloat(const std::string &key,
   return impl_->GetOptionFloat(key, default_value);
 }
 
+void OfflineStream::SetEncoderOutput(const std::string &key,
+                                     std::vector<Ort::Value> out) {
+  impl_->SetEncoderOutput(key, std::move(out));
+}
+
+std::vector<Ort::Value> OfflineStream::TakeEncoderOutput(
+    const std::string &key) {
+  return impl_->TakeEncoderOutput(key);
+}
+
 std::string OfflineRecognitionResult::AsJsonString() const {
   std::ostringstream os;
   os << "{";
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "onnxruntime_cxx_api.h"  // NOLINT
 #include "sherpa-onnx/csrc/context-graph.h"
 #include "sherpa-onnx/csrc/features.h"
 #include "sherpa-onnx/csrc/parse-options.h"
@@ -126,6 +127,17 @@ class OfflineStream {
   float GetOptionFloat(const std::string &key,
                        float default_value = 0.0f) const;
 
+  // Cache the encoder output computed from this stream so that a later
+  // model running the same encoder on it can skip the encoder, e.g.,
+  // whisper spoken language identification followed by whisper
+  // recognition. The key identifies both the model and its input.
+  // Any previously cached output is replaced.
+  void SetEncoderOutput(const std::string &key, std::vector<Ort::Value> out);
+
+  // Return the cached encoder output and remove it from this stream.
+  // Return an empty vector if there is no output cached under the given key.
+  std::vector<Ort::Value> TakeEncoderOutput(const std::string &key);
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
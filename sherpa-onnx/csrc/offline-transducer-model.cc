@@ -98,19 +98,16 @@ class OfflineTransducerModel::Impl {
         env_(ORT_LOGGING_LEVEL_ERROR),
         sess_opts_(GetSessionOptions(config)),
         allocator_{} {
-    encoder_sess_ = std::make_unique<Ort::Session>(
-        env_, SHERPA_ONNX_TO_ORT_PATH(config.transducer.encoder_filename),
-        sess_opts_);
+    encoder_sess_ = CreateSession(env_, config.transducer.encoder_filename,
+                                  sess_opts_, &mapped_encoder_);
     InitEncoder(nullptr, 0);
 
-    decoder_sess_ = std::make_unique<Ort::Session>(
-        env_, SHERPA_ONNX_TO_ORT_PATH(config.transducer.decoder_filename),
-        sess_opts_);
+    decoder_sess_ = CreateSession(env_, config.transducer.decoder_filename,
+                                  sess_opts_, &mapped_decoder_);
     InitDecoder(nullptr, 0);
 
-    joiner_sess_ = std::make_unique<Ort::Session>(
-        env_, SHERPA_ONNX_TO_ORT_PATH(config.transducer.joiner_filename),
-        sess_opts_);
+    joiner_sess_ = CreateSession(env_, config.transducer.joiner_filename,
+                                 sess_opts_, &mapped_joiner_);
     InitJoiner(nullptr, 0);
   }
 
@@ -337,6 +334,11 @@ class OfflineTransducerModel::Impl {
   Ort::SessionOptions sess_opts_;
   Ort::AllocatorWithDefaultOptions allocator_;
 
+  // Non-null if the models are memory mapped. They must outlive the sessions
+  std::unique_ptr<MappedFile> mapped_encoder_;
+  std::unique_ptr<MappedFile> mapped_decoder_;
+  std::unique_ptr<MappedFile> mapped_joiner_;
+
   std::unique_ptr<Ort::Session> encoder_sess_;
   std::unique_ptr<Ort::Session> decoder_sess_;
   std::unique_ptr<Ort::Session> joiner_sess_;
@@ -59,6 +59,23 @@ class OfflineTtsImpl {
 
   std::vector<int64_t> AddBlank(const std::vector<int64_t> &x,
                                 int32_t blank_id = 0) const;
+
+ protected:
+  // For models with a separate vocoder that can pass audio to the callback
+  // chunk by chunk while vocoding. See Vocoder::RunChunked()
+  struct ChunkedVocoding {
+    int32_t chunk_size = 0;  // 0 means it is disabled
+    int32_t overlap = 0;
+    GeneratedAudioCallback callback;
+
+    // progress reported to the callback goes from progress_start
+    // to progress_end while vocoding a single mel
+    float progress_start = 0;
+    float progress_end = 1;
+
+    // set to 0 if the callback asks to stop
+    int32_t should_continue = 1;
+  };
 };
 
 }  // namespace sherpa_onnx
@@ -49,7 +49,7 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
         SHERPA_ONNX_EXIT(-1);
       }
 
-      vocoder_ = Vocoder::Create(config.model);
+      vocoder_ = Vocoder::CreateShared(config.model);
     } else if (!config.model.matcha.vocoder.empty()) {
       SHERPA_ONNX_LOGE(
           "You don't need to provide vocoder for this model. Ignore it");
@@ -131,7 +131,7 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
         SHERPA_ONNX_EXIT(-1);
       }
 
-      vocoder_ = Vocoder::Create(mgr, config.model);
+      vocoder_ = Vocoder::CreateShared(mgr, config.model);
     } else if (!config.model.matcha.vocoder.empty()) {
       SHERPA_ONNX_LOGE(
           "You don't need to provide vocoder for this model. Ignore it");
@@ -209,7 +209,12 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
   //   - silence_scale: Scale applied to pauses in the generated audio
   //
   // Supported extra options in config.extra:
-  //   - None
+  //   - vocoder_chunk_size: If > 0 and a callback is given, the vocoder
+  //     runs over this many mel frames at a time and the callback is
+  //     invoked for each chunk, so audio is available before the whole
+  //     sentence is vocoded (default: 0, i.e., disabled)
+  //   - vocoder_chunk_overlap: Number of context mel frames on each side
+  //     of a chunk; the overlapping audio is cross-faded (default: 4)
   GeneratedAudio Generate(
       const std::string &_text, const GenerationConfig &gen_config,
       GeneratedAudioCallback callback = nullptr) const override {
@@ -308,9 +313,16 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
 
     int32_t x_size = static_cast<int32_t>(x.size());
 
+    ChunkedVocoding chunked;
+    if (callback && meta_data.need_vocoder) {
+      chunked.chunk_size = gen_config.GetExtraInt("vocoder_chunk_size", 0);
+      chunked.overlap = gen_config.GetExtraInt("vocoder_chunk_overlap", 4);
+      chunked.callback = callback;
+    }
+
     if (config_.max_num_sentences <= 0 || x_size <= config_.max_num_sentences) {
-      auto ans = Process(x, sid, speed, gen_config.silence_scale);
-      if (callback) {
+      auto ans = Process(x, sid, speed, gen_config.silence_scale, &chunked);
+      if (callback && chunked.chunk_size <= 0) {
         callback(ans.samples.data(), ans.samples.size(), 1.0);
       }
       return ans;
@@ -350,11 +362,17 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
         batch_x.push_back(std::move(x[k]));
       }
 
-      auto audio = Process(batch_x, sid, speed, gen_config.silence_scale);
+      chunked.progress_start = b * 1.0 / num_batches;
+      chunked.progress_end = (b + 1) * 1.0 / num_batches;
+
+      auto audio =
+          Process(batch_x, sid, speed, gen_config.silence_scale, &chunked);
       ans.sample_rate = audio.sample_rate;
       ans.samples.insert(ans.samples.end(), audio.samples.begin(),
                          audio.samples.end());
-      if (callback) {
+      if (chunked.chunk_size > 0) {
+        should_continue = chunked.should_continue;
+      } else if (callback) {
         should_continue = callback(audio.samples.data(), audio.samples.size(),
                                    (b + 1) * 1.0 / num_batches);
         // Caution(fangjun): audio is freed when the callback returns, so users
@@ -371,11 +389,15 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
     }
 
     if (!batch_x.empty()) {
-      auto audio = Process(batch_x, sid, speed, gen_config.silence_scale);
+      chunked.progress_start = chunked.progress_end;
+      chunked.progress_end = 1.0;
+
+      auto audio =
+          Process(batch_x, sid, speed, gen_config.silence_scale, &chunked);
       ans.sample_rate = audio.sample_rate;
       ans.samples.insert(ans.samples.end(), audio.samples.begin(),
                          audio.samples.end());
-      if (callback) {
+      if (callback && chunked.chunk_size <= 0) {
         callback(audio.samples.data(), audio.samples.size(), 1.0);
         // Caution(fangjun): audio is freed when the callback returns, so users
         // should copy the data if they want to access the data after
@@ -445,8 +467,8 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
   }
 
   GeneratedAudio Process(const std::vector<std::vector<int64_t>> &tokens,
-                         int32_t sid, float speed,
-                         float silence_scale) const {
+                         int32_t sid, float speed, float silence_scale,
+                         ChunkedVocoding *chunked = nullptr) const {
     int32_t num_tokens = 0;
     for (const auto &k : tokens) {
       num_tokens += k.size();
@@ -479,7 +501,45 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
     Ort::Value mel = model_->Run(std::move(x_tensor), sid, speed);
 
     const auto &meta_data = model_->GetMetaData();
-    if (meta_data.need_vocoder) {
+    if (meta_data.need_vocoder && chunked && chunked->chunk_size > 0) {
+      ans.sample_rate = meta_data.sample_rate;
+
+      // Silence is scaled as the audio arrives so that the audio passed to
+      // the callback is identical to the returned audio, and to the audio
+      // returned when chunked vocoding is disabled.
+      SilenceScaler scaler(meta_data.sample_rate, silence_scale);
+
+      float p = chunked->progress_start;
+
+      chunked->should_continue = vocoder_->RunChunked(
+          std::move(mel), chunked->chunk_size, chunked->overlap,
+          [&](const float *samples, int32_t n, float progress) -> int32_t {
+            std::vector<float> audio = scaler.Accept(samples, n);
+
+            ans.samples.insert(ans.samples.end(), audio.begin(), audio.end());
+
+            p = chunked->progress_start +
+                (chunked->progress_end - chunked->progress_start) * progress;
+
+            if (audio.empty()) {
+              return 1;
+            }
+
+            return chunked->callback(audio.data(), audio.size(), p);
+          });
+
+      if (chunked->should_continue) {
+        std::vector<float> audio = scaler.Flush();
+        ans.samples.insert(ans.samples.end(), audio.begin(), audio.end());
+
+        if (!audio.empty()) {
+          chunked->should_continue =
+              chunked->callback(audio.data(), audio.size(), p);
+        }
+      }
+
+      return ans;
+    } else if (meta_data.need_vocoder) {
       ans.samples = vocoder_->Run(std::move(mel));
     } else {
       std::vector<int64_t> shape = mel.GetTensorTypeAndShapeInfo().GetShape();
@@ -504,7 +564,7 @@ class OfflineTtsMatchaImpl : public OfflineTtsImpl {
  private:
   OfflineTtsConfig config_;
   std::unique_ptr<OfflineTtsMatchaModel> model_;
-  std::unique_ptr<Vocoder> vocoder_;
+  std::shared_ptr<Vocoder> vocoder_;
   std::vector<std::unique_ptr<kaldifst::TextNormalizer>> tn_list_;
   std::unique_ptr<OfflineTtsFrontend> frontend_;
 };
@@ -27,6 +27,16 @@ void OfflineTtsModelConfig::Register(ParseOptions *po) {
 
   po->Register("provider", &provider,
                "Specify a provider to use: cpu, cuda, coreml");
+
+  po->Register("tts-vocoder-batch-size", &vocoder_batch_size,
+               "If > 1, the vocoder is shared by concurrent requests and "
+               "mels from them are vocoded in batches of at most this size. "
+               "Used only by models with a separate vocoder.");
+
+  po->Register("tts-vocoder-batch-wait-ms", &vocoder_batch_wait_ms,
+               "Maximum time in milliseconds to wait for more requests "
+               "before vocoding a partial batch. Used only if "
+               "--tts-vocoder-batch-size > 1");
 }
 
 bool OfflineTtsModelConfig::Validate() const {
@@ -35,6 +45,18 @@ bool OfflineTtsModelConfig::Validate() const {
     return false;
   }
 
+  if (vocoder_batch_size < 1) {
+    SHERPA_ONNX_LOGE("vocoder_batch_size should be > 0. Given %d",
+                     vocoder_batch_size);
+    return false;
+  }
+
+  if (vocoder_batch_wait_ms < 0) {
+    SHERPA_ONNX_LOGE("vocoder_batch_wait_ms should be >= 0. Given %d",
+                     vocoder_batch_wait_ms);
+    return false;
+  }
+
   if (!vits.model.empty()) {
     return vits.Validate();
   }
@@ -81,7 +103,9 @@ std::string OfflineTtsModelConfig::ToString() const {
   os << "supertonic=" << supertonic.ToString() << ", ";
   os << "num_threads=" << num_threads << ", ";
   os << "debug=" << (debug ? "True" : "False") << ", ";
-  os << "provider=\"" << provider << "\")";
+  os << "provider=\"" << provider << "\", ";
+  os << "vocoder_batch_size=" << vocoder_batch_size << ", ";
+  os << "vocoder_batch_wait_ms=" << vocoder_batch_wait_ms << ")";
 
   return os.str();
 }
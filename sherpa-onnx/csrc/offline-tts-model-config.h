@@ -31,6 +31,16 @@ struct OfflineTtsModelConfig {
   bool debug = false;
   std::string provider = "cpu";
 
+  // Used only by models with a separate vocoder, e.g., matcha and zipvoice.
+  // If > 1, all OfflineTts objects in the process using the same vocoder
+  // share it, and mels from concurrent requests are vocoded together in
+  // batches of at most this size.
+  int32_t vocoder_batch_size = 1;
+
+  // Maximum time in milliseconds to wait for more requests before
+  // running a partial batch. Used only if vocoder_batch_size > 1.
+  int32_t vocoder_batch_wait_ms = 5;
+
   OfflineTtsModelConfig() = default;
 
   OfflineTtsModelConfig(const OfflineTtsVitsModelConfig &vits,
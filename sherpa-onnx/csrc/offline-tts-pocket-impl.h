@@ -13,13 +13,10 @@
 #include <iomanip>
 #include <ios>
 #include <limits>
-#include <list>
 #include <memory>
-#include <mutex>
 #include <sstream>
 #include <string>
 #include <tuple>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -28,11 +25,13 @@
 #include "kaldifst/csrc/text-normalizer.h"
 #include "sherpa-onnx/csrc/file-utils.h"
 #include "sherpa-onnx/csrc/fst-utils.h"
+#include "sherpa-onnx/csrc/lru-cache.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/math.h"
 #include "sherpa-onnx/csrc/normal-data-generator.h"
 #include "sherpa-onnx/csrc/offline-tts-impl.h"
 #include "sherpa-onnx/csrc/offline-tts-pocket-model.h"
+#include "sherpa-onnx/csrc/offline-tts-pocket-voice-cache.h"
 #include "sherpa-onnx/csrc/resample.h"
 #include "sherpa-onnx/csrc/sentence-piece-tokenizer.h"
 #include "sherpa-onnx/csrc/text-utils.h"
@@ -46,7 +45,8 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
         model_(std::make_unique<OfflineTtsPocketModel>(config.model)) {
     InitTokenizer();
 
-    cache_.SetCapacity(config.model.pocket.voice_embedding_cache_capacity);
+    SetCacheCapacity(config.model.pocket.voice_embedding_cache_capacity);
+    encoder_id_ = PocketVoiceEncoderId(config.model.pocket.encoder);
 
     if (!config.rule_fsts.empty()) {
       std::vector<std::string> files;
@@ -103,7 +103,8 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
       : config_(config),
         model_(std::make_unique<OfflineTtsPocketModel>(mgr, config.model)) {
     InitTokenizer(mgr);
-    cache_.SetCapacity(config.model.pocket.voice_embedding_cache_capacity);
+    SetCacheCapacity(config.model.pocket.voice_embedding_cache_capacity);
+    encoder_id_ = PocketVoiceEncoderId(config.model.pocket.encoder);
 
     if (!config.rule_fsts.empty()) {
       std::vector<std::string> files;
@@ -164,6 +165,10 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
    *  - max_char_in_sentence, int, default 200
    *  - min_char_in_sentence, int, default 30
    *  - seed, int, default -1
+   *  - streaming, int, default 0. If it is 1, every chunk_size latents are
+   *    decoded and passed to the callback while the remaining latents
+   *    of the sentence are still being generated. The generated audio
+   *    is the same as the one with streaming 0.
    */
   GeneratedAudio Generate(
       const std::string &_text, const GenerationConfig &gen_config,
@@ -357,7 +362,52 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
     Ort::Value conditioning{nullptr};
     Ort::Value eos_logit{nullptr};
 
+    auto decoder_state = model_->GetMimiDecoderInitState();
+
+    int32_t chunk_size = gen_config.GetExtraInt("chunk_size", 15);
+    bool streaming = gen_config.GetExtraInt("streaming", 0) != 0;
+
+    std::array<int64_t, 3> chunk_shape = {1, chunk_size, -1};
+
     std::vector<float> latent_list;
+    std::vector<float> audio_list;
+
+    // Number of frames in latent_list that have been decoded
+    int32_t num_decoded_frames = 0;
+
+    // The mimi decoder is stateful, so latents have to be decoded
+    // in order. It returns the value returned by the callback.
+    auto decode_chunk = [&](int32_t this_chunk_size, int32_t frame_size,
+                            float progress) -> bool {
+      chunk_shape[1] = this_chunk_size;
+      chunk_shape[2] = frame_size;
+
+      float *p = latent_list.data() + num_decoded_frames * frame_size;
+
+      Ort::Value chunk_tensor = Ort::Value::CreateTensor(
+          memory_info, p, this_chunk_size * frame_size, chunk_shape.data(),
+          chunk_shape.size());
+
+      num_decoded_frames += this_chunk_size;
+
+      Ort::Value out = RunMimiDecoder(std::move(chunk_tensor), decoder_state);
+
+      auto n = out.GetTensorTypeAndShapeInfo().GetShape().back();
+
+      bool ans = true;
+      if (callback) {
+        ans = callback(out.GetTensorData<float>(), n, progress);
+        // Caution(fangjun): out is freed when the callback returns, so users
+        // should copy the data if they want to access the data after
+        // the callback returns to avoid segmentation fault.
+      }
+
+      audio_list.insert(audio_list.end(), out.GetTensorData<float>(),
+                        out.GetTensorData<float>() + n);
+
+      return ans;
+    };
+
     int32_t eos_step = -1;
     int32_t frame_size = -1;
     for (int32_t step = 0; step < max_frames; ++step) {
@@ -391,55 +441,39 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
 
       latent_list.insert(latent_list.end(), latent.GetTensorData<float>(),
                          latent.GetTensorData<float>() + n);
-    }
-
-    lm_main_state.values.clear();
-
-    auto decoder_state = model_->GetMimiDecoderInitState();
-
-    int32_t chunk_size = gen_config.GetExtraInt("chunk_size", 15);
 
-    int32_t num_chunks = latent_list.size() / frame_size / chunk_size;
-    std::array<int64_t, 3> chunk_shape = {1, chunk_size, frame_size};
-
-    std::vector<float> audio_list;
-
-    int32_t remaining_chunks =
-        (latent_list.size() - num_chunks * chunk_size * frame_size) /
-        frame_size;
-
-    const float *p = latent_list.data();
-    for (int32_t i = 0;
-         (p < latent_list.data() + latent_list.size()) && should_continue;
-         ++i) {
-      int32_t this_chunk_size = chunk_size;
-      if (i >= num_chunks) {
-        this_chunk_size = remaining_chunks;
+      if (streaming &&
+          static_cast<int32_t>(latent_list.size()) / frame_size -
+                  num_decoded_frames >=
+              chunk_size) {
+        // The total number of frames is not known yet, so the progress
+        // is relative to max_frames
+        should_continue = decode_chunk(chunk_size, frame_size,
+                                       (step + 1) * 1.0 / max_frames);
+        if (!should_continue) {
+          break;
+        }
       }
+    }
 
-      chunk_shape[1] = this_chunk_size;
-
-      Ort::Value chunk_tensor = Ort::Value::CreateTensor(
-          memory_info, const_cast<float *>(p), this_chunk_size * frame_size,
-          chunk_shape.data(), chunk_shape.size());
-
-      p += this_chunk_size * frame_size;
+    lm_main_state.values.clear();
 
-      Ort::Value out = RunMimiDecoder(std::move(chunk_tensor), decoder_state);
+    if (frame_size <= 0) {
+      return {};
+    }
 
-      auto n = out.GetTensorTypeAndShapeInfo().GetShape().back();
+    // Decode the remaining latents. In streaming mode, there are fewer
+    // than chunk_size of them.
+    int32_t num_frames = latent_list.size() / frame_size;
+    int32_t num_remaining_chunks =
+        (num_frames - num_decoded_frames + chunk_size - 1) / chunk_size;
 
-      if (callback) {
-        should_continue =
-            callback(out.GetTensorData<float>(), n,
-                     (i + 1) * 1.0 / (num_chunks + !!remaining_chunks));
-        // Caution(fangjun): out is freed when the callback returns, so users
-        // should copy the data if they want to access the data after
-        // the callback returns to avoid segmentation fault.
-      }
+    for (int32_t i = 0; i < num_remaining_chunks && should_continue; ++i) {
+      int32_t this_chunk_size =
+          std::min(chunk_size, num_frames - num_decoded_frames);
 
-      audio_list.insert(audio_list.end(), out.GetTensorData<float>(),
-                        out.GetTensorData<float>() + n);
+      should_continue = decode_chunk(this_chunk_size, frame_size,
+                                     (i + 1) * 1.0 / num_remaining_chunks);
     }
 
     GeneratedAudio ans;
@@ -527,17 +561,25 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
     // Compute hash of reference audio for cache lookup
     size_t audio_hash = ComputeHash(p_audio, num_samples);
 
-    auto cached_embedding = cache_.Get(audio_hash);
-    if (cached_embedding) {
+    std::shared_ptr<const Embedding> cached_embedding;
+    if (cache_.Get(audio_hash, &cached_embedding)) {
       if (config_.model.debug) {
         SHERPA_ONNX_LOGE("CACHE HIT: voice embedding (hash=%zu)", audio_hash);
       }
-      // Create an owned tensor and copy data to avoid use-after-free
-      auto result = Ort::Value::CreateTensor<float>(
-          model_->Allocator(), cached_embedding->second.data(),
-          cached_embedding->second.size());
-      std::copy(cached_embedding->first.begin(), cached_embedding->first.end(),
-                result.GetTensorMutableData<float>());
+      return EmbeddingToTensor(cached_embedding->first,
+                               cached_embedding->second);
+    }
+
+    std::vector<float> disk_data;
+    std::vector<int64_t> disk_shape;
+    if (LoadVoiceEmbedding(audio_hash, &disk_data, &disk_shape)) {
+      if (config_.model.debug) {
+        SHERPA_ONNX_LOGE("DISK CACHE HIT: voice embedding (hash=%zu)",
+                         audio_hash);
+      }
+      auto result = EmbeddingToTensor(disk_data, disk_shape);
+      cache_.Put(audio_hash, std::make_shared<const Embedding>(
+                                 std::move(disk_data), std::move(disk_shape)));
       return result;
     }
 
@@ -556,8 +598,12 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
     size_t total = info.GetElementCount();
     const float *result_data = result.GetTensorData<float>();
 
-    cache_.Put(audio_hash, std::vector<float>(result_data, result_data + total),
-               std::move(result_shape));
+    SaveVoiceEmbedding(audio_hash, result_data, result_shape);
+
+    cache_.Put(audio_hash,
+               std::make_shared<const Embedding>(
+                   std::vector<float>(result_data, result_data + total),
+                   std::move(result_shape)));
 
     if (config_.model.debug) {
       SHERPA_ONNX_LOGE("CACHE MISS: cached embedding (hash=%zu, %zu floats)",
@@ -567,6 +613,46 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
     return result;
   }
 
+  void SetCacheCapacity(int32_t capacity) {
+    if (capacity < 0) {
+      SHERPA_ONNX_LOGE(
+          "voice_embedding_cache_capacity must be >= 0. Given: %d", capacity);
+      SHERPA_ONNX_EXIT(-1);
+    }
+
+    cache_.SetCapacity(capacity);
+  }
+
+  // Create an owned tensor and copy data to avoid use-after-free
+  Ort::Value EmbeddingToTensor(const std::vector<float> &data,
+                               const std::vector<int64_t> &shape) const {
+    auto result = Ort::Value::CreateTensor<float>(
+        model_->Allocator(), shape.data(), shape.size());
+    std::copy(data.begin(), data.end(), result.GetTensorMutableData<float>());
+    return result;
+  }
+
+  // Return an empty string if the on-disk cache is disabled
+  std::string VoiceEmbeddingFilename(size_t audio_hash) const {
+    return PocketVoiceEmbeddingFilename(
+        config_.model.pocket.voice_embedding_cache_dir, encoder_id_,
+        audio_hash);
+  }
+
+  bool LoadVoiceEmbedding(size_t audio_hash, std::vector<float> *data,
+                          std::vector<int64_t> *shape) const {
+    std::string filename = VoiceEmbeddingFilename(audio_hash);
+    return !filename.empty() && ReadPocketVoiceEmbedding(filename, data, shape);
+  }
+
+  void SaveVoiceEmbedding(size_t audio_hash, const float *data,
+                          const std::vector<int64_t> &shape) const {
+    std::string filename = VoiceEmbeddingFilename(audio_hash);
+    if (!filename.empty()) {
+      WritePocketVoiceEmbedding(filename, data, shape);
+    }
+  }
+
   Ort::Value GetTextEmbedding(const std::string &text) const {
     std::vector<int32_t> token_ids = tokenizer_->EncodeIds(text);
     if (config_.model.debug) {
@@ -666,114 +752,17 @@ class OfflineTtsPocketImpl : public OfflineTtsImpl {
   std::vector<std::unique_ptr<kaldifst::TextNormalizer>> tn_list_;
   std::unique_ptr<SentencePieceTokenizer> tokenizer_;
 
-  // Shared Thread-Safe LRU Cache for Voice Embeddings
-  struct VoiceEmbeddingCache {
-    using Embedding = std::pair<std::vector<float>, std::vector<int64_t>>;
-    using EmbeddingPtr = std::shared_ptr<Embedding>;
-
-   private:
-    using ListNode = std::pair<size_t, EmbeddingPtr>;
-    using ListIt = std::list<ListNode>::iterator;
-
-    mutable std::mutex mutex_;
-    size_t capacity_;
+  // (data, shape) of a voice embedding
+  using Embedding = std::pair<std::vector<float>, std::vector<int64_t>>;
 
-    // Front = most recently used
-    std::list<ListNode> lru_list_;
+  static constexpr size_t kDefaultVoiceEmbeddingCacheCapacity = 50;
 
-    // Key -> iterator into lru_list_
-    std::unordered_map<size_t, ListIt> map_;
-
-   public:
-    static constexpr size_t kDefaultCapacity = 50;
-
-    explicit VoiceEmbeddingCache(size_t cap = kDefaultCapacity)
-        : capacity_(cap) {}
-
-    EmbeddingPtr Get(size_t key) {
-      std::lock_guard<std::mutex> lock(mutex_);
-
-      auto it = map_.find(key);
-      if (it == map_.end()) {
-        return nullptr;  // cache miss
-      }
-
-      // Move to front (most recently used)
-      if (it->second != lru_list_.begin()) {
-        lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
-      }
-
-      return it->second->second;  // copy shared_ptr
-    }
-
-    void Put(size_t key, std::vector<float> data, std::vector<int64_t> shape) {
-      std::lock_guard<std::mutex> lock(mutex_);
-
-      if (capacity_ == 0) {
-        return;
-      }
-
-      auto it = map_.find(key);
-
-      // If exists, update and move to front
-      if (it != map_.end()) {
-        it->second->second =
-            std::make_shared<Embedding>(std::move(data), std::move(shape));
-
-        if (it->second != lru_list_.begin()) {
-          lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
-        }
-        return;
-      }
-
-      // Evict if full
-      if (lru_list_.size() >= capacity_) {
-        auto &last = lru_list_.back();
-        size_t last_key = last.first;
-
-        map_.erase(last_key);
-        lru_list_.pop_back();  // shared_ptr released here
-      }
-
-      // Insert new at front
-      lru_list_.emplace_front(
-          key, std::make_shared<Embedding>(std::move(data), std::move(shape)));
-
-      map_[key] = lru_list_.begin();
-    }
-
-    void SetCapacity(int32_t cap) {
-      if (cap < 0) {
-        SHERPA_ONNX_LOGE(
-            "voice_embedding_cache_capacity must be >= 0. Given: %d", cap);
-        SHERPA_ONNX_EXIT(-1);
-      }
-
-      std::lock_guard<std::mutex> lock(mutex_);
-      capacity_ = cap;
-
-      while (lru_list_.size() > capacity_) {
-        auto &last = lru_list_.back();
-        size_t last_key = last.first;
-
-        map_.erase(last_key);
-        lru_list_.pop_back();
-      }
-    }
-
-    size_t Size() const {
-      std::lock_guard<std::mutex> lock(mutex_);
-      return lru_list_.size();
-    }
-
-    void Clear() {
-      std::lock_guard<std::mutex> lock(mutex_);
-      map_.clear();
-      lru_list_.clear();
-    }
-  };
+  // Identifies the encoder in the names of the on-disk cache files
+  size_t encoder_id_ = 0;
 
-  mutable VoiceEmbeddingCache cache_;
+  // Shared by all calls. Key is the hash of the reference audio
+  mutable LruCache<size_t, std::shared_ptr<const Embedding>> cache_{
+      kDefaultVoiceEmbeddingCacheCapacity};
 };
 
 }  // namespace sherpa_onnx
@@ -27,6 +27,10 @@ void OfflineTtsPocketModelConfig::Register(ParseOptions *po) {
                &voice_embedding_cache_capacity,
                "Capacity of the voice embedding cache (number of items). "
                "Default: 50. 0 disables caching.");
+  po->Register("pocket-voice-embedding-cache-dir", &voice_embedding_cache_dir,
+               "If not empty, voice embeddings are also cached in this "
+               "existing directory so that they persist across runs. "
+               "Use a separate directory for each model.");
 }
 
 bool OfflineTtsPocketModelConfig::Validate() const {
@@ -125,7 +129,8 @@ std::string OfflineTtsPocketModelConfig::ToString() const {
   os << "vocab_json=\"" << vocab_json << "\", ";
   os << "token_scores_json=\"" << token_scores_json << "\", ";
   os << "voice_embedding_cache_capacity=" << voice_embedding_cache_capacity
-     << ")";
+     << ", ";
+  os << "voice_embedding_cache_dir=\"" << voice_embedding_cache_dir << "\")";
 
   return os.str();
 }
@@ -24,6 +24,11 @@ struct OfflineTtsPocketModelConfig {
   OfflineTtsPocketModelConfig() = default;
   int32_t voice_embedding_cache_capacity = 50;
 
+  // If not empty, voice embeddings are also saved to this existing
+  // directory and loaded from it when they are not in the in-memory cache.
+  // Use a separate directory for each model.
+  std::string voice_embedding_cache_dir;
+
   OfflineTtsPocketModelConfig(const std::string &lm_flow,
                               const std::string &lm_main,
                               const std::string &encoder,
@@ -31,7 +36,8 @@ struct OfflineTtsPocketModelConfig {
                               const std::string &text_conditioner,
                               const std::string &vocab_json,
                               const std::string &token_scores_json,
-                              int32_t voice_embedding_cache_capacity = 50)
+                              int32_t voice_embedding_cache_capacity = 50,
+                              const std::string &voice_embedding_cache_dir = {})
       : lm_flow(lm_flow),
         lm_main(lm_main),
         encoder(encoder),
@@ -39,7 +45,8 @@ struct OfflineTtsPocketModelConfig {
         text_conditioner(text_conditioner),
         vocab_json(vocab_json),
         token_scores_json(token_scores_json),
-        voice_embedding_cache_capacity(voice_embedding_cache_capacity) {}
+        voice_embedding_cache_capacity(voice_embedding_cache_capacity),
+        voice_embedding_cache_dir(voice_embedding_cache_dir) {}
 
   void Register(ParseOptions *po);
   bool Validate() const;
@@ -0,0 +1,139 @@
+// sherpa-onnx/csrc/offline-tts-pocket-voice-cache-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/offline-tts-pocket-voice-cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sherpa-onnx/csrc/file-utils.h"
+
+namespace sherpa_onnx {
+
+static std::vector<float> MakeData(int32_t n) {
+  std::vector<float> data(n);
+  for (int32_t i = 0; i != n; ++i) {
+    data[i] = 0.25f * i - 3;
+  }
+  return data;
+}
+
+TEST(PocketVoiceCache, RoundTrip) {
+  std::string filename = "./pocket-voice-cache-test.bin";
+
+  std::vector<int64_t> shape = {1, 3, 5};
+  std::vector<float> data = MakeData(15);
+  ASSERT_TRUE(WritePocketVoiceEmbedding(filename, data.data(), shape));
+
+  std::vector<float> data2;
+  std::vector<int64_t> shape2;
+  ASSERT_TRUE(ReadPocketVoiceEmbedding(filename, &data2, &shape2));
+  EXPECT_EQ(shape2, shape);
+  EXPECT_EQ(data2, data);
+
+  // Overwrite an existing file
+  shape = {2, 4};
+  data = MakeData(8);
+  ASSERT_TRUE(WritePocketVoiceEmbedding(filename, data.data(), shape));
+  ASSERT_TRUE(ReadPocketVoiceEmbedding(filename, &data2, &shape2));
+  EXPECT_EQ(shape2, shape);
+  EXPECT_EQ(data2, data);
+
+  std::remove(filename.c_str());
+}
+
+TEST(PocketVoiceCache, InvalidFile) {
+  std::string filename = "./pocket-voice-cache-invalid-test.bin";
+
+  std::vector<float> data;
+  std::vector<int64_t> shape;
+  EXPECT_FALSE(ReadPocketVoiceEmbedding(filename, &data, &shape));
+
+  std::vector<int64_t> expected_shape = {1, 2, 3};
+  std::vector<float> expected_data = MakeData(6);
+  ASSERT_TRUE(WritePocketVoiceEmbedding(filename, expected_data.data(),
+                                        expected_shape));
+
+  // Truncated
+  std::vector<char> buf = ReadFile(filename);
+  {
+    std::ofstream os(filename, std::ios::binary);
+    os.write(buf.data(), buf.size() - 1);
+  }
+  EXPECT_FALSE(ReadPocketVoiceEmbedding(filename, &data, &shape));
+
+  // Invalid ndim
+  int64_t ndim = 100;
+  {
+    std::ofstream os(filename, std::ios::binary);
+    os.write(reinterpret_cast<const char *>(&ndim), sizeof(ndim));
+    os.write(buf.data() + sizeof(ndim), buf.size() - sizeof(ndim));
+  }
+  EXPECT_FALSE(ReadPocketVoiceEmbedding(filename, &data, &shape));
+
+  std::remove(filename.c_str());
+}
+
+TEST(PocketVoiceCache, ConcurrentWriters) {
+  std::string filename = "./pocket-voice-cache-concurrent-test.bin";
+
+  std::vector<int64_t> shape = {1, 1000};
+  std::vector<float> data = MakeData(1000);
+
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i != 8; ++i) {
+    threads.emplace_back([&]() {
+      for (int32_t k = 0; k != 10; ++k) {
+        EXPECT_TRUE(WritePocketVoiceEmbedding(filename, data.data(), shape));
+
+        std::vector<float> data2;
+        std::vector<int64_t> shape2;
+        EXPECT_TRUE(ReadPocketVoiceEmbedding(filename, &data2, &shape2));
+        EXPECT_EQ(data2, data);
+      }
+    });
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  std::remove(filename.c_str());
+}
+
+TEST(PocketVoiceCache, Filename) {
+  EXPECT_TRUE(PocketVoiceEmbeddingFilename("", 1, 2).empty());
+
+  std::string f = PocketVoiceEmbeddingFilename("/tmp", 0x12, 0xab);
+  EXPECT_EQ(f, "/tmp/pocket-voice-0000000000000012-00000000000000ab.bin");
+
+  // The same audio with a different encoder uses a different file
+  size_t a = PocketVoiceEncoderId("./encoder-a.onnx");
+  size_t b = PocketVoiceEncoderId("./encoder-b.onnx");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, PocketVoiceEncoderId("./encoder-a.onnx"));
+  EXPECT_NE(PocketVoiceEmbeddingFilename("/tmp", a, 1),
+            PocketVoiceEmbeddingFilename("/tmp", b, 1));
+
+  // An updated model with a different size gets a different ID
+  std::string encoder = "./pocket-voice-cache-encoder-test.onnx";
+  {
+    std::ofstream os(encoder, std::ios::binary);
+    os << "abc";
+  }
+  size_t c = PocketVoiceEncoderId(encoder);
+  {
+    std::ofstream os(encoder, std::ios::binary);
+    os << "abcd";
+  }
+  EXPECT_NE(c, PocketVoiceEncoderId(encoder));
+
+  std::remove(encoder.c_str());
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,135 @@
+// sherpa-onnx/csrc/offline-tts-pocket-voice-cache.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/offline-tts-pocket-voice-cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <ios>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "sherpa-onnx/csrc/file-utils.h"
+#include "sherpa-onnx/csrc/macros.h"
+
+namespace sherpa_onnx {
+
+size_t PocketVoiceEncoderId(const std::string &encoder) {
+  int64_t size = -1;
+  if (FileExists(encoder)) {
+    std::ifstream is = OpenInputFile(encoder, std::ios::binary | std::ios::ate);
+    size = is ? static_cast<int64_t>(is.tellg()) : -1;
+  }
+
+  return std::hash<std::string>{}(encoder + ":" + std::to_string(size));
+}
+
+std::string PocketVoiceEmbeddingFilename(const std::string &dir,
+                                         size_t encoder_id,
+                                         size_t audio_hash) {
+  if (dir.empty()) {
+    return {};
+  }
+
+  std::ostringstream os;
+  os << dir << "/pocket-voice-" << std::hex << std::setfill('0')
+     << std::setw(16) << encoder_id << "-" << std::setw(16) << audio_hash
+     << ".bin";
+  return os.str();
+}
+
+bool ReadPocketVoiceEmbedding(const std::string &filename,
+                              std::vector<float> *data,
+                              std::vector<int64_t> *shape) {
+  if (!FileExists(filename)) {
+    return false;
+  }
+
+  std::vector<char> buf = ReadFile(filename);
+
+  int64_t ndim = 0;
+  if (buf.size() < sizeof(ndim)) {
+    SHERPA_ONNX_LOGE("Invalid voice embedding file '%s'", filename.c_str());
+    return false;
+  }
+  std::memcpy(&ndim, buf.data(), sizeof(ndim));
+
+  if (ndim <= 0 || ndim > 4 ||
+      buf.size() < sizeof(int64_t) * (1 + ndim)) {
+    SHERPA_ONNX_LOGE("Invalid voice embedding file '%s'", filename.c_str());
+    return false;
+  }
+  size_t header_size = sizeof(int64_t) * (1 + ndim);
+
+  shape->resize(ndim);
+  std::memcpy(shape->data(), buf.data() + sizeof(int64_t),
+              sizeof(int64_t) * ndim);
+
+  int64_t n = 1;
+  for (auto d : *shape) {
+    if (d <= 0) {
+      n = -1;
+      break;
+    }
+    n *= d;
+  }
+
+  if (n < 0 || buf.size() != header_size + n * sizeof(float)) {
+    SHERPA_ONNX_LOGE("Invalid voice embedding file '%s'", filename.c_str());
+    return false;
+  }
+
+  data->resize(n);
+  std::memcpy(data->data(), buf.data() + header_size, n * sizeof(float));
+
+  return true;
+}
+
+bool WritePocketVoiceEmbedding(const std::string &filename, const float *data,
+                               const std::vector<int64_t> &shape) {
+  int64_t ndim = shape.size();
+  int64_t n = 1;
+  for (auto d : shape) {
+    n *= d;
+  }
+
+  // The suffix is unique across threads and processes, so writers never
+  // share a temporary file
+  std::random_device rd;
+  std::ostringstream os;
+  os << filename << "." << std::hex << rd() << rd() << "."
+     << std::this_thread::get_id() << ".tmp";
+  std::string tmp = os.str();
+
+  {
+    std::ofstream ofs = OpenOutputFile(tmp, std::ios::binary);
+    ofs.write(reinterpret_cast<const char *>(&ndim), sizeof(ndim));
+    ofs.write(reinterpret_cast<const char *>(shape.data()),
+              sizeof(int64_t) * ndim);
+    ofs.write(reinterpret_cast<const char *>(data), sizeof(float) * n);
+
+    if (!ofs) {
+      SHERPA_ONNX_LOGE("Failed to write voice embedding to '%s'", tmp.c_str());
+      ofs.close();
+      std::remove(tmp.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+    // It can fail on Windows if another process has just saved it
+    std::remove(tmp.c_str());
+    return FileExists(filename);
+  }
+
+  return true;
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,61 @@
+// sherpa-onnx/csrc/offline-tts-pocket-voice-cache.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#ifndef SHERPA_ONNX_CSRC_OFFLINE_TTS_POCKET_VOICE_CACHE_H_
+#define SHERPA_ONNX_CSRC_OFFLINE_TTS_POCKET_VOICE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sherpa_onnx {
+
+// On-disk cache of Pocket TTS voice embeddings, shared by processes
+// using the same directory.
+
+/** Return a value identifying the encoder model, which computes voice
+ * embeddings. It depends on the filename and the size of the model, so
+ * that embeddings from a different or an updated model are not reused.
+ */
+size_t PocketVoiceEncoderId(const std::string &encoder);
+
+/** Return the name of the file caching the voice embedding of the given
+ * reference audio. Return an empty string if dir is empty.
+ *
+ * @param dir  Directory of the on-disk cache.
+ * @param encoder_id  Return value of PocketVoiceEncoderId().
+ * @param audio_hash  Hash of the reference audio.
+ */
+std::string PocketVoiceEmbeddingFilename(const std::string &dir,
+                                         size_t encoder_id, size_t audio_hash);
+
+/* The file format is
+ *
+ *  - int64_t ndim
+ *  - int64_t shape[ndim]
+ *  - float data[product of shape]
+ *
+ * in the native byte order.
+ */
+
+/** Read a voice embedding saved by WritePocketVoiceEmbedding().
+ *
+ * @return Return false if the file does not exist or is invalid.
+ */
+bool ReadPocketVoiceEmbedding(const std::string &filename,
+                              std::vector<float> *data,
+                              std::vector<int64_t> *shape);
+
+/** Save a voice embedding. It is written to a temporary file in the same
+ * directory first and then renamed, so that other processes never see a
+ * partially written file.
+ *
+ * @return Return false if it cannot be saved.
+ */
+bool WritePocketVoiceEmbedding(const std::string &filename, const float *data,
+                               const std::vector<int64_t> &shape);
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_OFFLINE_TTS_POCKET_VOICE_CACHE_H_
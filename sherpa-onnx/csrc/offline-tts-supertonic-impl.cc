@@ -278,47 +278,82 @@ GeneratedAudio OfflineTtsSupertonicImpl::Generate(
                                      silence_duration, seed, callback);
 }
 
-GeneratedAudio OfflineTtsSupertonicImpl::Process(
-    const std::string &text, const std::string &lang, int64_t sid,
-    int32_t num_steps, float speed, NormalDataGenerator &gen) const {
+std::vector<std::vector<float>> OfflineTtsSupertonicImpl::Process(
+    const std::vector<std::string> &texts, const std::string &lang,
+    int64_t sid, int32_t num_steps, float speed,
+    NormalDataGenerator &gen) const {
   const auto &cfg = model_->GetConfig();
   StyleSliceView slice = GetStyleSliceForSid(sid);
-  const int32_t bsz = 1;
 
-  std::vector<int64_t> text_ids;
-  std::vector<float> text_mask_flat;
-  std::vector<int64_t> text_mask_shape;
-  text_processor_->Process(text, lang, &text_ids, &text_mask_flat,
-                           &text_mask_shape);
-  if (text_ids.empty() || text_mask_flat.empty()) {
-    SHERPA_ONNX_LOGE(
-        "Text processing failed: empty text_ids or text_mask. Text: \"%s\"",
-        text.c_str());
-    return {};
+  std::vector<std::vector<float>> ans(texts.size());
+
+  // Texts that cannot be processed are left out of the batch
+  std::vector<int32_t> indexes;
+  std::vector<std::vector<int64_t>> text_ids_list;
+  std::vector<int64_t> text_lengths;
+  for (int32_t i = 0; i != static_cast<int32_t>(texts.size()); ++i) {
+    std::vector<int64_t> ids;
+    std::vector<float> mask_flat;
+    std::vector<int64_t> mask_shape;
+    text_processor_->Process(texts[i], lang, &ids, &mask_flat, &mask_shape);
+    if (ids.empty()) {
+      SHERPA_ONNX_LOGE(
+          "Text processing failed: empty text_ids. Text: \"%s\"",
+          texts[i].c_str());
+      continue;
+    }
+
+    indexes.push_back(i);
+    text_lengths.push_back(static_cast<int64_t>(ids.size()));
+    text_ids_list.push_back(std::move(ids));
   }
-  if (text_mask_shape.size() != 3) {
-    SHERPA_ONNX_LOGE(
-        "Invalid text_mask_shape size: %zu (expected 3). Text: \"%s\"",
-        text_mask_shape.size(), text.c_str());
-    return {};
+
+  const int32_t bsz = static_cast<int32_t>(indexes.size());
+  if (bsz == 0) {
+    return ans;
   }
-  int64_t text_seq_len = static_cast<int64_t>(text_ids.size());
-  int64_t text_mask_len = text_mask_shape[2];
-  if (text_seq_len != text_mask_len) {
-    SHERPA_ONNX_LOGE("Text sequence length mismatch: text_ids=%" PRId64
-                     ", text_mask=%" PRId64 ". Text: \"%s\"",
-                     text_seq_len, text_mask_len, text.c_str());
-    return {};
+
+  // Texts are padded to the longest one. Padded positions are masked out
+  // by text_mask, and padded latent frames by latent_mask, so all texts
+  // go through each model in a single session call.
+  int64_t text_seq_len =
+      *std::max_element(text_lengths.begin(), text_lengths.end());
+
+  std::vector<int64_t> text_ids(static_cast<size_t>(bsz) * text_seq_len, 0);
+  for (int32_t b = 0; b < bsz; ++b) {
+    std::copy(text_ids_list[b].begin(), text_ids_list[b].end(),
+              text_ids.data() + b * text_seq_len);
   }
+  std::vector<int64_t> text_ids_shape = {bsz, text_seq_len};
+
+  std::vector<float> text_mask_flat;
+  std::vector<int64_t> text_mask_shape;
+  LengthsToMask(text_lengths, &text_mask_flat, &text_mask_shape);
+
+  // All texts in the batch use the style of the same speaker
+  auto repeat = [bsz](const float *p, size_t n) {
+    std::vector<float> ans;
+    ans.reserve(n * bsz);
+    for (int32_t b = 0; b < bsz; ++b) {
+      ans.insert(ans.end(), p, p + n);
+    }
+    return ans;
+  };
 
-  std::vector<int64_t> text_ids_shape = {1, text_seq_len};
+  std::vector<float> style_dp = repeat(slice.dp_data, slice.dp_size);
+  std::array<int64_t, 3> style_dp_shape = {bsz, slice.dp_shape[1],
+                                           slice.dp_shape[2]};
+
+  std::vector<float> style_ttl = repeat(slice.ttl_data, slice.ttl_size);
+  std::array<int64_t, 3> style_ttl_shape = {bsz, slice.ttl_shape[1],
+                                            slice.ttl_shape[2]};
 
   Ort::Value text_ids_tensor = Ort::Value::CreateTensor<int64_t>(
       memory_info_, text_ids.data(), text_ids.size(), text_ids_shape.data(),
       text_ids_shape.size());
   Ort::Value style_dp_tensor = Ort::Value::CreateTensor<float>(
-      memory_info_, const_cast<float *>(slice.dp_data), slice.dp_size,
-      slice.dp_shape.data(), slice.dp_shape.size());
+      memory_info_, style_dp.data(), style_dp.size(), style_dp_shape.data(),
+      style_dp_shape.size());
   Ort::Value text_mask_tensor = Ort::Value::CreateTensor<float>(
       memory_info_, text_mask_flat.data(), text_mask_flat.size(),
       text_mask_shape.data(), text_mask_shape.size());
@@ -327,15 +362,14 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
       std::move(text_mask_tensor));
   auto dp_output_info = dp_output.GetTensorTypeAndShapeInfo();
   size_t dp_element_count = dp_output_info.GetElementCount();
-  if (dp_element_count != 1) {
+  if (dp_element_count != static_cast<size_t>(bsz)) {
     SHERPA_ONNX_LOGE(
-        "Duration predictor output size mismatch: expected 1, got %zu. Text: "
-        "\"%s\"",
-        dp_element_count, text.c_str());
-    return {};
+        "Duration predictor output size mismatch: expected %d, got %zu", bsz,
+        dp_element_count);
+    return ans;
   }
   auto *dur_data = dp_output.GetTensorMutableData<float>();
-  std::vector<float> duration(dur_data, dur_data + 1);
+  std::vector<float> duration(dur_data, dur_data + bsz);
   if (speed != 1.0f) {
     for (auto &dur : duration) {
       dur /= speed;
@@ -349,18 +383,17 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
       Ort::Value::CreateTensor<int64_t>(memory_info_, text_ids.data(),
                                         text_ids.size(), text_ids_shape.data(),
                                         text_ids_shape.size()),
-      Ort::Value::CreateTensor<float>(
-          memory_info_, const_cast<float *>(slice.ttl_data), slice.ttl_size,
-          slice.ttl_shape.data(), slice.ttl_shape.size()),
+      Ort::Value::CreateTensor<float>(memory_info_, style_ttl.data(),
+                                      style_ttl.size(), style_ttl_shape.data(),
+                                      style_ttl_shape.size()),
       Ort::Value::CreateTensor<float>(
           memory_info_, text_mask_flat.data(), text_mask_flat.size(),
           text_mask_shape.data(), text_mask_shape.size()));
   auto text_emb_info = text_enc_output.GetTensorTypeAndShapeInfo();
   size_t text_emb_size = text_emb_info.GetElementCount();
   if (text_emb_size == 0) {
-    SHERPA_ONNX_LOGE("Text encoder output is empty. Text: \"%s\"",
-                     text.c_str());
-    return {};
+    SHERPA_ONNX_LOGE("Text encoder output is empty. Batch size: %d", bsz);
+    return ans;
   }
   auto *text_emb_data = text_enc_output.GetTensorMutableData<float>();
   auto text_emb_shape = text_emb_info.GetShape();
@@ -384,6 +417,10 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
         "Latent length (%d) exceeds maximum (%d), capping to prevent OOM",
         latent_len, kMaxLatentLen);
     latent_len = kMaxLatentLen;
+    for (auto &len : wav_lengths) {
+      len = std::min<int64_t>(len, static_cast<int64_t>(latent_len) *
+                                       chunk_size);
+    }
   }
 
   int32_t latent_dim = cfg.ttl.latent_dim * cfg.ttl.chunk_compress_factor;
@@ -394,10 +431,9 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
           static_cast<size_t>(latent_dim) !=
       static_cast<size_t>(latent_len)) {
     SHERPA_ONNX_LOGE(
-        "Latent total size overflow: bsz=%d, latent_dim=%d, latent_len=%d. "
-        "Text: \"%s\"",
-        bsz, latent_dim, latent_len, text.c_str());
-    return {};
+        "Latent total size overflow: bsz=%d, latent_dim=%d, latent_len=%d",
+        bsz, latent_dim, latent_len);
+    return ans;
   }
 
   std::vector<float> xt_flat(latent_total_size);
@@ -411,10 +447,9 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
                     &latent_mask_shape);
   int64_t latent_mask_len = latent_mask_shape[2];
   if (latent_mask_len != latent_len) {
-    SHERPA_ONNX_LOGE("Latent mask length mismatch: expected %d, got %" PRId64
-                     ". Text: \"%s\"",
-                     latent_len, latent_mask_len, text.c_str());
-    return {};
+    SHERPA_ONNX_LOGE("Latent mask length mismatch: expected %d, got %" PRId64,
+                     latent_len, latent_mask_len);
+    return ans;
   }
   for (int32_t b = 0; b < bsz; ++b) {
     const float *mask_batch = latent_mask_flat.data() + b * latent_mask_len;
@@ -429,6 +464,7 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
 
   std::vector<int64_t> latent_shape = {bsz, latent_dim, latent_len};
   std::vector<float> total_step_vec(bsz, static_cast<float>(num_steps));
+  std::vector<float> current_step_vec(bsz);
   std::array<int64_t, 1> step_shape = {bsz};
 
   // Constant inputs: create once outside loop, keep text_enc_output alive.
@@ -436,8 +472,8 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
       memory_info_, text_emb_data, text_emb_size, text_emb_shape.data(),
       text_emb_shape.size());
   Ort::Value style_ttl_const = Ort::Value::CreateTensor<float>(
-      memory_info_, const_cast<float *>(slice.ttl_data), slice.ttl_size,
-      slice.ttl_shape.data(), slice.ttl_shape.size());
+      memory_info_, style_ttl.data(), style_ttl.size(), style_ttl_shape.data(),
+      style_ttl_shape.size());
   Ort::Value text_mask_const = Ort::Value::CreateTensor<float>(
       memory_info_, text_mask_flat.data(), text_mask_flat.size(),
       text_mask_shape.data(), text_mask_shape.size());
@@ -448,14 +484,16 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
       memory_info_, total_step_vec.data(), total_step_vec.size(),
       step_shape.data(), step_shape.size());
 
-  float current_step = 0.f;
+  // Each step is a single session call for the whole batch
   for (int32_t step = 0; step < num_steps; step++) {
-    current_step = static_cast<float>(step);
+    std::fill(current_step_vec.begin(), current_step_vec.end(),
+              static_cast<float>(step));
     Ort::Value noisy_latent_tensor = Ort::Value::CreateTensor<float>(
         memory_info_, xt_flat.data(), xt_flat.size(), latent_shape.data(),
         latent_shape.size());
     Ort::Value current_step_tensor = Ort::Value::CreateTensor<float>(
-        memory_info_, &current_step, 1, step_shape.data(), step_shape.size());
+        memory_info_, current_step_vec.data(), current_step_vec.size(),
+        step_shape.data(), step_shape.size());
 
     Ort::Value vector_est_output = model_->RunVectorEstimator(
         std::move(noisy_latent_tensor), std::move(current_step_tensor),
@@ -465,10 +503,9 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
     size_t denoised_size = vector_est_output_info.GetElementCount();
     if (denoised_size != latent_total_size) {
       SHERPA_ONNX_LOGE(
-          "Denoised latent size mismatch at step %d: expected %zu, got %zu. "
-          "Text: \"%s\"",
-          step, latent_total_size, denoised_size, text.c_str());
-      return {};
+          "Denoised latent size mismatch at step %d: expected %zu, got %zu",
+          step, latent_total_size, denoised_size);
+      return ans;
     }
     auto *denoised_data = vector_est_output.GetTensorMutableData<float>();
     std::memcpy(xt_flat.data(), denoised_data,
@@ -483,8 +520,8 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
   auto wav_shape = wav_info.GetShape();
   size_t wav_size = wav_info.GetElementCount();
   if (wav_size == 0) {
-    SHERPA_ONNX_LOGE("Vocoder output is empty. Text: \"%s\"", text.c_str());
-    return {};
+    SHERPA_ONNX_LOGE("Vocoder output is empty. Batch size: %d", bsz);
+    return ans;
   }
 
   auto *wav_data = vocoder_output.GetTensorMutableData<float>();
@@ -499,25 +536,30 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
     SHERPA_ONNX_LOGE("%s", os.str().c_str());
   }
 
-  GeneratedAudio result;
   if ((wav_shape.size() == 2 && wav_shape[0] == bsz) ||
       (wav_shape.size() == 3 && wav_shape[0] == bsz && wav_shape[1] == 1)) {
     int64_t samples_per_batch =
         (wav_shape.size() == 2) ? wav_shape[1] : wav_shape[2];
-    result.samples.reserve(static_cast<size_t>(std::accumulate(
-        wav_lengths.begin(), wav_lengths.end(), static_cast<int64_t>(0))));
     for (int32_t b = 0; b < bsz; ++b) {
       int64_t actual_len = wav_lengths[b];
       if (actual_len > samples_per_batch) {
         actual_len = samples_per_batch;
       }
       const float *batch_wav = wav_data + b * samples_per_batch;
-      result.samples.insert(result.samples.end(), batch_wav,
-                            batch_wav + actual_len);
+      ans[indexes[b]].assign(batch_wav, batch_wav + actual_len);
     }
-  } else if (wav_shape.size() == 1 ||
-             (wav_shape.size() == 2 && wav_shape[0] == 1)) {
-    result.samples.assign(wav_data, wav_data + wav_size);
+  } else if (bsz == 1) {
+    if (wav_shape.size() != 1) {
+      std::ostringstream os;
+      os << "Unexpected vocoder output shape: [";
+      for (size_t i = 0; i < wav_shape.size(); ++i) {
+        if (i > 0) os << ", ";
+        os << wav_shape[i];
+      }
+      os << "], bsz=" << bsz << ", using all samples";
+      SHERPA_ONNX_LOGE("%s", os.str().c_str());
+    }
+    ans[indexes[0]].assign(wav_data, wav_data + wav_size);
   } else {
     std::ostringstream os;
     os << "Unexpected vocoder output shape: [";
@@ -525,23 +567,31 @@ GeneratedAudio OfflineTtsSupertonicImpl::Process(
       if (i > 0) os << ", ";
       os << wav_shape[i];
     }
-    os << "], bsz=" << bsz << ", using all samples";
+    os << "], bsz=" << bsz;
     SHERPA_ONNX_LOGE("%s", os.str().c_str());
-    result.samples.assign(wav_data, wav_data + wav_size);
-  }
-  if (config_.model.debug && !result.samples.empty()) {
-    float max_abs = 0.f;
-    float min_abs = std::abs(result.samples[0]);
-    for (float x : result.samples) {
-      float ax = std::abs(x);
-      max_abs = std::max(max_abs, ax);
-      min_abs = std::min(min_abs, ax);
+    return ans;
+  }
+
+  if (config_.model.debug) {
+    for (int32_t b = 0; b < bsz; ++b) {
+      const auto &samples = ans[indexes[b]];
+      if (samples.empty()) {
+        continue;
+      }
+
+      float max_abs = 0.f;
+      float min_abs = std::abs(samples[0]);
+      for (float x : samples) {
+        float ax = std::abs(x);
+        max_abs = std::max(max_abs, ax);
+        min_abs = std::min(min_abs, ax);
+      }
+      SHERPA_ONNX_LOGE("Audio samples: %zu, min_abs=%.6f, max_abs=%.6f",
+                       samples.size(), min_abs, max_abs);
     }
-    SHERPA_ONNX_LOGE("Audio samples: %zu, min_abs=%.6f, max_abs=%.6f",
-                     result.samples.size(), min_abs, max_abs);
   }
-  result.sample_rate = cfg.ae.sample_rate;
-  return result;
+
+  return ans;
 }
 
 GeneratedAudio OfflineTtsSupertonicImpl::ProcessChunksAndConcatenate(
@@ -553,19 +603,31 @@ GeneratedAudio OfflineTtsSupertonicImpl::ProcessChunksAndConcatenate(
   std::vector<std::vector<float>> chunk_samples;
   chunk_samples.reserve(text_chunks.size());
   int32_t num_chunks = static_cast<int32_t>(text_chunks.size());
-  for (int32_t i = 0; i < num_chunks; ++i) {
-    auto chunk_result =
-        Process(text_chunks[i], lang, sid, num_steps, speed, gen);
-    if (chunk_result.samples.empty()) {
-      continue;
-    }
-    if (callback) {
-      float progress =
-          static_cast<float>(i + 1) / static_cast<float>(num_chunks);
-      callback(chunk_result.samples.data(), chunk_result.samples.size(),
-               progress);
+
+  // Chunks in a batch share each session call of the flow-matching steps
+  int32_t batch_size = config_.max_num_sentences > 0
+                           ? config_.max_num_sentences
+                           : std::max(num_chunks, 1);
+
+  for (int32_t start = 0; start < num_chunks; start += batch_size) {
+    int32_t end = std::min(start + batch_size, num_chunks);
+    std::vector<std::string> batch(text_chunks.begin() + start,
+                                   text_chunks.begin() + end);
+
+    auto batch_samples = Process(batch, lang, sid, num_steps, speed, gen);
+
+    for (int32_t i = start; i < end; ++i) {
+      auto &samples = batch_samples[i - start];
+      if (samples.empty()) {
+        continue;
+      }
+      if (callback) {
+        float progress =
+            static_cast<float>(i + 1) / static_cast<float>(num_chunks);
+        callback(samples.data(), samples.size(), progress);
+      }
+      chunk_samples.push_back(std::move(samples));
     }
-    chunk_samples.push_back(std::move(chunk_result.samples));
   }
 
   if (chunk_samples.empty()) {
@@ -44,9 +44,12 @@ class OfflineTtsSupertonicImpl : public OfflineTtsImpl {
       GeneratedAudioCallback callback = nullptr) const override;
 
  private:
-  GeneratedAudio Process(const std::string &text, const std::string &lang,
-                         int64_t sid, int32_t num_steps, float speed,
-                         NormalDataGenerator &gen) const;
+  // Generate audio for all texts in a batch. The i-th entry of the
+  // returned vector is empty if texts[i] cannot be processed.
+  std::vector<std::vector<float>> Process(const std::vector<std::string> &texts,
+                                          const std::string &lang, int64_t sid,
+                                          int32_t num_steps, float speed,
+                                          NormalDataGenerator &gen) const;
 
   GeneratedAudio ProcessChunksAndConcatenate(
       const std::vector<std::string> &text_chunks, const std::string &lang,
@@ -0,0 +1,164 @@
+// sherpa-onnx/csrc/offline-tts-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/offline-tts.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sherpa-onnx/csrc/offline-tts-impl.h"
+
+namespace sherpa_onnx {
+
+static GeneratedAudio MakeAudio() {
+  GeneratedAudio audio;
+  audio.sample_rate = 100;  // silence longer than 20 samples is a pause
+
+  audio.samples.insert(audio.samples.end(), 10, 0.5f);
+  audio.samples.insert(audio.samples.end(), 40, 0.001f);  // a pause
+  audio.samples.insert(audio.samples.end(), 10, 0.5f);
+  audio.samples.insert(audio.samples.end(), 5, 0.001f);  // not a pause
+  audio.samples.insert(audio.samples.end(), 10, 0.5f);
+  audio.samples.insert(audio.samples.end(), 30, 0.001f);  // a pause
+
+  return audio;
+}
+
+TEST(GeneratedAudio, ScaleSilence) {
+  GeneratedAudio audio = MakeAudio();
+
+  GeneratedAudio ans = audio.ScaleSilence(0.5);
+  EXPECT_EQ(ans.samples.size(), 10 + 20 + 10 + 5 + 10 + 15);
+
+  ans = audio.ScaleSilence(2);
+  EXPECT_EQ(ans.samples.size(), 10 + 80 + 10 + 5 + 10 + 60);
+
+  // out of range
+  ans = audio.ScaleSilence(100);
+  EXPECT_EQ(ans.samples, audio.samples);
+}
+
+TEST(SilenceScaler, SameAsScaleSilence) {
+  GeneratedAudio audio = MakeAudio();
+
+  int32_t num_samples = static_cast<int32_t>(audio.samples.size());
+
+  for (float scale : {0.2f, 0.5f, 1.0f, 2.0f}) {
+    auto expected = audio.ScaleSilence(scale).samples;
+
+    for (int32_t chunk_size : {1, 7, 25, 200}) {
+      SilenceScaler scaler(audio.sample_rate, scale);
+
+      std::vector<float> samples;
+      for (int32_t start = 0; start < num_samples; start += chunk_size) {
+        int32_t n = std::min(chunk_size, num_samples - start);
+        auto out = scaler.Accept(audio.samples.data() + start, n);
+        samples.insert(samples.end(), out.begin(), out.end());
+      }
+
+      auto out = scaler.Flush();
+      samples.insert(samples.end(), out.begin(), out.end());
+
+      EXPECT_EQ(samples, expected) << scale << " " << chunk_size;
+    }
+  }
+}
+
+// It returns one sample per byte of the text after a short delay and
+// records how many calls run at the same time
+class StubOfflineTtsImpl : public OfflineTtsImpl {
+ public:
+  explicit StubOfflineTtsImpl(std::atomic<int32_t> *max_running)
+      : max_running_(max_running) {}
+
+  GeneratedAudio Generate(
+      const std::string &text, const GenerationConfig &config,
+      GeneratedAudioCallback callback = nullptr) const override {
+    int32_t n = ++num_running_;
+    int32_t m = max_running_->load();
+    while (n > m && !max_running_->compare_exchange_weak(m, n)) {
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    GeneratedAudio audio;
+    audio.sample_rate = SampleRate();
+    audio.samples.resize(text.size(), config.speed);
+
+    --num_running_;
+    return audio;
+  }
+
+  int32_t SampleRate() const override { return 100; }
+
+ private:
+  mutable std::atomic<int32_t> num_running_{0};
+  std::atomic<int32_t> *max_running_;
+};
+
+TEST(OfflineTts, DestroyWithQueuedRequests) {
+  std::atomic<int32_t> max_running{0};
+
+  std::vector<std::future<GeneratedAudio>> futures;
+  {
+    OfflineTts tts(std::make_unique<StubOfflineTtsImpl>(&max_running), 2);
+
+    for (int32_t i = 0; i != 10; ++i) {
+      GenerationConfig config;
+      config.speed = i;
+      futures.push_back(tts.GenerateAsync(std::string(i + 1, 'a'), config));
+    }
+
+    // tts is destroyed while most of the requests are still queued
+  }
+
+  for (int32_t i = 0; i != 10; ++i) {
+    ASSERT_EQ(futures[i].wait_for(std::chrono::seconds(0)),
+              std::future_status::ready);
+
+    GeneratedAudio audio = futures[i].get();
+    EXPECT_EQ(audio.sample_rate, 100);
+    EXPECT_EQ(audio.samples, std::vector<float>(i + 1, i));
+  }
+
+  EXPECT_LE(max_running.load(), 2);
+}
+
+TEST(OfflineTts, MaxConcurrency) {
+  std::atomic<int32_t> max_running{0};
+  OfflineTts tts(std::make_unique<StubOfflineTtsImpl>(&max_running), 2);
+
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i != 4; ++i) {
+    threads.emplace_back([&tts]() {
+      GeneratedAudio audio = tts.Generate("abc", GenerationConfig{});
+      EXPECT_EQ(audio.samples.size(), 3);
+    });
+  }
+
+  std::vector<std::future<GeneratedAudio>> futures;
+  for (int32_t i = 0; i != 4; ++i) {
+    futures.push_back(tts.GenerateAsync("ab", GenerationConfig{}));
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  for (auto &f : futures) {
+    EXPECT_EQ(f.get().samples.size(), 2);
+  }
+
+  EXPECT_LE(max_running.load(), 2);
+  EXPECT_GE(max_running.load(), 1);
+}
+
+}  // namespace sherpa_onnx
@@ -33,7 +33,7 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
   explicit OfflineTtsZipvoiceImpl(const OfflineTtsConfig &config)
       : config_(config),
         model_(std::make_unique<OfflineTtsZipvoiceModel>(config.model)),
-        vocoder_(Vocoder::Create(config.model)) {
+        vocoder_(Vocoder::CreateShared(config.model)) {
     InitFrontend();
 
     PostInit();
@@ -43,7 +43,7 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
   OfflineTtsZipvoiceImpl(Manager *mgr, const OfflineTtsConfig &config)
       : config_(config),
         model_(std::make_unique<OfflineTtsZipvoiceModel>(mgr, config.model)),
-        vocoder_(Vocoder::Create(mgr, config.model)) {
+        vocoder_(Vocoder::CreateShared(mgr, config.model)) {
     InitFrontend(mgr);
 
     PostInit();
@@ -70,6 +70,12 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
     //     config.model.zipvoice.target_rms)
     //   - "guidance_scale" (float): Classifier-free guidance scale for the
     //     decoder (default: config.model.zipvoice.guidance_scale)
+    //   - "vocoder_chunk_size" (int): If > 0 and a callback is given, the
+    //     vocoder runs over this many mel frames at a time and the callback
+    //     is invoked for each chunk (default: 0, i.e., disabled)
+    //   - "vocoder_chunk_overlap" (int): Number of context mel frames on
+    //     each side of a chunk; the overlapping audio is cross-faded
+    //     (default: 4)
     if (config_.model.debug) {
       SHERPA_ONNX_LOGE("%s", config.ToString().c_str());
     }
@@ -201,6 +207,13 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
 
     const int32_t total = static_cast<int32_t>(sentences.size());
 
+    ChunkedVocoding chunked;
+    if (callback) {
+      chunked.chunk_size = config.GetExtraInt("vocoder_chunk_size", 0);
+      chunked.overlap = config.GetExtraInt("vocoder_chunk_overlap", 4);
+      chunked.callback = callback;
+    }
+
     for (int32_t i = 0; i < total; ++i) {
       if (config_.model.debug) {
 #if __OHOS__
@@ -212,16 +225,26 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
 #endif
       }
 
+      chunked.progress_start = i * 1.0f / total;
+      chunked.progress_end = (i + 1) * 1.0f / total;
+
       GeneratedAudio cur = GenerateChunk(
           sentences[i], prompt_tokens, prompt_features, speed, num_steps,
-          feat_scale, t_shift, guidance_scale);
+          feat_scale, t_shift, guidance_scale, &chunked);
 
-      if (cur.samples.empty()) {
+      result.samples.insert(result.samples.end(), cur.samples.begin(),
+                            cur.samples.end());
+
+      if (chunked.chunk_size > 0) {
+        if (!chunked.should_continue) {
+          break;
+        }
         continue;
       }
 
-      result.samples.insert(result.samples.end(), cur.samples.begin(),
-                            cur.samples.end());
+      if (cur.samples.empty()) {
+        continue;
+      }
 
       if (callback) {
         if (!callback(cur.samples.data(),
@@ -366,7 +389,8 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
                                const std::vector<int64_t> &prompt_tokens,
                                const std::vector<float> &prompt_features,
                                float speed, int32_t num_steps, float feat_scale,
-                               float t_shift, float guidance_scale) const {
+                               float t_shift, float guidance_scale,
+                               ChunkedVocoding *chunked = nullptr) const {
     std::vector<TokenIDs> text_token_ids =
         frontend_->ConvertTextToTokenIds(text);
 
@@ -387,7 +411,7 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
     }
 
     return Process(tokens, prompt_tokens, prompt_features, speed, num_steps,
-                   feat_scale, t_shift, guidance_scale);
+                   feat_scale, t_shift, guidance_scale, chunked);
   }
 
   std::vector<float> ComputePromptFeatures(
@@ -418,7 +442,8 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
                          const std::vector<int64_t> &prompt_tokens,
                          const std::vector<float> &prompt_features, float speed,
                          int32_t num_steps, float feat_scale, float t_shift,
-                         float guidance_scale) const {
+                         float guidance_scale,
+                         ChunkedVocoding *chunked = nullptr) const {
     auto memory_info =
         Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
 
@@ -472,15 +497,30 @@ class OfflineTtsZipvoiceImpl : public OfflineTtsImpl {
         new_shape.size());
 
     GeneratedAudio ans;
-    ans.samples = vocoder_->Run(std::move(mel_new));
     ans.sample_rate = model_->GetMetaData().sample_rate;
+
+    if (chunked && chunked->chunk_size > 0) {
+      chunked->should_continue = vocoder_->RunChunked(
+          std::move(mel_new), chunked->chunk_size, chunked->overlap,
+          [&](const float *samples, int32_t n, float progress) -> int32_t {
+            ans.samples.insert(ans.samples.end(), samples, samples + n);
+
+            float p = chunked->progress_start +
+                      (chunked->progress_end - chunked->progress_start) *
+                          progress;
+            return chunked->callback(samples, n, p);
+          });
+      return ans;
+    }
+
+    ans.samples = vocoder_->Run(std::move(mel_new));
     return ans;
   }
 
  private:
   OfflineTtsConfig config_;
   std::unique_ptr<OfflineTtsZipvoiceModel> model_;
-  std::unique_ptr<Vocoder> vocoder_;
+  std::shared_ptr<Vocoder> vocoder_;
   std::unique_ptr<OfflineTtsFrontend> frontend_;
 
   std::unique_ptr<knf::MelBanks> mel_banks_;
@@ -4,9 +4,16 @@
 
 #include "sherpa-onnx/csrc/offline-tts.h"
 
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <future>  // NOLINT
 #include <map>
+#include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -26,11 +33,6 @@
 
 namespace sherpa_onnx {
 
-struct SilenceInterval {
-  int32_t start;
-  int32_t end;
-};
-
 // Supported range for --tts-silence-scale. The lower bound keeps a pause from
 // collapsing to nothing; the upper bound is a sanity limit, far below the
 // value at which interval_length * scale would overflow an int32_t.
@@ -42,83 +44,95 @@ GeneratedAudio GeneratedAudio::ScaleSilence(float scale) const {
     return *this;
   }
 
+  SilenceScaler scaler(sample_rate, scale);
+
+  GeneratedAudio ans;
+  ans.sample_rate = sample_rate;
+  ans.samples =
+      scaler.Accept(samples.data(), static_cast<int32_t>(samples.size()));
+
+  std::vector<float> tail = scaler.Flush();
+  ans.samples.insert(ans.samples.end(), tail.begin(), tail.end());
+
+  return ans;
+}
+
+SilenceScaler::SilenceScaler(int32_t sample_rate, float scale)
+    : scale_(scale) {
+  if (scale == 1) {
+    return;
+  }
+
   // scale is normally within (0, 1), since it is used to shorten long pauses,
   // but scaling a pause up is also useful. Values outside the supported range
-  // are rejected: n below is computed as interval_length * scale and converted
-  // to an int32_t, and NaN, infinity or a very large scale make that
-  // conversion undefined. Note that any comparison with NaN is false, so NaN
-  // is rejected here as well.
+  // are rejected: the length of a scaled pause is computed as
+  // interval_length * scale and converted to an int32_t, and NaN, infinity or
+  // a very large scale make that conversion undefined. Note that any
+  // comparison with NaN is false, so NaN is rejected here as well.
   if (!(scale >= kMinSilenceScale && scale <= kMaxSilenceScale)) {
     SHERPA_ONNX_LOGE("Silence scale %f is not in [%.2f, %.2f]. Skip scaling.",
                      scale, kMinSilenceScale, kMaxSilenceScale);
-    return *this;
+    return;
   }
+
+  enabled_ = true;
+
   // if the interval is larger than 0.2 second, then we assume it is a pause
-  int32_t threshold = static_cast<int32_t>(sample_rate * 0.2);
+  threshold_ = static_cast<int32_t>(sample_rate * 0.2);
+}
+
+std::vector<float> SilenceScaler::Accept(const float *samples, int32_t n) {
+  if (!enabled_) {
+    return {samples, samples + n};
+  }
 
-  std::vector<SilenceInterval> intervals;
-  int32_t num_samples = static_cast<int32_t>(samples.size());
+  std::vector<float> ans;
+  ans.reserve(n);
 
-  int32_t last = -1;
-  int32_t i;
-  for (i = 0; i != num_samples; ++i) {
+  for (int32_t i = 0; i != n; ++i) {
     if (fabs(samples[i]) <= 0.01) {
-      if (last == -1) {
-        last = i;
-      }
+      silence_.push_back(samples[i]);
       continue;
     }
 
-    if (last != -1 && i - last < threshold) {
-      last = -1;
-      continue;
+    if (!silence_.empty()) {
+      EmitSilence(static_cast<int32_t>(silence_.size()) >= threshold_, &ans);
     }
 
-    if (last != -1) {
-      intervals.push_back({last, i});
-      last = -1;
-    }
+    ans.push_back(samples[i]);
   }
 
-  if (last != -1 && num_samples - last > threshold) {
-    intervals.push_back({last, num_samples});
-  }
+  return ans;
+}
 
-  if (intervals.empty()) {
-    return *this;
-  }
+std::vector<float> SilenceScaler::Flush() {
+  std::vector<float> ans;
 
-  GeneratedAudio ans;
-  ans.sample_rate = sample_rate;
-  ans.samples.reserve(samples.size());
-
-  i = 0;
-  for (const auto &interval : intervals) {
-    ans.samples.insert(ans.samples.end(), samples.begin() + i,
-                       samples.begin() + interval.start);
-    i = interval.end;
-    int32_t len = interval.end - interval.start;
-    int32_t n = static_cast<int32_t>(len * scale);
-
-    if (n <= len) {
-      ans.samples.insert(ans.samples.end(), samples.begin() + interval.start,
-                         samples.begin() + interval.start + n);
-    } else {
-      // scale > 1: copying n samples from interval.start would run past the
-      // end of the pause into the following speech (audible as a repeated
-      // word onset) and can read out of bounds on the final interval.
-      // Copy the pause once, then extend it with silence.
-      ans.samples.insert(ans.samples.end(), samples.begin() + interval.start,
-                         samples.begin() + interval.end);
-      ans.samples.insert(ans.samples.end(), n - len, 0.0f);
-    }
+  // A silence at the end has to be strictly longer than the threshold
+  EmitSilence(static_cast<int32_t>(silence_.size()) > threshold_, &ans);
+
+  return ans;
+}
+
+void SilenceScaler::EmitSilence(bool is_pause, std::vector<float> *out) {
+  if (!is_pause) {
+    out->insert(out->end(), silence_.begin(), silence_.end());
+    silence_.clear();
+    return;
   }
 
-  if (i < num_samples) {
-    ans.samples.insert(ans.samples.end(), samples.begin() + i, samples.end());
+  int32_t len = static_cast<int32_t>(silence_.size());
+  int32_t n = static_cast<int32_t>(len * scale_);
+
+  if (n <= len) {
+    out->insert(out->end(), silence_.begin(), silence_.begin() + n);
+  } else {
+    // scale > 1: keep the pause once, then extend it with silence.
+    out->insert(out->end(), silence_.begin(), silence_.end());
+    out->insert(out->end(), n - len, 0.0f);
   }
 
-  return ans;
+  silence_.clear();
 }
 
 std::string GenerationConfig::GetExtraString(
@@ -203,6 +217,11 @@ void OfflineTtsConfig::Register(ParseOptions *po) {
   po->Register("tts-silence-scale", &silence_scale,
                "Duration of the pause is scaled by this number. So a smaller "
                "value leads to a shorter pause. Must be in [0.01, 10].");
+
+  po->Register("tts-max-concurrency", &max_concurrency,
+               "Maximum number of requests generated in parallel by one "
+               "OfflineTts. They share a single copy of the model. It is also "
+               "the number of threads used by GenerateAsync().");
 }
 
 bool OfflineTtsConfig::Validate() const {
@@ -235,6 +254,12 @@ bool OfflineTtsConfig::Validate() const {
     return false;
   }
 
+  if (max_concurrency < 1) {
+    SHERPA_ONNX_LOGE("--tts-max-concurrency should be >= 1. Given: %d",
+                     max_concurrency);
+    return false;
+  }
+
   return model.Validate();
 }
 
@@ -246,17 +271,149 @@ std::string OfflineTtsConfig::ToString() const {
   os << "rule_fsts=\"" << rule_fsts << "\", ";
   os << "rule_fars=\"" << rule_fars << "\", ";
   os << "max_num_sentences=" << max_num_sentences << ", ";
-  os << "silence_scale=" << silence_scale << ")";
+  os << "silence_scale=" << silence_scale << ", ";
+  os << "max_concurrency=" << max_concurrency << ")";
 
   return os.str();
 }
 
+// It runs generation requests on a single OfflineTtsImpl. The impl and its
+// onnxruntime sessions are shared by all requests, since Generate() of an
+// impl only keeps per-call state on the stack and Ort::Session::Run() can
+// be called concurrently. At most num_workers requests run at the same
+// time. Requests from GenerateAsync() are queued and run by num_workers
+// threads, which are started on the first such request.
+class OfflineTts::WorkerPool {
+ public:
+  WorkerPool(std::unique_ptr<OfflineTtsImpl> impl, int32_t num_workers)
+      : impl_(std::move(impl)), num_workers_(std::max(num_workers, 1)) {}
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    queue_cv_.notify_all();
+
+    // Queued requests are finished before the threads exit
+    for (auto &t : threads_) {
+      t.join();
+    }
+  }
+
+  GeneratedAudio Generate(const std::string &text,
+                          const GenerationConfig &config,
+                          GeneratedAudioCallback callback) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      slot_cv_.wait(lock, [this] { return num_running_ < num_workers_; });
+      ++num_running_;
+    }
+
+    // Release the slot even if Generate() throws
+    struct Guard {
+      WorkerPool *pool;
+      ~Guard() {
+        {
+          std::lock_guard<std::mutex> lock(pool->mutex_);
+          --pool->num_running_;
+        }
+        pool->slot_cv_.notify_one();
+      }
+    } guard{this};
+
+    return impl_->Generate(text, config, std::move(callback));
+  }
+
+  std::future<GeneratedAudio> Submit(std::function<GeneratedAudio()> f) {
+    std::packaged_task<GeneratedAudio()> task(std::move(f));
+    auto ans = task.get_future();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(task));
+
+      if (static_cast<int32_t>(threads_.size()) < num_workers_) {
+        threads_.emplace_back([this]() { Worker(); });
+      }
+    }
+    queue_cv_.notify_one();
+
+    return ans;
+  }
+
+  const OfflineTtsImpl *Impl() const { return impl_.get(); }
+
+ private:
+  void Worker() {
+    while (true) {
+      std::packaged_task<GeneratedAudio()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        queue_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+          return;
+        }
+
+        task = std::move(queue_.front());
+        queue_.pop_front();
+      }
+
+      // Exceptions are passed to the future
+      task();
+    }
+  }
+
+ private:
+  std::unique_ptr<OfflineTtsImpl> impl_;
+  int32_t num_workers_;
+
+  std::mutex mutex_;
+
+  // for Generate()
+  std::condition_variable slot_cv_;
+  int32_t num_running_ = 0;
+
+  // for Submit()
+  std::condition_variable queue_cv_;
+  std::deque<std::packaged_task<GeneratedAudio()>> queue_;
+  std::vector<std::thread> threads_;
+  bool stop_ = false;
+};
+
+#if defined(_WIN32)
+static std::string ToUtf8(const std::string &text) {
+  if (IsUtf8(text)) {
+    return text;
+  } else if (IsGB2312(text)) {
+    static bool printed = false;
+    if (!printed) {
+      SHERPA_ONNX_LOGE(
+          "Detected GB2312 encoded string! Converting it to UTF8.");
+      printed = true;
+    }
+    return Gb2312ToUtf8(text);
+  } else {
+    SHERPA_ONNX_LOGE(
+        "Non UTF8 encoded string is received. You would not get expected "
+        "results!");
+    return text;
+  }
+}
+#endif
+
 OfflineTts::OfflineTts(const OfflineTtsConfig &config)
-    : impl_(OfflineTtsImpl::Create(config)) {}
+    : pool_(std::make_unique<WorkerPool>(OfflineTtsImpl::Create(config),
+                                         config.max_concurrency)) {}
 
 template <typename Manager>
 OfflineTts::OfflineTts(Manager *mgr, const OfflineTtsConfig &config)
-    : impl_(OfflineTtsImpl::Create(mgr, config)) {}
+    : pool_(std::make_unique<WorkerPool>(OfflineTtsImpl::Create(mgr, config),
+                                         config.max_concurrency)) {}
+
+OfflineTts::OfflineTts(std::unique_ptr<OfflineTtsImpl> impl,
+                       int32_t max_concurrency)
+    : pool_(std::make_unique<WorkerPool>(std::move(impl), max_concurrency)) {}
 
 OfflineTts::~OfflineTts() = default;
 
@@ -267,10 +424,10 @@ GeneratedAudio OfflineTts::Generate(
   config.sid = static_cast<int32_t>(sid);
   config.speed = speed;
 #if !defined(_WIN32)
-  return impl_->Generate(text, config, std::move(callback));
+  return pool_->Generate(text, config, std::move(callback));
 #else
   if (IsUtf8(text)) {
-    return impl_->Generate(text, config, std::move(callback));
+    return pool_->Generate(text, config, std::move(callback));
   } else if (IsGB2312(text)) {
     auto utf8_text = Gb2312ToUtf8(text);
     static bool printed = false;
@@ -279,12 +436,12 @@ GeneratedAudio OfflineTts::Generate(
           "Detected GB2312 encoded string! Converting it to UTF8.");
       printed = true;
     }
-    return impl_->Generate(utf8_text, config, std::move(callback));
+    return pool_->Generate(utf8_text, config, std::move(callback));
   } else {
     SHERPA_ONNX_LOGE(
         "Non UTF8 encoded string is received. You would not get expected "
         "results!");
-    return impl_->Generate(text, config, std::move(callback));
+    return pool_->Generate(text, config, std::move(callback));
   }
 #endif
 }
@@ -301,7 +458,7 @@ GeneratedAudio OfflineTts::Generate(
   config.reference_text = prompt_text;
   config.num_steps = num_steps;
 #if !defined(_WIN32)
-  return impl_->Generate(text, config, std::move(callback));
+  return pool_->Generate(text, config, std::move(callback));
 #else
   static bool printed = false;
   auto utf8_text = text;
@@ -323,12 +480,12 @@ GeneratedAudio OfflineTts::Generate(
   }
   config.reference_text = utf8_prompt_text;
   if (IsUtf8(utf8_text) && IsUtf8(utf8_prompt_text)) {
-    return impl_->Generate(utf8_text, config, std::move(callback));
+    return pool_->Generate(utf8_text, config, std::move(callback));
   } else {
     SHERPA_ONNX_LOGE(
         "Non UTF8 encoded string is received. You would not get expected "
         "results!");
-    return impl_->Generate(utf8_text, config, std::move(callback));
+    return pool_->Generate(utf8_text, config, std::move(callback));
   }
 #endif
 }
@@ -337,31 +494,35 @@ GeneratedAudio OfflineTts::Generate(
     const std::string &text, const GenerationConfig &config,
     GeneratedAudioCallback callback /*= nullptr*/) const {
 #if !defined(_WIN32)
-  return impl_->Generate(text, config, std::move(callback));
+  return pool_->Generate(text, config, std::move(callback));
 #else
-  if (IsUtf8(text)) {
-    return impl_->Generate(text, config, std::move(callback));
-  } else if (IsGB2312(text)) {
-    auto utf8_text = Gb2312ToUtf8(text);
-    static bool printed = false;
-    if (!printed) {
-      SHERPA_ONNX_LOGE(
-          "Detected GB2312 encoded string! Converting it to UTF8.");
-      printed = true;
-    }
-    return impl_->Generate(utf8_text, config, std::move(callback));
-  } else {
-    SHERPA_ONNX_LOGE(
-        "Non UTF8 encoded string is received. You would not get expected "
-        "results!");
-    return impl_->Generate(text, config, std::move(callback));
-  }
+  return pool_->Generate(ToUtf8(text), config, std::move(callback));
+#endif
+}
+
+std::future<GeneratedAudio> OfflineTts::GenerateAsync(
+    const std::string &text, const GenerationConfig &config,
+    GeneratedAudioCallback callback /*= nullptr*/) const {
+#if !defined(_WIN32)
+  const std::string &utf8_text = text;
+#else
+  std::string utf8_text = ToUtf8(text);
 #endif
+
+  // Capture the pool instead of this. ~WorkerPool() runs queued requests
+  // and pool_ may already be null at that time.
+  WorkerPool *pool = pool_.get();
+  return pool->Submit(
+      [pool, utf8_text, config, callback = std::move(callback)]() {
+        return pool->Generate(utf8_text, config, callback);
+      });
 }
 
-int32_t OfflineTts::SampleRate() const { return impl_->SampleRate(); }
+int32_t OfflineTts::SampleRate() const { return pool_->Impl()->SampleRate(); }
 
-int32_t OfflineTts::NumSpeakers() const { return impl_->NumSpeakers(); }
+int32_t OfflineTts::NumSpeakers() const {
+  return pool_->Impl()->NumSpeakers();
+}
 
 #if __ANDROID_API__ >= 9
 template OfflineTts::OfflineTts(AAssetManager *mgr,
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -38,6 +39,13 @@ struct OfflineTtsConfig {
   // the duration of the new interval is old_duration * silence_scale.
   float silence_scale = 0.2;
 
+  // Maximum number of Generate() calls that run in parallel on a single
+  // OfflineTts; further calls block until one of them finishes. It does
+  // not create extra copies of the model or extra onnxruntime sessions:
+  // all calls share one model. It is also the number of threads that run
+  // requests from GenerateAsync().
+  int32_t max_concurrency = 1;
+
   OfflineTtsConfig() = default;
   OfflineTtsConfig(const OfflineTtsModelConfig &model,
                    const std::string &rule_fsts, const std::string &rule_fars,
@@ -64,6 +72,35 @@ struct GeneratedAudio {
   GeneratedAudio ScaleSilence(float scale) const;
 };
 
+// Like GeneratedAudio::ScaleSilence(), but for audio that arrives chunk by
+// chunk. The output of Accept() followed by Flush() is identical to the
+// output of ScaleSilence() for the concatenated input.
+//
+// Silence at the end of the input received so far is held back until it
+// is known whether it is a pause.
+class SilenceScaler {
+ public:
+  SilenceScaler(int32_t sample_rate, float scale);
+
+  std::vector<float> Accept(const float *samples, int32_t n);
+
+  // Call it after the last Accept()
+  std::vector<float> Flush();
+
+ private:
+  // Move silence_ to out, scaling it if it is a pause
+  void EmitSilence(bool is_pause, std::vector<float> *out);
+
+ private:
+  float scale_ = 1;
+  bool enabled_ = false;
+
+  // A silence at least this long is a pause
+  int32_t threshold_ = 0;
+
+  std::vector<float> silence_;
+};
+
 struct GenerationConfig {
   float silence_scale = 0.2;
 
@@ -102,6 +139,10 @@ class OfflineTts {
   ~OfflineTts();
   explicit OfflineTts(const OfflineTtsConfig &config);
 
+  // Use the given impl, e.g., a stub for testing. See
+  // OfflineTtsConfig::max_concurrency for max_concurrency.
+  OfflineTts(std::unique_ptr<OfflineTtsImpl> impl, int32_t max_concurrency);
+
   template <typename Manager>
   OfflineTts(Manager *mgr, const OfflineTtsConfig &config);
 
@@ -144,10 +185,21 @@ class OfflineTts {
                           int32_t num_steps = 4,
                           GeneratedAudioCallback callback = nullptr) const;
 
+  // It is safe to call this method from multiple threads. At most
+  // config.max_concurrency calls run in parallel; the others wait until
+  // one of them finishes.
   GeneratedAudio Generate(const std::string &text,
                           const GenerationConfig &config,
                           GeneratedAudioCallback callback = nullptr) const;
 
+  // Like Generate() above, but it returns immediately. The request is
+  // queued and run by one of config.max_concurrency worker threads. The
+  // callback, if not NULL, is called in that thread. Queued requests are
+  // finished before this object is destroyed.
+  std::future<GeneratedAudio> GenerateAsync(
+      const std::string &text, const GenerationConfig &config,
+      GeneratedAudioCallback callback = nullptr) const;
+
   // Return the sample rate of the generated audio
   int32_t SampleRate() const;
 
@@ -156,7 +208,8 @@ class OfflineTts {
   int32_t NumSpeakers() const;
 
  private:
-  std::unique_ptr<OfflineTtsImpl> impl_;
+  class WorkerPool;
+  std::unique_ptr<WorkerPool> pool_;
 };
 
 }  // namespace sherpa_onnx
@@ -5,14 +5,17 @@
 #include "sherpa-onnx/csrc/offline-websocket-server-impl.h"
 
 #include <algorithm>
+#include <chrono>  // NOLINT
 #include <iostream>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "sherpa-onnx/csrc/bucket-by-length.h"
 #include "sherpa-onnx/csrc/file-utils.h"
 #include "sherpa-onnx/csrc/macros.h"
+#include "sherpa-onnx/csrc/text-utils.h"
 
 namespace sherpa_onnx {
 
@@ -27,6 +30,16 @@ void OfflineWebsocketDecoderConfig::Register(ParseOptions *po) {
       "Max utterance length in seconds. If we receive an utterance "
       "longer than this value, we will reject the connection. "
       "If you have enough memory, you can select a large value for it.");
+
+  po->Register("max-concurrency", &max_concurrency,
+               "Max number of batches of this model decoded at the same "
+               "time. 0 means no limit. Use it to keep work threads "
+               "available for other models when --models is used.");
+
+  po->Register("max-pending-utterances", &max_pending_utterances,
+               "Max number of utterances of this model waiting to be "
+               "decoded. New utterances are rejected once it is reached. "
+               "0 means no limit.");
 }
 
 void OfflineWebsocketDecoderConfig::Validate() const {
@@ -45,68 +58,282 @@ void OfflineWebsocketDecoderConfig::Validate() const {
                      max_utterance_length);
     SHERPA_ONNX_EXIT(-1);
   }
+
+  if (max_concurrency < 0) {
+    SHERPA_ONNX_LOGE("Expect --max-concurrency >= 0. Given: %d",
+                     max_concurrency);
+    SHERPA_ONNX_EXIT(-1);
+  }
+
+  if (max_pending_utterances < 0) {
+    SHERPA_ONNX_LOGE("Expect --max-pending-utterances >= 0. Given: %d",
+                     max_pending_utterances);
+    SHERPA_ONNX_EXIT(-1);
+  }
 }
 
 OfflineWebsocketDecoder::OfflineWebsocketDecoder(OfflineWebsocketServer *server)
-    : config_(server->GetConfig().decoder_config),
-      server_(server),
-      recognizer_(config_.recognizer_config) {}  // NOLINT
+    : server_(server) {
+  const auto &config = server->GetConfig();
+
+  // name=config_file pairs. The default model has an empty name.
+  std::vector<std::pair<std::string, std::string>> names = {{"", ""}};
+
+  std::vector<std::string> models;
+  SplitStringToVector(config.models, ",", true, &models);
+  for (const auto &m : models) {
+    auto pos = m.find('=');
+    if (pos == std::string::npos || pos == 0 || pos + 1 == m.size()) {
+      SHERPA_ONNX_LOGE("Expect name=config_file in --models. Given: '%s'",
+                       m.c_str());
+      SHERPA_ONNX_EXIT(-1);
+    }
+    names.emplace_back(m.substr(0, pos), m.substr(pos + 1));
+  }
 
-void OfflineWebsocketDecoder::Push(connection_hdl hdl, ConnectionDataPtr d) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  streams_.push_back({hdl, d});
+  for (const auto &p : names) {
+    if (!p.first.empty() && GetModelConfig(p.first)) {
+      SHERPA_ONNX_LOGE("Duplicate model name '%s' in --models",
+                       p.first.c_str());
+      SHERPA_ONNX_EXIT(-1);
+    }
+
+    auto model = std::make_unique<Model>();
+    model->name = p.first;
+
+    if (p.second.empty()) {
+      model->config = config.decoder_config;
+    } else {
+      ReadConfigFromFile(p.second, &model->config);
+      model->config.Validate();
+    }
+
+    // Models share the feature and work thread pools of the server
+    model->recognizer =
+        std::make_unique<OfflineRecognizer>(model->config.recognizer_config);
+
+    models_.push_back(std::move(model));
+  }
+
+  if (models_.size() > 1) {
+    SHERPA_ONNX_LOGE("Number of models: %d",
+                     static_cast<int32_t>(models_.size()));
+  }
+
+  auto &metrics = server->GetMetrics();
+
+  metrics.AddGauge("sherpa_onnx_pending_utterances",
+                   "Number of utterances waiting for feature extraction "
+                   "or decoding",
+                   [this]() {
+                     std::lock_guard<std::mutex> lock(mutex_);
+                     int32_t n = 0;
+                     for (const auto &m : models_) {
+                       n += m->num_pending;
+                     }
+                     return static_cast<double>(n);
+                   });
+
+  rejected_ = metrics.AddCounter(
+      "sherpa_onnx_rejected_utterances_total",
+      "Number of utterances rejected because of --max-pending-utterances");
+
+  batch_size_ = metrics.AddHistogram(
+      "sherpa_onnx_decode_batch_size",
+      "Number of streams decoded together by DecodeStreams()",
+      {1, 2, 4, 8, 16, 32, 64});
+
+  decode_duration_ = metrics.AddHistogram(
+      "sherpa_onnx_decode_duration_seconds",
+      "Time of a call to DecodeStreams()",
+      {0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10});
+
+  decode_seconds_ = metrics.AddCounter("sherpa_onnx_decode_seconds_total",
+                                       "Time spent in DecodeStreams()");
+
+  audio_seconds_ = metrics.AddCounter(
+      "sherpa_onnx_audio_seconds_total",
+      "Duration of decoded audio. The real-time factor is "
+      "rate(sherpa_onnx_decode_seconds_total) / "
+      "rate(sherpa_onnx_audio_seconds_total)");
+}
+
+const OfflineWebsocketDecoderConfig *OfflineWebsocketDecoder::GetModelConfig(
+    const std::string &name) const {
+  for (const auto &m : models_) {
+    if (m->name == name) {
+      return &m->config;
+    }
+  }
+
+  return nullptr;
+}
+
+bool OfflineWebsocketDecoder::Push(connection_hdl hdl, ConnectionDataPtr d) {
+  Model *model = nullptr;
+  for (auto &m : models_) {
+    if (m->name == d->model) {
+      model = m.get();
+      break;
+    }
+  }
+
+  if (!model) {
+    // The server checks the name before accepting audio
+    SHERPA_ONNX_LOGE("Unknown model: '%s'", d->model.c_str());
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (model->config.max_pending_utterances > 0 &&
+        model->num_pending >= model->config.max_pending_utterances) {
+      rejected_->Inc();
+      return false;
+    }
+    ++model->num_pending;
+  }
+
+  asio::post(server_->GetFeatureContext(),
+             [this, model, hdl, d]() { ExtractFeatures(model, hdl, d); });
+
+  return true;
+}
+
+void OfflineWebsocketDecoder::ExtractFeatures(Model *model,
+                                              connection_hdl hdl,
+                                              ConnectionDataPtr d) {
+  auto samples = reinterpret_cast<const float *>(d->data.data());
+  int32_t num_samples = d->expected_byte_size / sizeof(float);
+
+  // Note: It does not lock mutex_, so features of different streams are
+  // computed in parallel and Decode() is not blocked.
+  auto s = model->recognizer->CreateStream();
+  s->AcceptWaveform(d->sample_rate, samples, num_samples);
+
+  ReadyStream r;
+  r.hdl = hdl;
+  r.s = std::move(s);
+  if (d->sample_rate > 0) {
+    r.length_ms = static_cast<int32_t>(static_cast<int64_t>(num_samples) *
+                                       1000 / d->sample_rate);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    r.seq = next_seq_++;
+    model->streams.push_back(std::move(r));
+  }
+
+  asio::post(server_->GetWorkContext(), [this]() { Decode(); });
+}
+
+OfflineWebsocketDecoder::Model *OfflineWebsocketDecoder::SelectModel() {
+  Model *ans = nullptr;
+  for (auto &m : models_) {
+    if (m->streams.empty()) {
+      continue;
+    }
+
+    if (m->config.max_concurrency > 0 &&
+        m->num_running >= m->config.max_concurrency) {
+      continue;
+    }
+
+    if (!ans || m->streams.front().seq < ans->streams.front().seq) {
+      ans = m.get();
+    }
+  }
+
+  return ans;
 }
 
 void OfflineWebsocketDecoder::Decode() {
   std::unique_lock<std::mutex> lock(mutex_);
-  if (streams_.empty()) {
+  Model *model = SelectModel();
+  if (!model) {
     return;
   }
 
-  int32_t size =
-      std::min(static_cast<int32_t>(streams_.size()), config_.max_batch_size);
-  SHERPA_ONNX_LOGE("size: %d", size);
+  auto &streams = model->streams;
 
-  // We first lock the mutex for streams_, take items from it, and then
-  // unlock the mutex; in doing so we don't need to lock the mutex to
-  // access hdl and connection_data later.
-  std::vector<connection_hdl> handles(size);
+  std::vector<int32_t> lengths;
+  lengths.reserve(streams.size());
+  for (const auto &r : streams) {
+    lengths.push_back(r.length_ms);
+  }
+
+  // Streams in a batch are padded to the longest one, so we put streams
+  // of similar lengths into a batch. We always take the batch containing
+  // the oldest stream so that long streams are not starved.
+  auto batches = BucketByLength(lengths, model->config.max_batch_size, 1.5);
+
+  std::vector<int32_t> batch;
+  for (auto &b : batches) {
+    if (std::find(b.begin(), b.end(), 0) != b.end()) {
+      batch = std::move(b);
+      break;
+    }
+  }
+  std::sort(batch.begin(), batch.end());
 
-  // Store connection_data here to prevent the data from being freed
-  // while we are still using it.
-  std::vector<ConnectionDataPtr> connection_data(size);
+  int32_t size = static_cast<int32_t>(batch.size());
+  SHERPA_ONNX_LOGE("size: %d", size);
 
-  std::vector<const float *> samples(size);
-  std::vector<int32_t> samples_length(size);
-  std::vector<std::unique_ptr<OfflineStream>> ss(size);
+  // We first lock the mutex for streams, take items from it, and then
+  // unlock the mutex; in doing so we don't need to lock the mutex to
+  // access the streams later.
+  std::vector<ReadyStream> ready(size);
   std::vector<OfflineStream *> p_ss(size);
 
   for (int32_t i = 0; i != size; ++i) {
-    auto &p = streams_.front();
-    handles[i] = p.first;
-    connection_data[i] = p.second;
-    streams_.pop_front();
-
-    auto sample_rate = connection_data[i]->sample_rate;
-    auto samples =
-        reinterpret_cast<const float *>(&connection_data[i]->data[0]);
-    auto num_samples = connection_data[i]->expected_byte_size / sizeof(float);
-    auto s = recognizer_.CreateStream();
-    s->AcceptWaveform(sample_rate, samples, num_samples);
-
-    ss[i] = std::move(s);
-    p_ss[i] = ss[i].get();
+    ready[i] = std::move(streams[batch[i]]);
+    p_ss[i] = ready[i].s.get();
+  }
+
+  for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+    streams.erase(streams.begin() + *it);
   }
 
+  model->num_pending -= size;
+  ++model->num_running;
+
   lock.unlock();
 
+  auto start = std::chrono::steady_clock::now();
+
   // Note: DecodeStreams is thread-safe
-  recognizer_.DecodeStreams(p_ss.data(), size);
+  model->recognizer->DecodeStreams(p_ss.data(), size);
+
+  float elapsed_seconds = std::chrono::duration<float>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+
+  int32_t length_ms = 0;
+  for (const auto &r : ready) {
+    length_ms += r.length_ms;
+  }
+
+  batch_size_->Observe(size);
+  decode_duration_->Observe(elapsed_seconds);
+  decode_seconds_->Inc(elapsed_seconds);
+  audio_seconds_->Inc(length_ms / 1000.0);
+
+  lock.lock();
+  --model->num_running;
+
+  // Streams skipped because of --max-concurrency are decoded now
+  bool has_more = SelectModel() != nullptr;
+  lock.unlock();
+
+  if (has_more) {
+    asio::post(server_->GetWorkContext(), [this]() { Decode(); });
+  }
 
   for (int32_t i = 0; i != size; ++i) {
-    connection_hdl hdl = handles[i];
+    connection_hdl hdl = ready[i].hdl;
     asio::post(server_->GetConnectionContext(),
-               [this, hdl, result = ss[i]->GetResult()]() {
+               [this, hdl, result = ready[i].s->GetResult()]() {
                  websocketpp::lib::error_code ec;
                  server_->GetServer().send(hdl, result.AsJsonString(),
                                            websocketpp::frame::opcode::text,
@@ -124,6 +351,18 @@ void OfflineWebsocketServerConfig::Register(ParseOptions *po) {
   po->Register("log-file", &log_file,
                "Path to the log file. Logs are "
                "appended to this file");
+
+  po->Register("enable-metrics", &enable_metrics,
+               "If true, metrics in the text format of Prometheus are "
+               "served over HTTP at /metrics on the same port.");
+
+  po->Register(
+      "models", &models,
+      "Additional models hosted by the server, e.g., "
+      "en=./en.conf,zh=./zh.conf. Each config file contains the options of a "
+      "model, one per line, e.g., --tokens=./tokens.txt. A client selects a "
+      "model by sending the text message model=<name> before its audio. "
+      "Models given by other command-line options are used by default.");
 }
 
 void OfflineWebsocketServerConfig::Validate() const {
@@ -131,10 +370,12 @@ void OfflineWebsocketServerConfig::Validate() const {
 }
 
 OfflineWebsocketServer::OfflineWebsocketServer(
-    asio::io_context &io_conn,  // NOLINT
-    asio::io_context &io_work,  // NOLINT
+    asio::io_context &io_conn,     // NOLINT
+    asio::io_context &io_feature,  // NOLINT
+    asio::io_context &io_work,     // NOLINT
     const OfflineWebsocketServerConfig &config)
     : io_conn_(io_conn),
+      io_feature_(io_feature),
       io_work_(io_work),
       config_(config),
       log_(OpenOutputFile(config.log_file, std::ios::app)),
@@ -152,6 +393,20 @@ OfflineWebsocketServer::OfflineWebsocketServer(
       [this](connection_hdl hdl, server::message_ptr msg) {
         OnMessage(hdl, msg);
       });
+
+  metrics_.AddGauge("sherpa_onnx_active_connections",
+                    "Number of active websocket connections", [this]() {
+                      std::lock_guard<std::mutex> lock(mutex_);
+                      return static_cast<double>(connections_.size());
+                    });
+
+  metrics_.AddGauge("sherpa_onnx_resident_memory_bytes",
+                    "Resident memory of the server process",
+                    []() { return GetResidentMemoryBytes(); });
+
+  if (config_.enable_metrics) {
+    server_.set_http_handler([this](connection_hdl hdl) { OnHttp(hdl); });
+  }
 }
 
 void OfflineWebsocketServer::SetupLog() {
@@ -193,6 +448,15 @@ void OfflineWebsocketServer::OnMessage(connection_hdl hdl,
         // The client will not send any more data. We can close the
         // connection now.
         Close(hdl, websocketpp::close::status::normal, "Done");
+      } else if (payload.compare(0, 6, "model=") == 0 &&
+                 connection_data->expected_byte_size == 0) {
+        std::string name = payload.substr(6);
+        if (!decoder_.GetModelConfig(name)) {
+          Close(hdl, websocketpp::close::status::normal,
+                std::string("Unknown model: ") + name);
+        } else {
+          connection_data->model = std::move(name);
+        }
       } else {
         Close(hdl, websocketpp::close::status::normal,
               std::string("Invalid payload: ") + payload);
@@ -214,7 +478,11 @@ void OfflineWebsocketServer::OnMessage(connection_hdl hdl,
         connection_data->expected_byte_size =
             *reinterpret_cast<const int32_t *>(p + 4);
 
-        int32_t max_byte_size_ = decoder_.GetConfig().max_utterance_length *
+        float max_utterance_length =
+            decoder_.GetModelConfig(connection_data->model)
+                ->max_utterance_length;
+
+        int32_t max_byte_size_ = max_utterance_length *
                                  connection_data->sample_rate * sizeof(float);
         if (connection_data->expected_byte_size > max_byte_size_) {
           float num_samples =
@@ -224,7 +492,7 @@ void OfflineWebsocketServer::OnMessage(connection_hdl hdl,
 
           std::ostringstream os;
           os << "Max utterance length is configured to "
-             << decoder_.GetConfig().max_utterance_length
+             << max_utterance_length
              << " seconds, received length is " << duration << " seconds. "
              << "Payload is too large!";
           Close(hdl, websocketpp::close::status::message_too_big, os.str());
@@ -246,15 +514,17 @@ void OfflineWebsocketServer::OnMessage(connection_hdl hdl,
         // Clear it so that we can handle the next audio file from the client.
         // The client can send multiple audio files for recognition without
         // the need to create another connection.
-        connection_data->sample_rate = 0;
-        connection_data->expected_byte_size = 0;
-        connection_data->cur = 0;
-
-        decoder_.Push(hdl, d);
-
         connection_data->Clear();
 
-        asio::post(io_work_, [this]() { decoder_.Decode(); });
+        // The selected model is kept for the next audio file
+        connection_data->model = d->model;
+
+        // Features are computed in io_feature_, which then schedules
+        // decoding in io_work_
+        if (!decoder_.Push(hdl, d)) {
+          Close(hdl, websocketpp::close::status::try_again_later,
+                "Too many pending utterances. Please try again later");
+        }
       }
       break;
     }
@@ -265,6 +535,20 @@ void OfflineWebsocketServer::OnMessage(connection_hdl hdl,
   }
 }
 
+void OfflineWebsocketServer::OnHttp(connection_hdl hdl) {
+  auto con = server_.get_con_from_hdl(hdl);
+
+  if (con->get_resource() != "/metrics") {
+    con->set_status(websocketpp::http::status_code::not_found);
+    con->set_body("Not found\n");
+    return;
+  }
+
+  con->set_status(websocketpp::http::status_code::ok);
+  con->append_header("Content-Type", "text/plain; version=0.0.4");
+  con->set_body(metrics_.ToString());
+}
+
 void OfflineWebsocketServer::Close(connection_hdl hdl,
                                    websocketpp::close::status::value code,
                                    const std::string &reason) {
@@ -13,6 +13,7 @@
 #include <utility>
 #include <vector>
 
+#include "sherpa-onnx/csrc/metrics.h"
 #include "sherpa-onnx/csrc/offline-recognizer.h"
 #include "sherpa-onnx/csrc/parse-options.h"
 #include "sherpa-onnx/csrc/tee-stream.h"
@@ -36,8 +37,16 @@ namespace sherpa_onnx {
  * The byte stream can be broken into arbitrary number of messages.
  * We require that the first message has to be at least 8 bytes so that
  * we can get `sample_rate` and `expected_byte_size` from the first message.
+ *
+ * If the server hosts several models, the client can send a text message
+ * "model=<name>" before the audio to select the model for the remaining
+ * audio of the connection. The default model is used otherwise.
  */
 struct ConnectionData {
+  // Name of the model for decoding. Empty means the default model.
+  // It is kept across audio files of the same connection.
+  std::string model;
+
   // Sample rate of the audio samples the client
   int32_t sample_rate;
 
@@ -69,6 +78,15 @@ struct OfflineWebsocketDecoderConfig {
 
   float max_utterance_length = 300;  // seconds
 
+  // Max number of batches of this model decoded at the same time.
+  // 0 means no limit, i.e., all work threads can be used by this model.
+  int32_t max_concurrency = 0;
+
+  // Max number of utterances of this model waiting to be decoded.
+  // New utterances are rejected once it is reached, which bounds the
+  // memory used by queued audio and features. 0 means no limit.
+  int32_t max_pending_utterances = 0;
+
   void Register(ParseOptions *po);
   void Validate() const;
 };
@@ -83,54 +101,121 @@ class OfflineWebsocketDecoder {
    */
   explicit OfflineWebsocketDecoder(OfflineWebsocketServer *server);
 
-  /** Insert received data to the queue for decoding.
+  /** Schedule feature extraction for the received data. It returns
+   * immediately and is called by the network threads.
    *
    * @param hdl A handle to the connection. We can use it to send the result
    *            back to the client once it finishes decoding.
-   * @param d  The received data
+   * @param d  The received data. d->model selects the model.
+   * @return Return false if the model has too many pending utterances.
    */
-  void Push(connection_hdl hdl, ConnectionDataPtr d);
+  bool Push(connection_hdl hdl, ConnectionDataPtr d);
 
-  /** It is called by one of the work thread.
+  /** It is called by one of the work thread. It decodes a batch of the
+   * model whose oldest utterance has waited the longest.
    */
   void Decode();
 
-  const OfflineWebsocketDecoderConfig &GetConfig() const { return config_; }
+  // Config of the default model
+  const OfflineWebsocketDecoderConfig &GetConfig() const {
+    return models_[0]->config;
+  }
 
- private:
-  OfflineWebsocketDecoderConfig config_;
+  // Return nullptr if there is no such model. An empty name means the
+  // default model.
+  const OfflineWebsocketDecoderConfig *GetModelConfig(
+      const std::string &name) const;
 
-  /** When we have received all the data from the client, we put it into
-   * this queue; the worker threads will get items from this queue for
-   * decoding.
-   *
-   * Number of items to take from this queue is determined by
-   * `--max-batch-size`. If there are not enough items in the queue, we won't
-   * wait and take whatever we have for decoding.
+ private:
+  /** It is called by one of the feature extraction threads. It computes
+   * features of the received data and puts the resulting stream into
+   * the queue for decoding.
    */
+  struct Model;
+  void ExtractFeatures(Model *model, connection_hdl hdl, ConnectionDataPtr d);
+
+  // Return nullptr if no model has a stream that can be decoded now.
+  // Must be called with mutex_ held.
+  Model *SelectModel();
+
+ private:
+  struct ReadyStream {
+    connection_hdl hdl;
+    std::unique_ptr<OfflineStream> s;
+
+    // Duration of the audio in milliseconds. It is used to put streams
+    // of similar lengths into the same batch.
+    int32_t length_ms = 0;
+
+    // Streams of all models are decoded in the order of arrival
+    int64_t seq = 0;
+  };
+
+  struct Model {
+    std::string name;
+    OfflineWebsocketDecoderConfig config;
+    std::unique_ptr<OfflineRecognizer> recognizer;
+
+    /** Once features of a stream are computed, we put it into this queue;
+     * the worker threads will get items from this queue for decoding.
+     *
+     * Number of items to take from this queue is determined by
+     * `--max-batch-size`. Items in a batch have similar lengths and the
+     * oldest item in the queue is always included. If there are not enough
+     * items in the queue, we won't wait and take whatever we have for
+     * decoding.
+     *
+     * It is protected by mutex_, as are the counters below.
+     */
+    std::deque<ReadyStream> streams;
+    int32_t num_pending = 0;  // utterances pushed but not yet decoded
+    int32_t num_running = 0;  // batches being decoded
+  };
+
   std::mutex mutex_;
-  std::deque<std::pair<connection_hdl, ConnectionDataPtr>> streams_;
+  int64_t next_seq_ = 0;
 
   OfflineWebsocketServer *server_;  // Not owned
-  OfflineRecognizer recognizer_;
+
+  // models_[0] is the default model given on the command line
+  std::vector<std::unique_ptr<Model>> models_;
+
+  // Owned by the server
+  Histogram *batch_size_;
+  Histogram *decode_duration_;
+  Counter *decode_seconds_;
+  Counter *audio_seconds_;
+  Counter *rejected_;
 };
 
 struct OfflineWebsocketServerConfig {
   OfflineWebsocketDecoderConfig decoder_config;
   std::string log_file = "./log.txt";
 
+  // Additional models hosted by the server, e.g.,
+  // "en=./en.conf,zh=./zh.conf". Each config file contains the
+  // command-line options of a model, e.g., --tokens and --max-batch-size.
+  std::string models;
+
+  // If true, serve metrics at http://<host>:<port>/metrics
+  bool enable_metrics = false;
+
   void Register(ParseOptions *po);
   void Validate() const;
 };
 
 class OfflineWebsocketServer {
  public:
-  OfflineWebsocketServer(asio::io_context &io_conn,  // NOLINT
-                         asio::io_context &io_work,  // NOLINT
+  OfflineWebsocketServer(asio::io_context &io_conn,     // NOLINT
+                         asio::io_context &io_feature,  // NOLINT
+                         asio::io_context &io_work,     // NOLINT
                          const OfflineWebsocketServerConfig &config);
 
   asio::io_context &GetConnectionContext() { return io_conn_; }
+  asio::io_context &GetFeatureContext() { return io_feature_; }
+  asio::io_context &GetWorkContext() { return io_work_; }
   server &GetServer() { return server_; }
+  MetricsRegistry &GetMetrics() { return metrics_; }
 
   void Run(uint16_t port);
 
@@ -179,12 +264,16 @@ class OfflineWebsocketServer {
   //      a WAVE file, the RIFF header of the WAVE is not sent.
   void OnMessage(connection_hdl hdl, server::message_ptr msg);
 
+  // Handle plain HTTP requests. Only /metrics is supported.
+  void OnHttp(connection_hdl hdl);
+
   // Close a websocket connection with given code and reason
   void Close(connection_hdl hdl, websocketpp::close::status::value code,
              const std::string &reason);
 
  private:
   asio::io_context &io_conn_;
+  asio::io_context &io_feature_;
   asio::io_context &io_work_;
   server server_;
 
@@ -197,6 +286,8 @@ class OfflineWebsocketServer {
   std::ofstream log_;
   TeeStream tee_;
 
+  MetricsRegistry metrics_;
+
   OfflineWebsocketDecoder decoder_;
 };
 
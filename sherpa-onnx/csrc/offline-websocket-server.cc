@@ -38,6 +38,29 @@ Usage:
   --log-file=./log.txt \
   --max-batch-size=5
 
+(3) For several models behind one port
+
+./bin/sherpa-onnx-offline-websocket-server \
+  --port=6006 \
+  --num-work-threads=5 \
+  --tokens=/path/to/tokens.txt \
+  --paraformer=/path/to/model.onnx \
+  --models=en=./en.conf,de=./de.conf \
+  --log-file=./log.txt \
+  --max-batch-size=5
+
+where en.conf contains the options of a model, one per line, e.g.,
+
+  --tokens=/path/to/en/tokens.txt
+  --encoder=/path/to/en/encoder.onnx
+  --decoder=/path/to/en/decoder.onnx
+  --joiner=/path/to/en/joiner.onnx
+  --max-batch-size=8
+  --max-concurrency=2
+
+A client sends the text message model=en before its audio to use it.
+Otherwise, the model given by the command-line options is used.
+
 Please refer to
 https://k2-fsa.github.io/sherpa/onnx/pretrained_models/index.html
 for a list of pre-trained models to download.
@@ -54,12 +77,19 @@ int32_t main(int32_t argc, char *argv[]) {
   // size of the thread pool for handling network connections
   int32_t num_io_threads = 1;
 
+  // size of the thread pool for feature extraction
+  int32_t num_feature_threads = 2;
+
   // size of the thread pool for neural network computation and decoding
   int32_t num_work_threads = 3;
 
   po.Register("num-io-threads", &num_io_threads,
               "Thread pool size for network connections.");
 
+  po.Register("num-feature-threads", &num_feature_threads,
+              "Thread pool size for feature extraction. It computes "
+              "features of received audio before they are decoded.");
+
   po.Register("num-work-threads", &num_work_threads,
               "Thread pool size for for neural network "
               "computation and decoding.");
@@ -85,16 +115,20 @@ int32_t main(int32_t argc, char *argv[]) {
   config.Validate();
 
   asio::io_context io_conn;  // for network connections
-  asio::io_context io_work;  // for neural network and decoding
+  asio::io_context io_feature;  // for feature extraction
+  asio::io_context io_work;     // for neural network and decoding
 
-  sherpa_onnx::OfflineWebsocketServer server(io_conn, io_work, config);
+  sherpa_onnx::OfflineWebsocketServer server(io_conn, io_feature, io_work,
+                                             config);
   server.Run(port);
 
   SHERPA_ONNX_LOGE("Started!");
   SHERPA_ONNX_LOGE("Listening on: %d", port);
+  SHERPA_ONNX_LOGE("Number of feature threads: %d", num_feature_threads);
   SHERPA_ONNX_LOGE("Number of work threads: %d", num_work_threads);
 
-  // give some work to do for the io_work pool
+  // give some work to do for the io_feature and io_work pools
+  auto feature_guard = asio::make_work_guard(io_feature);
   auto work_guard = asio::make_work_guard(io_work);
 
   std::vector<std::thread> io_threads;
@@ -104,6 +138,11 @@ int32_t main(int32_t argc, char *argv[]) {
     io_threads.emplace_back([&io_conn]() { io_conn.run(); });
   }
 
+  std::vector<std::thread> feature_threads;
+  for (int32_t i = 0; i < num_feature_threads; ++i) {
+    feature_threads.emplace_back([&io_feature]() { io_feature.run(); });
+  }
+
   std::vector<std::thread> work_threads;
   for (int32_t i = 0; i < num_work_threads; ++i) {
     work_threads.emplace_back([&io_work]() { io_work.run(); });
@@ -115,6 +154,10 @@ int32_t main(int32_t argc, char *argv[]) {
     t.join();
   }
 
+  for (auto &t : feature_threads) {
+    t.join();
+  }
+
   for (auto &t : work_threads) {
     t.join();
   }
@@ -60,8 +60,8 @@ class OfflineWenetCtcModel : public OfflineCtcModel {
    */
   OrtAllocator *Allocator() const override;
 
-  // WeNet CTC models do not support batch size > 1
-  bool SupportBatchProcessing() const override { return false; }
+  // Padded frames are masked out inside the model using features_length
+  bool SupportBatchProcessing() const override { return true; }
 
  private:
   class Impl;
@@ -5,6 +5,7 @@
 #include "sherpa-onnx/csrc/offline-whisper-model.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <memory>
 #include <string>
@@ -210,16 +211,26 @@ class OfflineWhisperModel::Impl {
 
   int32_t DetectLanguage(Ort::Value &cross_k,    // NOLINT
                          Ort::Value &cross_v) {  // NOLINT
-    int64_t token_val = SOT();
-    std::array<int64_t, 2> token_shape{1, 1};
+    return DetectLanguages(cross_k, cross_v)[0];
+  }
+
+  std::vector<int32_t> DetectLanguages(Ort::Value &cross_k,    // NOLINT
+                                       Ort::Value &cross_v) {  // NOLINT
+    // (n_text_layer, N, n_audio_ctx, n_text_state)
+    int32_t batch_size =
+        cross_k.GetTensorTypeAndShapeInfo().GetShape()[1];
+
+    std::vector<int64_t> token_val(batch_size, SOT());
+    std::array<int64_t, 2> token_shape{batch_size, 1};
 
     auto memory_info =
         Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
 
     Ort::Value tokens = Ort::Value::CreateTensor(
-        memory_info, &token_val, 1, token_shape.data(), token_shape.size());
+        memory_info, token_val.data(), token_val.size(), token_shape.data(),
+        token_shape.size());
 
-    auto self_kv_cache = GetInitialSelfKVCache();
+    auto self_kv_cache = GetInitialSelfKVCache(batch_size);
 
     std::array<int64_t, 1> offset_shape{1};
     Ort::Value offset = Ort::Value::CreateTensor<int64_t>(
@@ -234,32 +245,60 @@ class OfflineWhisperModel::Impl {
     cross_k = std::move(std::get<3>(decoder_out));
     cross_v = std::move(std::get<4>(decoder_out));
 
+    // (N, 1, vocab_size)
     const float *p_logits = std::get<0>(decoder_out).GetTensorData<float>();
+    int32_t vocab_size =
+        std::get<0>(decoder_out).GetTensorTypeAndShapeInfo().GetShape()[2];
     const auto &all_language_ids = GetAllLanguageIDs();
 
-    int32_t lang_id = all_language_ids[0];
-    float this_logit = p_logits[lang_id];
+    std::vector<int32_t> ans(batch_size);
+    for (int32_t b = 0; b != batch_size; ++b, p_logits += vocab_size) {
+      int32_t lang_id = all_language_ids[0];
+      float this_logit = p_logits[lang_id];
 
-    for (int32_t i = 1; i != all_language_ids.size(); ++i) {
-      int32_t id = all_language_ids[i];
-      float p = p_logits[id];
+      for (int32_t i = 1; i != all_language_ids.size(); ++i) {
+        int32_t id = all_language_ids[i];
+        float p = p_logits[id];
 
-      if (p > this_logit) {
-        this_logit = p;
-        lang_id = id;
+        if (p > this_logit) {
+          this_logit = p;
+          lang_id = id;
+        }
+      }
+
+      if (config_.debug) {
+        SHERPA_ONNX_LOGE("Detected language: %s",
+                         GetID2Lang().at(lang_id).c_str());
       }
+
+      ans[b] = lang_id;
     }
 
-    if (config_.debug) {
-      SHERPA_ONNX_LOGE("Detected language: %s",
-                       GetID2Lang().at(lang_id).c_str());
+    return ans;
+  }
+
+  std::vector<std::pair<Ort::Value, Ort::Value>> SplitEncoderOutput(
+      Ort::Value &cross_k, Ort::Value &cross_v) {  // NOLINT
+    std::vector<std::pair<Ort::Value, Ort::Value>> ans;
+    if (use_cuda_iobinding_) {
+      // cross_k and cross_v are on GPU
+      return ans;
     }
 
-    return lang_id;
+    // (n_text_layer, N, n_audio_ctx, n_text_state)
+    int32_t batch_size = cross_k.GetTensorTypeAndShapeInfo().GetShape()[1];
+    ans.reserve(batch_size);
+    for (int32_t b = 0; b != batch_size; ++b) {
+      ans.emplace_back(SliceBatch(&cross_k, b), SliceBatch(&cross_v, b));
+    }
+
+    return ans;
   }
 
-  std::pair<Ort::Value, Ort::Value> GetInitialSelfKVCache() {
-    std::array<int64_t, 4> shape{n_text_layer_, 1, n_text_ctx_, n_text_state_};
+  std::pair<Ort::Value, Ort::Value> GetInitialSelfKVCache(
+      int32_t batch_size = 1) {
+    std::array<int64_t, 4> shape{n_text_layer_, batch_size, n_text_ctx_,
+                                 n_text_state_};
 
     Ort::Value n_layer_self_k_cache = Ort::Value::CreateTensor<float>(
         Allocator(), shape.data(), shape.size());
@@ -426,6 +465,26 @@ class OfflineWhisperModel::Impl {
     }
   }
 
+  // Return v[:, b:b+1] for a 4-D tensor v
+  Ort::Value SliceBatch(const Ort::Value *v, int32_t b) {
+    std::vector<int64_t> shape = v->GetTensorTypeAndShapeInfo().GetShape();
+
+    std::array<int64_t, 4> ans_shape{shape[0], 1, shape[2], shape[3]};
+    Ort::Value ans = Ort::Value::CreateTensor<float>(
+        Allocator(), ans_shape.data(), ans_shape.size());
+
+    int64_t stride = shape[2] * shape[3];
+    const float *src = v->GetTensorData<float>() + b * stride;
+    float *dst = ans.GetTensorMutableData<float>();
+    for (int64_t i = 0; i != shape[0]; ++i) {
+      std::copy(src, src + stride, dst);
+      src += shape[1] * stride;
+      dst += stride;
+    }
+
+    return ans;
+  }
+
   void InitCudaIOBinding() {
     use_cuda_iobinding_ = (!is_cpu_provider_ && IsCudaProvider(GetProvider()));
     if (use_cuda_iobinding_) {
@@ -540,6 +599,18 @@ int32_t OfflineWhisperModel::DetectLanguage(Ort::Value &cross_k,    // NOLINT
   return impl_->DetectLanguage(cross_k, cross_v);
 }
 
+std::vector<int32_t> OfflineWhisperModel::DetectLanguages(
+    Ort::Value &cross_k,    // NOLINT
+    Ort::Value &cross_v) {  // NOLINT
+  return impl_->DetectLanguages(cross_k, cross_v);
+}
+
+std::vector<std::pair<Ort::Value, Ort::Value>>
+OfflineWhisperModel::SplitEncoderOutput(Ort::Value &cross_k,    // NOLINT
+                                        Ort::Value &cross_v) {  // NOLINT
+  return impl_->SplitEncoderOutput(cross_k, cross_v);
+}
+
 std::pair<Ort::Value, Ort::Value> OfflineWhisperModel::GetInitialSelfKVCache()
     const {
   return impl_->GetInitialSelfKVCache();
@@ -587,6 +658,11 @@ int32_t OfflineWhisperModel::TextCtx() const { return impl_->TextCtx(); }
 
 int32_t OfflineWhisperModel::VocabSize() const { return impl_->VocabSize(); }
 
+std::string OfflineWhisperModel::EncoderOutputKey(const std::string &encoder,
+                                                  int32_t num_frames) {
+  return "whisper:" + encoder + ":" + std::to_string(num_frames);
+}
+
 int32_t OfflineWhisperModel::FeatureDim() const { return impl_->FeatureDim(); }
 
 int32_t OfflineWhisperModel::Translate() const { return impl_->Translate(); }
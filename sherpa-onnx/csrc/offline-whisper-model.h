@@ -80,6 +80,28 @@ class OfflineWhisperModel {
   int32_t DetectLanguage(Ort::Value &cross_k,   // NOLINT
                          Ort::Value &cross_v);  // NOLINT
 
+  // Like DetectLanguage() but for a batch. cross_k and cross_v are
+  // from ForwardEncoder() with batch size N. Return N language IDs.
+  std::vector<int32_t> DetectLanguages(Ort::Value &cross_k,   // NOLINT
+                                       Ort::Value &cross_v);  // NOLINT
+
+  // Split cross_k and cross_v from ForwardEncoder() with batch size N
+  // into N pairs with batch size 1, e.g., to cache the output of each
+  // stream with OfflineStream::SetEncoderOutput().
+  //
+  // Return an empty vector if the tensors are not on CPU.
+  std::vector<std::pair<Ort::Value, Ort::Value>> SplitEncoderOutput(
+      Ort::Value &cross_k,   // NOLINT
+      Ort::Value &cross_v);  // NOLINT
+
+  // Return the key for caching the output of ForwardEncoder() in an
+  // OfflineStream. See OfflineStream::SetEncoderOutput().
+  //
+  // @param encoder Filename of the encoder model.
+  // @param num_frames Number of input frames, including tail paddings.
+  static std::string EncoderOutputKey(const std::string &encoder,
+                                      int32_t num_frames);
+
   /** Return the initial self kv cache in a pair
    *  - n_layer_self_k_cache A 4-D tensor of shape
    *                         (n_text_layer, N, n_audio_ctx, n_text_state).
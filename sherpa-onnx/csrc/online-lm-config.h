@@ -18,6 +18,9 @@ struct OnlineLMConfig {
   float scale = 0.5;
   int32_t lm_num_threads = 1;
   std::string lm_provider = "cpu";
+
+  // If true, the LM is loaded on first use instead of at startup
+  bool lm_lazy_init = false;
   std::string lodr_fst;
   float lodr_scale = 0.01;
   int32_t lodr_backoff_id = -1;  // -1 means not set
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -14,7 +15,55 @@
 
 namespace sherpa_onnx {
 
+namespace {
+
+// Load the LM on first use. See OnlineLMConfig::lm_lazy_init
+class LazyOnlineLM : public OnlineLM {
+ public:
+  explicit LazyOnlineLM(const OnlineLMConfig &config) : config_(config) {}
+
+  std::vector<Ort::Value> GetInitStates() override {
+    return Get()->GetInitStates();
+  }
+
+  std::pair<Ort::Value, std::vector<Ort::Value>> GetInitStatesSF() override {
+    return Get()->GetInitStatesSF();
+  }
+
+  std::pair<Ort::Value, std::vector<Ort::Value>> ScoreToken(
+      Ort::Value x, std::vector<Ort::Value> states) override {
+    return Get()->ScoreToken(std::move(x), std::move(states));
+  }
+
+  void ComputeLMScore(float scale, int32_t context_size,
+                      std::vector<Hypotheses> *hyps) override {
+    Get()->ComputeLMScore(scale, context_size, hyps);
+  }
+
+  void ComputeLMScoreSF(float scale, Hypothesis *hyp) override {
+    Get()->ComputeLMScoreSF(scale, hyp);
+  }
+
+ private:
+  OnlineLM *Get() {
+    std::call_once(init_flag_,
+                   [this]() { lm_ = std::make_unique<OnlineRnnLM>(config_); });
+    return lm_.get();
+  }
+
+ private:
+  OnlineLMConfig config_;
+  std::once_flag init_flag_;
+  std::unique_ptr<OnlineLM> lm_;
+};
+
+}  // namespace
+
 std::unique_ptr<OnlineLM> OnlineLM::Create(const OnlineLMConfig &config) {
+  if (config.lm_lazy_init) {
+    return std::make_unique<LazyOnlineLM>(config);
+  }
+
   return std::make_unique<OnlineRnnLM>(config);
 }
 
@@ -8,6 +8,7 @@
 #include <math.h>
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <utility>
@@ -51,23 +52,40 @@ class OnlinePunctuationCNNBiLSTMImpl : public OnlinePunctuationImpl {
   }
 
   std::string AddPunctuationWithCase(const std::string &text) const override {
-    if (text.empty()) {
-      return {};
-    }
+    return AddPunctuationWithCaseBatch({text})[0];
+  }
+
+  std::vector<std::string> AddPunctuationWithCaseBatch(
+      const std::vector<std::string> &texts) const override {
+    int32_t num_texts = static_cast<int32_t>(texts.size());
+    std::vector<std::string> ans(num_texts);
 
     std::vector<int32_t> tokens_list;     // N * kMaxSeqLen
     std::vector<int32_t> valids_list;     // N * kMaxSeqLen
     std::vector<int32_t> label_len_list;  // N
 
-    EncodeSentences(text, tokens_list, valids_list, label_len_list);
+    // Sentences of all texts are sent to the model in a single batch.
+    // The model returns one prediction per word.
+    std::vector<int32_t> num_words(num_texts);
+    for (int32_t i = 0; i != num_texts; ++i) {
+      if (texts[i].empty()) {
+        continue;
+      }
+
+      EncodeSentences(texts[i], tokens_list, valids_list, label_len_list);
+      num_words[i] = CountWords(texts[i]);
+    }
+
+    int32_t n = label_len_list.size();
+    if (n == 0) {
+      return ans;
+    }
 
     const auto &meta_data = model_.GetModelMetadata();
 
     auto memory_info =
         Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
 
-    int32_t n = label_len_list.size();
-
     std::array<int64_t, 2> token_ids_shape = {n, kMaxSeqLen};
     Ort::Value token_ids = Ort::Value::CreateTensor(
         memory_info, tokens_list.data(), tokens_list.size(),
@@ -109,12 +127,43 @@ class OnlinePunctuationCNNBiLSTMImpl : public OnlinePunctuationImpl {
       punct_pred.push_back(index_punct);
     }
 
-    std::string ans = DecodeSentences(text, case_pred, punct_pred);
+    int32_t offset = 0;
+    for (int32_t i = 0; i != num_texts; ++i) {
+      if (texts[i].empty()) {
+        continue;
+      }
+
+      if (offset + num_words[i] > static_cast<int32_t>(case_pred.size())) {
+        SHERPA_ONNX_LOGE("Expect at least %d predictions. Given: %d",
+                         offset + num_words[i],
+                         static_cast<int32_t>(case_pred.size()));
+        break;
+      }
+
+      std::vector<int32_t> this_case(case_pred.begin() + offset,
+                                     case_pred.begin() + offset + num_words[i]);
+      std::vector<int32_t> this_punct(
+          punct_pred.begin() + offset,
+          punct_pred.begin() + offset + num_words[i]);
+      offset += num_words[i];
+
+      ans[i] = DecodeSentences(texts[i], this_case, this_punct);
+    }
 
     return ans;
   }
 
  private:
+  static int32_t CountWords(const std::string &text) {
+    std::istringstream iss(text);
+    std::string word;
+    int32_t n = 0;
+    while (iss >> word) {
+      ++n;
+    }
+    return n;
+  }
+
   void EncodeSentences(const std::string &text,
                        std::vector<int32_t> &tokens_list,             // NOLINT
                        std::vector<int32_t> &valids_list,             // NOLINT
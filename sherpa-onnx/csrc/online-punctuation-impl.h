@@ -25,6 +25,9 @@ class OnlinePunctuationImpl {
       Manager *mgr, const OnlinePunctuationConfig &config);
 
   virtual std::string AddPunctuationWithCase(const std::string &text) const = 0;
+
+  virtual std::vector<std::string> AddPunctuationWithCaseBatch(
+      const std::vector<std::string> &texts) const = 0;
 };
 
 }  // namespace sherpa_onnx
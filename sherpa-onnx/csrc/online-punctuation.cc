@@ -5,6 +5,7 @@
 #include "sherpa-onnx/csrc/online-punctuation.h"
 
 #include <string>
+#include <vector>
 
 #if __ANDROID_API__ >= 9
 #include "android/asset_manager.h"
@@ -54,6 +55,11 @@ std::string OnlinePunctuation::AddPunctuationWithCase(
   return impl_->AddPunctuationWithCase(text);
 }
 
+std::vector<std::string> OnlinePunctuation::AddPunctuationWithCaseBatch(
+    const std::vector<std::string> &texts) const {
+  return impl_->AddPunctuationWithCaseBatch(texts);
+}
+
 #if __ANDROID_API__ >= 9
 template OnlinePunctuation::OnlinePunctuation(
     AAssetManager *mgr, const OnlinePunctuationConfig &config);
@@ -42,6 +42,11 @@ class OnlinePunctuation {
   // Add punctuation and casing to the input text and return it.
   std::string AddPunctuationWithCase(const std::string &text) const;
 
+  // Same as AddPunctuationWithCase() but for many texts, which are
+  // processed by the model together.
+  std::vector<std::string> AddPunctuationWithCaseBatch(
+      const std::vector<std::string> &texts) const;
+
  private:
   std::unique_ptr<OnlinePunctuationImpl> impl_;
 };
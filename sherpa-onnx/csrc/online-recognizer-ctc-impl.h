@@ -117,6 +117,24 @@ class OnlineRecognizerCtcImpl : public OnlineRecognizerImpl {
   }
 
   void DecodeStreams(OnlineStream **ss, int32_t n) const override {
+    // Streams in silence are not passed to the model
+    std::vector<OnlineStream *> active;
+    active.reserve(n);
+    for (int32_t i = 0; i != n; ++i) {
+      if (IsSilentChunk(ss[i], model_->ChunkLength())) {
+        SkipChunk(ss[i]);
+      } else {
+        active.push_back(ss[i]);
+      }
+    }
+
+    if (active.empty()) {
+      return;
+    }
+
+    ss = active.data();
+    n = static_cast<int32_t>(active.size());
+
     if (n == 1 || !model_->SupportBatchProcessing()) {
       for (int32_t i = 0; i != n; ++i) {
         DecodeStream(ss[i]);
@@ -253,6 +271,24 @@ class OnlineRecognizerCtcImpl : public OnlineRecognizerImpl {
   }
 
  private:
+  // Advance the stream by one chunk of silence. Model states are kept
+  // and the chunk is counted as blank frames for endpoint detection.
+  void SkipChunk(OnlineStream *s) const {
+    int32_t chunk_shift = model_->ChunkShift();
+    s->GetNumProcessedFrames() += chunk_shift;
+
+    int32_t subsampling_factor = 4;
+    if (!config_.model_config.t_one_ctc.model.empty()) {
+      subsampling_factor = 1;
+    }
+
+    int32_t num_frames = chunk_shift / subsampling_factor;
+
+    auto &r = s->GetCtcResult();
+    r.frame_offset += num_frames;
+    r.num_trailing_blanks += num_frames;
+  }
+
   void PostInit() {
     if (!config_.model_config.wenet_ctc.model.empty()) {
       // WeNet CTC models assume input samples are in the range
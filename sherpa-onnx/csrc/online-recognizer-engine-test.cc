@@ -0,0 +1,257 @@
+// sherpa-onnx/csrc/online-recognizer-engine-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/online-recognizer-engine.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sherpa-onnx/csrc/online-recognizer-impl.h"
+
+namespace sherpa_onnx {
+
+// A recognizer that outputs one token per chunk of kChunkSize frames.
+// Its result is "segment:number of tokens" and an endpoint is detected
+// after every kSegmentSize tokens.
+class StubOnlineRecognizerImpl : public OnlineRecognizerImpl {
+ public:
+  static constexpr int32_t kChunkSize = 10;
+  static constexpr int32_t kSegmentSize = 7;
+
+  StubOnlineRecognizerImpl()
+      : OnlineRecognizerImpl(OnlineRecognizerConfig{}) {}
+
+  std::unique_ptr<OnlineStream> CreateStream() const override {
+    return std::make_unique<OnlineStream>();
+  }
+
+  bool IsReady(OnlineStream *s) const override {
+    return s->NumFramesReady() - s->GetNumProcessedFrames() >= kChunkSize;
+  }
+
+  void DecodeStreams(OnlineStream **ss, int32_t n) const override {
+    for (int32_t i = 0; i != n; ++i) {
+      ss[i]->GetNumProcessedFrames() += kChunkSize;
+      ss[i]->GetResult().tokens.push_back(1);
+    }
+
+    // so that streams are decoded concurrently by different workers
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  OnlineRecognizerResult GetResult(OnlineStream *s) const override {
+    OnlineRecognizerResult r;
+    r.text = std::to_string(s->GetCurrentSegment()) + ":" +
+             std::to_string(s->GetResult().tokens.size());
+    r.segment = s->GetCurrentSegment();
+    return r;
+  }
+
+  bool IsEndpoint(OnlineStream *s) const override {
+    return static_cast<int32_t>(s->GetResult().tokens.size()) >=
+           kSegmentSize;
+  }
+
+  void Reset(OnlineStream *s) const override {
+    s->GetResult().tokens.clear();
+    s->GetCurrentSegment() += 1;
+  }
+};
+
+static std::vector<float> MakeAudio(int32_t n) {
+  std::vector<float> samples(n);
+  for (int32_t i = 0; i != n; ++i) {
+    samples[i] = ((i * 7) % 100) / 1000.0f;
+  }
+  return samples;
+}
+
+// Number of chunks the stub decodes for the given audio
+static int32_t NumChunks(const std::vector<float> &samples) {
+  OnlineStream s;
+  s.AcceptWaveform(16000, samples.data(), samples.size());
+  s.InputFinished();
+  return s.NumFramesReady() / StubOnlineRecognizerImpl::kChunkSize;
+}
+
+class OnlineRecognizerEngineTest : public ::testing::Test {
+ protected:
+  OnlineRecognizerEngineTest()
+      : recognizer_(std::make_unique<StubOnlineRecognizerImpl>()) {}
+
+  // Feed each stream from its own thread in chunks of different sizes
+  void Feed(OnlineRecognizerEngine *engine,
+            const std::vector<int32_t> &stream_ids,
+            const std::vector<std::vector<float>> &audio) {
+    std::vector<std::thread> threads;
+    for (int32_t k = 0; k != static_cast<int32_t>(stream_ids.size()); ++k) {
+      threads.emplace_back([&, k]() {
+        const auto &samples = audio[k];
+        int32_t n = static_cast<int32_t>(samples.size());
+        int32_t chunk = 800 + 160 * k;
+        for (int32_t i = 0; i < n; i += chunk) {
+          EXPECT_TRUE(engine->AcceptWaveform(stream_ids[k], 16000,
+                                             samples.data() + i,
+                                             std::min(chunk, n - i)));
+        }
+        engine->InputFinished(stream_ids[k]);
+      });
+    }
+
+    for (auto &t : threads) {
+      t.join();
+    }
+  }
+
+  // Check the events of a stream and return the number of decoded chunks
+  static int32_t Check(
+      const std::vector<OnlineRecognizerEngineEvent> &events) {
+    EXPECT_FALSE(events.empty());
+    if (events.empty()) {
+      return 0;
+    }
+
+    int32_t num_chunks = 0;
+    int32_t last_segment = 0;
+    int32_t last_count = 0;
+    for (int32_t i = 0; i != static_cast<int32_t>(events.size()); ++i) {
+      const auto &e = events[i];
+
+      // is_final is set only for the last event
+      EXPECT_EQ(e.is_final, i + 1 == static_cast<int32_t>(events.size()));
+
+      int32_t segment = std::stoi(e.result.text);
+      int32_t count =
+          std::stoi(e.result.text.substr(e.result.text.find(':') + 1));
+
+      // results of a stream arrive in order
+      EXPECT_TRUE(segment > last_segment ||
+                  (segment == last_segment && count >= last_count))
+          << e.result.text;
+
+      if (e.is_endpoint) {
+        EXPECT_EQ(count, StubOnlineRecognizerImpl::kSegmentSize);
+        num_chunks += count;
+        last_segment = segment + 1;
+        last_count = 0;
+      } else {
+        last_segment = segment;
+        last_count = count;
+      }
+
+      if (e.is_final) {
+        num_chunks += count;
+      }
+    }
+
+    return num_chunks;
+  }
+
+  OnlineRecognizer recognizer_;
+};
+
+TEST_F(OnlineRecognizerEngineTest, Callback) {
+  std::mutex mutex;
+  std::map<int32_t, std::vector<OnlineRecognizerEngineEvent>> events;
+
+  OnlineRecognizerEngine engine(
+      &recognizer_, {4, 3},
+      [&](const OnlineRecognizerEngineEvent &e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events[e.stream_id].push_back(e);
+      });
+
+  std::vector<std::vector<float>> audio;
+  std::vector<int32_t> stream_ids;
+  for (int32_t k = 0; k != 6; ++k) {
+    audio.push_back(MakeAudio(16000 + 4000 * k));
+    stream_ids.push_back(engine.AddStream());
+  }
+
+  Feed(&engine, stream_ids, audio);
+  engine.Wait();
+
+  // Wait() returns after the final event of every stream
+  EXPECT_EQ(engine.NumStreams(), 0);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(events.size(), stream_ids.size());
+  for (int32_t k = 0; k != static_cast<int32_t>(stream_ids.size()); ++k) {
+    EXPECT_EQ(Check(events[stream_ids[k]]), NumChunks(audio[k]));
+  }
+}
+
+TEST_F(OnlineRecognizerEngineTest, GetEvent) {
+  OnlineRecognizerEngine engine(&recognizer_, {2, 4});
+
+  std::vector<std::vector<float>> audio;
+  std::vector<int32_t> stream_ids;
+  for (int32_t k = 0; k != 4; ++k) {
+    audio.push_back(MakeAudio(24000 + 8000 * k));
+    stream_ids.push_back(engine.AddStream());
+  }
+
+  Feed(&engine, stream_ids, audio);
+
+  std::map<int32_t, std::vector<OnlineRecognizerEngineEvent>> events;
+  int32_t num_final = 0;
+  OnlineRecognizerEngineEvent e;
+  while (num_final < static_cast<int32_t>(stream_ids.size()) &&
+         engine.GetEvent(&e, 5000)) {
+    num_final += e.is_final;
+    events[e.stream_id].push_back(std::move(e));
+  }
+
+  ASSERT_EQ(num_final, static_cast<int32_t>(stream_ids.size()));
+
+  // no more events after the final ones
+  EXPECT_FALSE(engine.GetEvent(&e, 10));
+
+  for (int32_t k = 0; k != static_cast<int32_t>(stream_ids.size()); ++k) {
+    EXPECT_EQ(Check(events[stream_ids[k]]), NumChunks(audio[k]));
+  }
+
+  // a finished stream is removed
+  EXPECT_FALSE(engine.AcceptWaveform(stream_ids[0], 16000,
+                                     audio[0].data(), 100));
+}
+
+TEST_F(OnlineRecognizerEngineTest, Destruction) {
+  std::mutex mutex;
+  std::map<int32_t, std::vector<OnlineRecognizerEngineEvent>> events;
+
+  std::vector<std::vector<float>> audio;
+  std::vector<int32_t> stream_ids;
+  {
+    OnlineRecognizerEngine engine(
+        &recognizer_, {3, 2},
+        [&](const OnlineRecognizerEngineEvent &e) {
+          std::lock_guard<std::mutex> lock(mutex);
+          events[e.stream_id].push_back(e);
+        });
+
+    for (int32_t k = 0; k != 5; ++k) {
+      audio.push_back(MakeAudio(32000 + 1600 * k));
+      stream_ids.push_back(engine.AddStream());
+    }
+
+    // the engine is destroyed without calling Wait()
+    Feed(&engine, stream_ids, audio);
+  }
+
+  ASSERT_EQ(events.size(), stream_ids.size());
+  for (int32_t k = 0; k != static_cast<int32_t>(stream_ids.size()); ++k) {
+    EXPECT_EQ(Check(events[stream_ids[k]]), NumChunks(audio[k]));
+  }
+}
+
+}  // namespace sherpa_onnx
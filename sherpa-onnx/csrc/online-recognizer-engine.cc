@@ -0,0 +1,412 @@
+// sherpa-onnx/csrc/online-recognizer-engine.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/online-recognizer-engine.h"
+
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sherpa-onnx/csrc/macros.h"
+
+namespace sherpa_onnx {
+
+bool OnlineRecognizerEngineConfig::Validate() const {
+  if (num_workers < 1) {
+    SHERPA_ONNX_LOGE("num_workers should be >= 1. Given: %d", num_workers);
+    return false;
+  }
+
+  if (max_batch_size < 1) {
+    SHERPA_ONNX_LOGE("max_batch_size should be >= 1. Given: %d",
+                     max_batch_size);
+    return false;
+  }
+
+  return true;
+}
+
+std::string OnlineRecognizerEngineConfig::ToString() const {
+  std::ostringstream os;
+
+  os << "OnlineRecognizerEngineConfig(";
+  os << "num_workers=" << num_workers << ", ";
+  os << "max_batch_size=" << max_batch_size << ")";
+
+  return os.str();
+}
+
+class OnlineRecognizerEngine::Impl {
+ public:
+  Impl(const OnlineRecognizer *recognizer,
+       const OnlineRecognizerEngineConfig &config,
+       OnlineRecognizerEngineCallback callback)
+      : recognizer_(recognizer),
+        config_(config),
+        callback_(std::move(callback)) {
+    if (!config_.Validate()) {
+      SHERPA_ONNX_EXIT(-1);
+    }
+
+    workers_.reserve(config_.num_workers);
+    for (int32_t i = 0; i != config_.num_workers; ++i) {
+      workers_.emplace_back([this]() { Worker(); });
+    }
+  }
+
+  ~Impl() {
+    Wait();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto &t : workers_) {
+      t.join();
+    }
+  }
+
+  int32_t AddStream(const std::string &hotwords) {
+    auto stream = std::make_shared<Stream>();
+    stream->s = hotwords.empty() ? recognizer_->CreateStream()
+                                 : recognizer_->CreateStream(hotwords);
+
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    stream->id = next_stream_id_++;
+    streams_[stream->id] = stream;
+
+    return stream->id;
+  }
+
+  bool AcceptWaveform(int32_t stream_id, int32_t sample_rate,
+                      const float *samples, int32_t n) {
+    auto stream = GetStream(stream_id);
+    if (!stream) {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (stream->input_finished) {
+      SHERPA_ONNX_LOGE("Stream %d has been finished", stream_id);
+      return false;
+    }
+
+    stream->chunks.push_back({sample_rate, std::vector<float>(samples,
+                                                              samples + n)});
+    Schedule(stream);
+
+    return true;
+  }
+
+  void InputFinished(int32_t stream_id) {
+    auto stream = GetStream(stream_id);
+    if (!stream) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (stream->input_finished) {
+      return;
+    }
+
+    stream->input_finished = true;
+    Schedule(stream);
+  }
+
+  bool GetEvent(OnlineRecognizerEngineEvent *event, int32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(events_mutex_);
+    auto has_event = [this]() { return !events_.empty(); };
+
+    if (timeout_ms < 0) {
+      events_cv_.wait(lock, has_event);
+    } else if (!events_cv_.wait_for(lock,
+                                    std::chrono::milliseconds(timeout_ms),
+                                    has_event)) {
+      return false;
+    }
+
+    *event = std::move(events_.front());
+    events_.pop_front();
+
+    return true;
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return num_scheduled_ == 0; });
+  }
+
+  int32_t NumStreams() const {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    return static_cast<int32_t>(streams_.size());
+  }
+
+  const OnlineRecognizerEngineConfig &GetConfig() const { return config_; }
+
+ private:
+  struct Chunk {
+    int32_t sample_rate = 0;
+    std::vector<float> samples;
+  };
+
+  struct Stream {
+    int32_t id = 0;
+
+    // Only the worker that has taken this stream from the queue uses it
+    std::unique_ptr<OnlineStream> s;
+    std::string last_text;
+    bool finished = false;  // true if s->InputFinished() has been called
+
+    // The following members are protected by mutex
+    std::mutex mutex;
+    std::vector<Chunk> chunks;  // audio not yet passed to s
+    bool input_finished = false;
+    bool scheduled = false;  // true if queued or being decoded
+  };
+
+  std::shared_ptr<Stream> GetStream(int32_t stream_id) const {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+      SHERPA_ONNX_LOGE("Unknown stream: %d", stream_id);
+      return nullptr;
+    }
+
+    return it->second;
+  }
+
+  void RemoveStream(int32_t stream_id) {
+    std::lock_guard<std::mutex> lock(streams_mutex_);
+    streams_.erase(stream_id);
+  }
+
+  // Must be called with stream->mutex held
+  void Schedule(const std::shared_ptr<Stream> &stream) {
+    if (stream->scheduled) {
+      return;
+    }
+    stream->scheduled = true;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(stream);
+      ++num_scheduled_;
+    }
+    cv_.notify_one();
+  }
+
+  // Must be called with stream->mutex held
+  void Requeue(std::shared_ptr<Stream> stream) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(stream));
+    }
+    cv_.notify_one();
+  }
+
+  void Unschedule() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --num_scheduled_;
+    if (num_scheduled_ == 0) {
+      done_cv_.notify_all();
+    }
+  }
+
+  // Pass buffered audio to the stream
+  void Feed(Stream *stream) {
+    std::vector<Chunk> chunks;
+    bool input_finished = false;
+    {
+      std::lock_guard<std::mutex> lock(stream->mutex);
+      chunks.swap(stream->chunks);
+      input_finished = stream->input_finished;
+    }
+
+    for (const auto &c : chunks) {
+      stream->s->AcceptWaveform(c.sample_rate, c.samples.data(),
+                                c.samples.size());
+    }
+
+    if (input_finished && !stream->finished) {
+      stream->s->InputFinished();
+      stream->finished = true;
+    }
+  }
+
+  void Emit(OnlineRecognizerEngineEvent event) {
+    if (callback_) {
+      callback_(event);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(events_mutex_);
+      events_.push_back(std::move(event));
+    }
+    events_cv_.notify_one();
+  }
+
+  // Emit an event if the result has changed or an endpoint is detected
+  void Update(Stream *stream) {
+    OnlineStream *s = stream->s.get();
+
+    bool is_endpoint = recognizer_->IsEndpoint(s);
+    auto result = recognizer_->GetResult(s);
+    if (!is_endpoint && result.text == stream->last_text) {
+      return;
+    }
+
+    OnlineRecognizerEngineEvent event;
+    event.stream_id = stream->id;
+    event.is_endpoint = is_endpoint;
+
+    if (is_endpoint) {
+      recognizer_->Reset(s);
+      stream->last_text.clear();
+    } else {
+      stream->last_text = result.text;
+    }
+
+    event.result = std::move(result);
+    Emit(std::move(event));
+  }
+
+  void Worker() {
+    while (true) {
+      std::vector<std::shared_ptr<Stream>> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+          return;
+        }
+
+        while (!queue_.empty() &&
+               static_cast<int32_t>(batch.size()) < config_.max_batch_size) {
+          batch.push_back(std::move(queue_.front()));
+          queue_.pop_front();
+        }
+      }
+
+      std::vector<OnlineStream *> ss;
+      ss.reserve(batch.size());
+      for (auto &stream : batch) {
+        Feed(stream.get());
+        if (recognizer_->IsReady(stream->s.get())) {
+          ss.push_back(stream->s.get());
+        }
+      }
+
+      if (!ss.empty()) {
+        recognizer_->DecodeStreams(ss.data(), ss.size());
+      }
+
+      for (auto &stream : batch) {
+        Update(stream.get());
+        Finish(std::move(stream));
+      }
+    }
+  }
+
+  // Put the stream back into the queue if it has more to decode;
+  // otherwise release it.
+  void Finish(std::shared_ptr<Stream> stream) {
+    bool ready = recognizer_->IsReady(stream->s.get());
+
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    if (ready || !stream->chunks.empty() ||
+        (stream->input_finished && !stream->finished)) {
+      Requeue(std::move(stream));
+      return;
+    }
+
+    stream->scheduled = false;
+
+    if (stream->finished) {
+      lock.unlock();
+
+      OnlineRecognizerEngineEvent event;
+      event.stream_id = stream->id;
+      event.result = recognizer_->GetResult(stream->s.get());
+      event.is_final = true;
+
+      RemoveStream(stream->id);
+      Emit(std::move(event));
+    }
+
+    Unschedule();
+  }
+
+ private:
+  const OnlineRecognizer *recognizer_;
+  OnlineRecognizerEngineConfig config_;
+  OnlineRecognizerEngineCallback callback_;
+
+  mutable std::mutex streams_mutex_;
+  std::unordered_map<int32_t, std::shared_ptr<Stream>> streams_;
+  int32_t next_stream_id_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable done_cv_;
+  std::deque<std::shared_ptr<Stream>> queue_;
+  int32_t num_scheduled_ = 0;  // number of streams queued or being decoded
+  bool stop_ = false;
+
+  std::mutex events_mutex_;
+  std::condition_variable events_cv_;
+  std::deque<OnlineRecognizerEngineEvent> events_;
+
+  std::vector<std::thread> workers_;
+};
+
+OnlineRecognizerEngine::OnlineRecognizerEngine(
+    const OnlineRecognizer *recognizer,
+    const OnlineRecognizerEngineConfig &config,
+    OnlineRecognizerEngineCallback callback /*= {}*/)
+    : impl_(std::make_unique<Impl>(recognizer, config, std::move(callback))) {}
+
+OnlineRecognizerEngine::~OnlineRecognizerEngine() = default;
+
+int32_t OnlineRecognizerEngine::AddStream(
+    const std::string &hotwords /*= {}*/) {
+  return impl_->AddStream(hotwords);
+}
+
+bool OnlineRecognizerEngine::AcceptWaveform(int32_t stream_id,
+                                            int32_t sample_rate,
+                                            const float *samples, int32_t n) {
+  return impl_->AcceptWaveform(stream_id, sample_rate, samples, n);
+}
+
+void OnlineRecognizerEngine::InputFinished(int32_t stream_id) {
+  impl_->InputFinished(stream_id);
+}
+
+bool OnlineRecognizerEngine::GetEvent(OnlineRecognizerEngineEvent *event,
+                                      int32_t timeout_ms) {
+  return impl_->GetEvent(event, timeout_ms);
+}
+
+void OnlineRecognizerEngine::Wait() { impl_->Wait(); }
+
+int32_t OnlineRecognizerEngine::NumStreams() const {
+  return impl_->NumStreams();
+}
+
+const OnlineRecognizerEngineConfig &OnlineRecognizerEngine::GetConfig() const {
+  return impl_->GetConfig();
+}
+
+}  // namespace sherpa_onnx
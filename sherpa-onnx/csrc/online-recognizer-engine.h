@@ -0,0 +1,107 @@
+// sherpa-onnx/csrc/online-recognizer-engine.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#ifndef SHERPA_ONNX_CSRC_ONLINE_RECOGNIZER_ENGINE_H_
+#define SHERPA_ONNX_CSRC_ONLINE_RECOGNIZER_ENGINE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "sherpa-onnx/csrc/online-recognizer.h"
+
+namespace sherpa_onnx {
+
+struct OnlineRecognizerEngineConfig {
+  // Number of threads decoding streams
+  int32_t num_workers = 1;
+
+  // Maximum number of streams decoded together
+  int32_t max_batch_size = 32;
+
+  OnlineRecognizerEngineConfig() = default;
+
+  OnlineRecognizerEngineConfig(int32_t num_workers, int32_t max_batch_size)
+      : num_workers(num_workers), max_batch_size(max_batch_size) {}
+
+  bool Validate() const;
+
+  std::string ToString() const;
+};
+
+struct OnlineRecognizerEngineEvent {
+  int32_t stream_id = 0;
+
+  OnlineRecognizerResult result;
+
+  // true if an endpoint is detected. The stream is reset after the event
+  // so the next result starts from an empty text.
+  bool is_endpoint = false;
+
+  // true for the last event of a stream. The stream is removed from the
+  // engine after it.
+  bool is_final = false;
+};
+
+// Invoked from a worker thread. For a given stream, events are delivered
+// in order and never concurrently.
+using OnlineRecognizerEngineCallback =
+    std::function<void(const OnlineRecognizerEngineEvent &event)>;
+
+// It decodes many streams with a shared OnlineRecognizer on a pool of
+// worker threads. Streams with enough feature frames are decoded together
+// with OnlineRecognizer::DecodeStreams().
+//
+// Audio is only buffered by AcceptWaveform() and InputFinished(), so they
+// return immediately. An event is generated when the result of a stream
+// changes, when an endpoint is detected and when a stream is finished.
+// Events are passed to the callback if one is given; otherwise they are
+// queued and can be retrieved with GetEvent().
+//
+// All methods can be called from any thread.
+class OnlineRecognizerEngine {
+ public:
+  // @param recognizer It must outlive this object.
+  OnlineRecognizerEngine(const OnlineRecognizer *recognizer,
+                         const OnlineRecognizerEngineConfig &config,
+                         OnlineRecognizerEngineCallback callback = {});
+
+  // It waits until all streams with pending audio are decoded
+  ~OnlineRecognizerEngine();
+
+  // Return the ID of the new stream.
+  int32_t AddStream(const std::string &hotwords = {});
+
+  // Return false if there is no stream with the given ID, e.g., if
+  // InputFinished() has been called for it.
+  bool AcceptWaveform(int32_t stream_id, int32_t sample_rate,
+                      const float *samples, int32_t n);
+
+  // Call it when there is no more audio for the given stream. The last
+  // event of the stream has is_final set.
+  void InputFinished(int32_t stream_id);
+
+  // Retrieve the next queued event. It is used only if no callback is
+  // given.
+  //
+  // @param timeout_ms Wait at most this number of milliseconds for an
+  //                   event. Wait forever if it is negative.
+  // @return Return false if there is no event.
+  bool GetEvent(OnlineRecognizerEngineEvent *event, int32_t timeout_ms);
+
+  // Block until all audio received so far is decoded.
+  void Wait();
+
+  // Return the number of streams that have not been finished.
+  int32_t NumStreams() const;
+
+  const OnlineRecognizerEngineConfig &GetConfig() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_ONLINE_RECOGNIZER_ENGINE_H_
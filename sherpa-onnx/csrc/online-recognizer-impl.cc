@@ -4,6 +4,7 @@
 
 #include "sherpa-onnx/csrc/online-recognizer-impl.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -331,24 +332,59 @@ OnlineRecognizerImpl::OnlineRecognizerImpl(Manager *mgr,
 
 std::string OnlineRecognizerImpl::ApplyInverseTextNormalization(
     std::string text) const {
-  text = RemoveInvalidUtf8Sequences(text);
+  if (itn_list_.empty()) {
+    return RemoveInvalidUtf8Sequences(text);
+  }
 
-  if (!itn_list_.empty()) {
-    for (const auto &tn : itn_list_) {
-      text = tn->Normalize(text);
-    }
+  // The same text is often normalized again, e.g., partial results of
+  // a stream or common short utterances, so results are memoized.
+  std::string ans;
+  if (itn_cache_.Get(text, &ans)) {
+    return ans;
+  }
+
+  ans = RemoveInvalidUtf8Sequences(text);
+  for (const auto &tn : itn_list_) {
+    ans = tn->Normalize(ans);
   }
 
-  return text;
+  itn_cache_.Put(text, ans);
+
+  return ans;
 }
 
 std::string OnlineRecognizerImpl::ApplyHomophoneReplacer(
     std::string text) const {
-  if (hr_) {
-    text = hr_->Apply(text);
+  if (!hr_) {
+    return text;
+  }
+
+  std::string ans;
+  if (hr_cache_.Get(text, &ans)) {
+    return ans;
   }
 
-  return text;
+  ans = hr_->Apply(text);
+  hr_cache_.Put(text, ans);
+
+  return ans;
+}
+
+bool OnlineRecognizerImpl::IsSilentChunk(OnlineStream *s,
+                                         int32_t chunk_size) const {
+  if (!s->HasOption("silence_threshold_db")) {
+    return false;
+  }
+
+  float threshold = s->GetOptionFloat("silence_threshold_db", -100);
+
+  // The chunk before the current one is also checked so that the encoder
+  // still sees the audio right after speech, e.g., to emit the last tokens
+  int32_t num_processed_frames = s->GetNumProcessedFrames();
+  int32_t start = std::max(0, num_processed_frames - chunk_size);
+
+  return s->GetMaxEnergyDb(start, num_processed_frames + chunk_size - start) <
+         threshold;
 }
 
 #if __ANDROID_API__ >= 9
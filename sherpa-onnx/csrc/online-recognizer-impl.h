@@ -11,6 +11,7 @@
 
 #include "kaldifst/csrc/text-normalizer.h"
 #include "sherpa-onnx/csrc/homophone-replacer.h"
+#include "sherpa-onnx/csrc/lru-cache.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/online-recognizer.h"
 #include "sherpa-onnx/csrc/online-stream.h"
@@ -60,6 +61,12 @@ class OnlineRecognizerImpl {
   std::string ApplyInverseTextNormalization(std::string text) const;
   std::string ApplyHomophoneReplacer(std::string text) const;
 
+  // Return true if the stream has the option "silence_threshold_db" and
+  // the energy of its audio stays below it for the next chunk of
+  // chunk_size frames and for the chunk before it. Such a chunk
+  // contains no speech and can be skipped without running the encoder.
+  bool IsSilentChunk(OnlineStream *s, int32_t chunk_size) const;
+
  private:
   OnlineRecognizerConfig config_;
   // for inverse text normalization. Used only if
@@ -67,6 +74,13 @@ class OnlineRecognizerImpl {
   // config.rule_fars is not empty
   std::vector<std::unique_ptr<kaldifst::TextNormalizer>> itn_list_;
   std::unique_ptr<HomophoneReplacer> hr_;
+
+  // Number of memoized results of ITN and of the homophone replacer
+  static constexpr size_t kPostProcessingCacheCapacity = 1000;
+  mutable LruCache<std::string, std::string> itn_cache_{
+      kPostProcessingCacheCapacity};
+  mutable LruCache<std::string, std::string> hr_cache_{
+      kPostProcessingCacheCapacity};
 };
 
 }  // namespace sherpa_onnx
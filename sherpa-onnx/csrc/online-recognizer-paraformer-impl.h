@@ -6,12 +6,15 @@
 #define SHERPA_ONNX_CSRC_ONLINE_RECOGNIZER_PARAFORMER_IMPL_H_
 
 #include <algorithm>
+#include <array>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "Eigen/Dense"
+#include "sherpa-onnx/csrc/cat.h"
 #include "sherpa-onnx/csrc/file-utils.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/online-lm.h"
@@ -20,6 +23,7 @@
 #include "sherpa-onnx/csrc/online-recognizer-impl.h"
 #include "sherpa-onnx/csrc/online-recognizer.h"
 #include "sherpa-onnx/csrc/symbol-table.h"
+#include "sherpa-onnx/csrc/unbind.h"
 
 namespace sherpa_onnx {
 
@@ -80,6 +84,33 @@ static OnlineRecognizerResult Convert(const OnlineParaformerDecoderResult &src,
   return r;
 }
 
+// Select rows of a tensor along the first axis
+template <typename T>
+static Ort::Value GatherRows(OrtAllocator *allocator, const Ort::Value &src,
+                             const std::vector<int32_t> &indexes) {
+  std::vector<int64_t> shape = src.GetTensorTypeAndShapeInfo().GetShape();
+
+  int64_t row_size = 1;
+  for (size_t i = 1; i < shape.size(); ++i) {
+    row_size *= shape[i];
+  }
+
+  shape[0] = indexes.size();
+
+  Ort::Value ans =
+      Ort::Value::CreateTensor<T>(allocator, shape.data(), shape.size());
+
+  const T *p_src = src.GetTensorData<T>();
+  T *p_dst = ans.GetTensorMutableData<T>();
+
+  for (auto i : indexes) {
+    std::copy(p_src + i * row_size, p_src + (i + 1) * row_size, p_dst);
+    p_dst += row_size;
+  }
+
+  return ans;
+}
+
 // y[i] += x[i] * scale
 static void ScaleAddInPlace(const float *x, int32_t n, float scale, float *y) {
   for (int32_t i = 0; i != n; ++i) {
@@ -169,9 +200,105 @@ class OnlineRecognizerParaformerImpl : public OnlineRecognizerImpl {
   }
 
   void DecodeStreams(OnlineStream **ss, int32_t n) const override {
-    // TODO(fangjun): Support batch size > 1
+    if (n <= 0) {
+      return;
+    }
+
+    int32_t feat_dim = model_.NegativeMean().size();
+    int32_t cache_size = (left_chunk_size_ + right_chunk_size_) * feat_dim;
+
+    // chunk_start[i] is the number of processed frames of ss[i] before
+    // the current chunk
+    std::vector<int32_t> chunk_start(n);
+
+    // Every chunk has the same number of frames since the final short chunk
+    // is padded, so chunks from all streams are stacked into (n, T, feat_dim)
+    std::vector<float> features;
+    int32_t num_frames = 0;
+
     for (int32_t i = 0; i != n; ++i) {
-      DecodeStream(ss[i]);
+      chunk_start[i] = ss[i]->GetNumProcessedFrames();
+
+      std::vector<float> frames = GetChunkFeatures(ss[i]);
+
+      std::vector<float> &feat_cache = ss[i]->GetParaformerFeatCache();
+      if (feat_cache.empty()) {
+        feat_cache.resize(cache_size, 0);
+      }
+
+      if (i == 0) {
+        num_frames = (feat_cache.size() + frames.size()) / feat_dim;
+        features.reserve(static_cast<size_t>(n) * num_frames * feat_dim);
+      }
+
+      // add overlap chunk
+      features.insert(features.end(), feat_cache.begin(), feat_cache.end());
+      features.insert(features.end(), frames.begin(), frames.end());
+
+      // A chunk has more frames than the cache, so the last frames
+      // come from the current chunk only
+      std::copy(frames.end() - feat_cache.size(), frames.end(),
+                feat_cache.begin());
+    }
+
+    auto memory_info =
+        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+
+    std::array<int64_t, 3> x_shape{n, num_frames, feat_dim};
+    Ort::Value x =
+        Ort::Value::CreateTensor(memory_info, features.data(), features.size(),
+                                 x_shape.data(), x_shape.size());
+
+    std::vector<int32_t> x_len_val(n, num_frames);
+    int64_t x_len_shape = n;
+
+    Ort::Value x_length = Ort::Value::CreateTensor(
+        memory_info, x_len_val.data(), n, &x_len_shape, 1);
+
+    auto encoder_out_vec =
+        model_.ForwardEncoder(std::move(x), std::move(x_length));
+
+    // CIF search
+    auto &encoder_out = encoder_out_vec[0];
+    auto &encoder_out_len = encoder_out_vec[1];
+    auto &alpha = encoder_out_vec[2];
+
+    float *p_alpha = alpha.GetTensorMutableData<float>();
+
+    std::vector<int64_t> alpha_shape =
+        alpha.GetTensorTypeAndShapeInfo().GetShape();
+
+    const float *p_encoder_out = encoder_out.GetTensorData<float>();
+
+    std::vector<int64_t> encoder_out_shape =
+        encoder_out.GetTensorTypeAndShapeInfo().GetShape();
+
+    int32_t T = encoder_out_shape[1];
+    int32_t C = encoder_out_shape[2];
+
+    std::vector<std::vector<float>> acoustic_embeddings(n);
+
+    // The decoder takes its FSMN caches from the last acoustic embeddings,
+    // so we cannot pad them. Instead, streams that fired the same number of
+    // tokens are decoded together. Streams that fired nothing skip the
+    // decoder.
+    std::map<int32_t, std::vector<int32_t>> groups;
+
+    for (int32_t i = 0; i != n; ++i) {
+      acoustic_embeddings[i] = ComputeAcousticEmbedding(
+          ss[i], p_encoder_out + i * T * C, p_alpha + i * alpha_shape[1], T,
+          C);
+
+      int32_t num_tokens = acoustic_embeddings[i].size() / C;
+      if (num_tokens > 0) {
+        InitDecoderStates(ss[i]);
+        groups[num_tokens].push_back(i);
+      }
+    }
+
+    for (const auto &p : groups) {
+      RunDecoder(ss, p.second, p.first, encoder_out, encoder_out_len,
+                 acoustic_embeddings, chunk_start);
     }
   }
 
@@ -234,7 +361,7 @@ class OnlineRecognizerParaformerImpl : public OnlineRecognizerImpl {
     config_.feat_config.snip_edges = true;
   }
 
-  void DecodeStream(OnlineStream *s) const {
+  std::vector<float> GetChunkFeatures(OnlineStream *s) const {
     const auto num_processed_frames = s->GetNumProcessedFrames();
     int32_t available_frames = s->NumFramesReady() - num_processed_frames;
     bool is_final = s->GetOptionInt("is_final", 0);
@@ -261,64 +388,29 @@ class OnlineRecognizerParaformerImpl : public OnlineRecognizerImpl {
     ApplyCMVN(&frames);
     PositionalEncoding(&frames, num_processed_frames / model_.LfrWindowShift());
 
-    int32_t feat_dim = model_.NegativeMean().size();
-
     // We have scaled inv_stddev by sqrt(encoder_output_size)
     // so the following line can be commented out
     // frames *= encoder_output_size ** 0.5
 
-    // add overlap chunk
-    std::vector<float> &feat_cache = s->GetParaformerFeatCache();
-    if (feat_cache.empty()) {
-      int32_t n = (left_chunk_size_ + right_chunk_size_) * feat_dim;
-      feat_cache.resize(n, 0);
-    }
-
-    frames.insert(frames.begin(), feat_cache.begin(), feat_cache.end());
-    std::copy(frames.end() - feat_cache.size(), frames.end(),
-              feat_cache.begin());
-
-    int32_t num_frames = frames.size() / feat_dim;
-
-    auto memory_info =
-        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
-
-    std::array<int64_t, 3> x_shape{1, num_frames, feat_dim};
-    Ort::Value x =
-        Ort::Value::CreateTensor(memory_info, frames.data(), frames.size(),
-                                 x_shape.data(), x_shape.size());
-
-    int64_t x_len_shape = 1;
-    int32_t x_len_val = num_frames;
-
-    Ort::Value x_length =
-        Ort::Value::CreateTensor(memory_info, &x_len_val, 1, &x_len_shape, 1);
-
-    auto encoder_out_vec =
-        model_.ForwardEncoder(std::move(x), std::move(x_length));
-
-    // CIF search
-    auto &encoder_out = encoder_out_vec[0];
-    auto &encoder_out_len = encoder_out_vec[1];
-    auto &alpha = encoder_out_vec[2];
-
-    float *p_alpha = alpha.GetTensorMutableData<float>();
-
-    std::vector<int64_t> alpha_shape =
-        alpha.GetTensorTypeAndShapeInfo().GetShape();
+    return frames;
+  }
 
+  // CIF search for one stream.
+  //
+  // @param p_encoder_out Pointer to a 2-D array of shape (T, C)
+  // @param p_alpha Pointer to a 1-D array of shape (T,). It is changed
+  //                in-place.
+  // @return Return the fired acoustic embeddings of shape (num_tokens, C)
+  std::vector<float> ComputeAcousticEmbedding(OnlineStream *s,
+                                              const float *p_encoder_out,
+                                              float *p_alpha, int32_t T,
+                                              int32_t C) const {
     std::fill(p_alpha, p_alpha + left_chunk_size_, 0);
-    std::fill(p_alpha + alpha_shape[1] - right_chunk_size_,
-              p_alpha + alpha_shape[1], 0);
-
-    const float *p_encoder_out = encoder_out.GetTensorData<float>();
-
-    std::vector<int64_t> encoder_out_shape =
-        encoder_out.GetTensorTypeAndShapeInfo().GetShape();
+    std::fill(p_alpha + T - right_chunk_size_, p_alpha + T, 0);
 
     std::vector<float> &initial_hidden = s->GetParaformerEncoderOutCache();
     if (initial_hidden.empty()) {
-      initial_hidden.resize(encoder_out_shape[2]);
+      initial_hidden.resize(C);
     }
 
     std::vector<float> &alpha_cache = s->GetParaformerAlphaCache();
@@ -327,103 +419,179 @@ class OnlineRecognizerParaformerImpl : public OnlineRecognizerImpl {
     }
 
     std::vector<float> acoustic_embedding;
-    acoustic_embedding.reserve(encoder_out_shape[1] * encoder_out_shape[2]);
+    acoustic_embedding.reserve(T * C);
 
     float threshold = 1.0;
 
     float integrate = alpha_cache[0];
 
-    for (int32_t i = 0; i != encoder_out_shape[1]; ++i) {
+    for (int32_t i = 0; i != T; ++i) {
       float this_alpha = p_alpha[i];
       if (integrate + this_alpha < threshold) {
         integrate += this_alpha;
-        ScaleAddInPlace(p_encoder_out + i * encoder_out_shape[2],
-                        encoder_out_shape[2], this_alpha,
+        ScaleAddInPlace(p_encoder_out + i * C, C, this_alpha,
                         initial_hidden.data());
         continue;
       }
 
       // fire
-      ScaleAddInPlace(p_encoder_out + i * encoder_out_shape[2],
-                      encoder_out_shape[2], threshold - integrate,
+      ScaleAddInPlace(p_encoder_out + i * C, C, threshold - integrate,
                       initial_hidden.data());
       acoustic_embedding.insert(acoustic_embedding.end(),
                                 initial_hidden.begin(), initial_hidden.end());
       integrate += this_alpha - threshold;
 
-      Scale(p_encoder_out + i * encoder_out_shape[2], encoder_out_shape[2],
-            integrate, initial_hidden.data());
+      Scale(p_encoder_out + i * C, C, integrate, initial_hidden.data());
     }
 
     alpha_cache[0] = integrate;
 
-    if (acoustic_embedding.empty()) {
+    return acoustic_embedding;
+  }
+
+  void InitDecoderStates(OnlineStream *s) const {
+    auto &states = s->GetStates();
+    if (!states.empty()) {
       return;
     }
 
-    auto &states = s->GetStates();
-    if (states.empty()) {
-      states.reserve(model_.DecoderNumBlocks());
+    states.reserve(model_.DecoderNumBlocks());
 
-      std::array<int64_t, 3> shape{1, model_.EncoderOutputSize(),
-                                   model_.DecoderKernelSize() - 1};
+    std::array<int64_t, 3> shape{1, model_.EncoderOutputSize(),
+                                 model_.DecoderKernelSize() - 1};
 
-      int32_t num_bytes = sizeof(float) * shape[0] * shape[1] * shape[2];
+    int32_t num_bytes = sizeof(float) * shape[0] * shape[1] * shape[2];
 
-      for (int32_t i = 0; i != model_.DecoderNumBlocks(); ++i) {
-        Ort::Value this_state = Ort::Value::CreateTensor<float>(
-            model_.Allocator(), shape.data(), shape.size());
+    for (int32_t i = 0; i != model_.DecoderNumBlocks(); ++i) {
+      Ort::Value this_state = Ort::Value::CreateTensor<float>(
+          model_.Allocator(), shape.data(), shape.size());
 
-        memset(this_state.GetTensorMutableData<float>(), 0, num_bytes);
+      memset(this_state.GetTensorMutableData<float>(), 0, num_bytes);
 
-        states.push_back(std::move(this_state));
-      }
+      states.push_back(std::move(this_state));
     }
+  }
+
+  // Run the decoder for streams that fired the same number of tokens
+  // in the current chunk.
+  //
+  // @param ss All streams of this batch.
+  // @param indexes Indexes into ss of the streams to decode.
+  // @param num_tokens Number of tokens fired by each of the selected streams.
+  // @param encoder_out A 3-D tensor of shape (N, T, C) for all streams
+  // @param encoder_out_len A 1-D tensor of shape (N,) for all streams
+  // @param acoustic_embeddings acoustic_embeddings[i] is for ss[i]
+  // @param chunk_start chunk_start[i] is the number of processed frames of
+  //                    ss[i] before the current chunk
+  void RunDecoder(OnlineStream **ss, const std::vector<int32_t> &indexes,
+                  int32_t num_tokens, const Ort::Value &encoder_out,
+                  const Ort::Value &encoder_out_len,
+                  const std::vector<std::vector<float>> &acoustic_embeddings,
+                  const std::vector<int32_t> &chunk_start) const {
+    int32_t batch_size = static_cast<int32_t>(indexes.size());
+    int32_t num_blocks = model_.DecoderNumBlocks();
+    OrtAllocator *allocator = model_.Allocator();
+
+    auto memory_info =
+        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+
+    Ort::Value encoder_out_batch =
+        GatherRows<float>(allocator, encoder_out, indexes);
+
+    Ort::Value encoder_out_len_batch =
+        encoder_out_len.GetTensorTypeAndShapeInfo().GetElementType() ==
+                ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64
+            ? GatherRows<int64_t>(allocator, encoder_out_len, indexes)
+            : GatherRows<int32_t>(allocator, encoder_out_len, indexes);
+
+    int32_t dim = acoustic_embeddings[indexes[0]].size() / num_tokens;
 
-    int32_t num_tokens = acoustic_embedding.size() / initial_hidden.size();
-    std::array<int64_t, 3> acoustic_embedding_shape{
-        1, num_tokens, static_cast<int32_t>(initial_hidden.size())};
+    std::vector<float> acoustic_embedding;
+    acoustic_embedding.reserve(batch_size * num_tokens * dim);
+    for (auto i : indexes) {
+      acoustic_embedding.insert(acoustic_embedding.end(),
+                                acoustic_embeddings[i].begin(),
+                                acoustic_embeddings[i].end());
+    }
+
+    std::array<int64_t, 3> acoustic_embedding_shape{batch_size, num_tokens,
+                                                    dim};
 
     Ort::Value acoustic_embedding_tensor = Ort::Value::CreateTensor(
         memory_info, acoustic_embedding.data(), acoustic_embedding.size(),
         acoustic_embedding_shape.data(), acoustic_embedding_shape.size());
 
-    std::array<int64_t, 1> acoustic_embedding_length_shape{1};
+    std::vector<int32_t> acoustic_embedding_length(batch_size, num_tokens);
+    std::array<int64_t, 1> acoustic_embedding_length_shape{batch_size};
     Ort::Value acoustic_embedding_length_tensor = Ort::Value::CreateTensor(
-        memory_info, &num_tokens, 1, acoustic_embedding_length_shape.data(),
+        memory_info, acoustic_embedding_length.data(), batch_size,
+        acoustic_embedding_length_shape.data(),
         acoustic_embedding_length_shape.size());
 
+    // Stack the decoder states of the selected streams along the batch axis
+    std::vector<Ort::Value> states;
+    states.reserve(num_blocks);
+
+    std::vector<const Ort::Value *> buf(batch_size);
+    for (int32_t b = 0; b != num_blocks; ++b) {
+      if (batch_size == 1) {
+        states.push_back(std::move(ss[indexes[0]]->GetStates()[b]));
+        continue;
+      }
+
+      for (int32_t k = 0; k != batch_size; ++k) {
+        buf[k] = &ss[indexes[k]]->GetStates()[b];
+      }
+      states.push_back(Cat(allocator, buf, 0));
+    }
+
     auto decoder_out_vec = model_.ForwardDecoder(
-        std::move(encoder_out), std::move(encoder_out_len),
+        std::move(encoder_out_batch), std::move(encoder_out_len_batch),
         std::move(acoustic_embedding_tensor),
         std::move(acoustic_embedding_length_tensor), std::move(states));
 
-    states.reserve(model_.DecoderNumBlocks());
-    for (int32_t i = 2; i != decoder_out_vec.size(); ++i) {
+    for (auto i : indexes) {
+      ss[i]->GetStates().clear();
+    }
+
+    for (int32_t b = 2; b != static_cast<int32_t>(decoder_out_vec.size());
+         ++b) {
       // TODO(fangjun): When we change chunk_size_, we need to
-      // slice decoder_out_vec[i] accordingly.
-      states.push_back(std::move(decoder_out_vec[i]));
+      // slice decoder_out_vec[b] accordingly.
+      if (batch_size == 1) {
+        ss[indexes[0]]->GetStates().push_back(std::move(decoder_out_vec[b]));
+        continue;
+      }
+
+      auto unbound = Unbind(allocator, &decoder_out_vec[b], 0);
+      for (int32_t k = 0; k != batch_size; ++k) {
+        ss[indexes[k]]->GetStates().push_back(std::move(unbound[k]));
+      }
     }
 
+    // (batch_size, num_tokens)
     const auto &sample_ids = decoder_out_vec[1];
     const int64_t *p_sample_ids = sample_ids.GetTensorData<int64_t>();
 
-    bool non_blank_detected = false;
+    for (int32_t k = 0; k != batch_size; ++k) {
+      auto &result = ss[indexes[k]]->GetParaformerResult();
+      const int64_t *p = p_sample_ids + k * num_tokens;
 
-    auto &result = s->GetParaformerResult();
+      bool non_blank_detected = false;
 
-    for (int32_t i = 0; i != num_tokens; ++i) {
-      int32_t t = p_sample_ids[i];
-      if (t == 0) {
-        continue;
-      }
+      for (int32_t i = 0; i != num_tokens; ++i) {
+        int32_t t = p[i];
+        if (t == 0) {
+          continue;
+        }
 
-      non_blank_detected = true;
-      result.tokens.push_back(t);
-    }
+        non_blank_detected = true;
+        result.tokens.push_back(t);
+      }
 
-    if (non_blank_detected) {
-      result.last_non_blank_frame_index = num_processed_frames;
+      if (non_blank_detected) {
+        result.last_non_blank_frame_index = chunk_start[indexes[k]];
+      }
     }
   }
 
@@ -0,0 +1,121 @@
+// sherpa-onnx/csrc/online-recognizer-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/online-recognizer.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sherpa-onnx/csrc/file-utils.h"
+#include "sherpa-onnx/csrc/macros.h"
+#include "sherpa-onnx/csrc/wave-reader.h"
+
+namespace sherpa_onnx {
+
+// Please download
+// https://github.com/k2-fsa/sherpa-onnx/releases/download/asr-models/sherpa-onnx-streaming-zipformer-en-2023-06-26.tar.bz2
+// and extract it to /tmp for testing
+static const char dir[] =
+    "/tmp/sherpa-onnx-streaming-zipformer-en-2023-06-26";
+
+struct DecodeResult {
+  std::string text;
+  bool is_endpoint = false;
+  int32_t num_chunks = 0;  // number of chunks decoded until the endpoint
+};
+
+static DecodeResult Decode(const OnlineRecognizer &recognizer,
+                           const std::vector<float> &samples,
+                           bool skip_silence) {
+  auto s = recognizer.CreateStream();
+  if (skip_silence) {
+    s->SetOption("silence_threshold_db", "-60");
+  }
+
+  s->AcceptWaveform(16000, samples.data(), samples.size());
+
+  DecodeResult ans;
+  while (recognizer.IsReady(s.get())) {
+    recognizer.DecodeStream(s.get());
+    ++ans.num_chunks;
+
+    if (recognizer.IsEndpoint(s.get())) {
+      ans.is_endpoint = true;
+      break;
+    }
+  }
+  ans.text = recognizer.GetResult(s.get()).text;
+
+  return ans;
+}
+
+TEST(OnlineRecognizer, SkipSilentChunks) {
+  std::string encoder =
+      std::string(dir) + "/encoder-epoch-99-avg-1-chunk-16-left-128.onnx";
+  std::string decoder =
+      std::string(dir) + "/decoder-epoch-99-avg-1-chunk-16-left-128.onnx";
+  std::string joiner =
+      std::string(dir) + "/joiner-epoch-99-avg-1-chunk-16-left-128.onnx";
+  std::string tokens = std::string(dir) + "/tokens.txt";
+  std::string wave_filename = std::string(dir) + "/test_wavs/0.wav";
+
+  if (!FileExists(encoder) || !FileExists(decoder) || !FileExists(joiner) ||
+      !FileExists(tokens) || !FileExists(wave_filename)) {
+    SHERPA_ONNX_LOGE(
+        "No test data found, skipping SkipSilentChunks(). You can download "
+        "the test data from "
+        "https://github.com/k2-fsa/sherpa-onnx/releases/download/asr-models/"
+        "sherpa-onnx-streaming-zipformer-en-2023-06-26.tar.bz2 and extract "
+        "it to /tmp");
+    return;
+  }
+
+  int32_t sampling_rate = -1;
+  bool is_ok = false;
+  std::vector<float> samples =
+      ReadWave(wave_filename, &sampling_rate, &is_ok);
+  ASSERT_TRUE(is_ok);
+  ASSERT_EQ(sampling_rate, 16000);
+
+  OnlineRecognizerConfig config;
+  config.model_config.transducer.encoder = encoder;
+  config.model_config.transducer.decoder = decoder;
+  config.model_config.transducer.joiner = joiner;
+  config.model_config.tokens = tokens;
+  config.model_config.num_threads = 1;
+  config.enable_endpoint = true;
+  config.endpoint_config.rule1.min_trailing_silence = 2.4;
+  config.endpoint_config.rule2.min_trailing_silence = 1.2;
+
+  OnlineRecognizer recognizer(config);
+
+  // Speech followed by 4 seconds of silence. rule2 fires in the silence.
+  // Skipped chunks have to be counted as trailing blanks for it.
+  std::vector<float> speech = samples;
+  speech.resize(samples.size() + 4 * 16000);
+
+  DecodeResult expected = Decode(recognizer, speech, false);
+  DecodeResult r = Decode(recognizer, speech, true);
+
+  EXPECT_TRUE(expected.is_endpoint);
+  EXPECT_TRUE(r.is_endpoint);
+  EXPECT_FALSE(r.text.empty());
+  EXPECT_EQ(r.text, expected.text);
+  EXPECT_NEAR(r.num_chunks, expected.num_chunks, 1);
+
+  // 5 seconds of silence. Every chunk is skipped and rule1 fires only if
+  // skipped chunks are counted as processed frames.
+  std::vector<float> silence(5 * 16000);
+
+  expected = Decode(recognizer, silence, false);
+  r = Decode(recognizer, silence, true);
+
+  EXPECT_TRUE(expected.is_endpoint);
+  EXPECT_TRUE(r.is_endpoint);
+  EXPECT_TRUE(r.text.empty());
+  EXPECT_NEAR(r.num_chunks, expected.num_chunks, 1);
+}
+
+}  // namespace sherpa_onnx
@@ -288,6 +288,24 @@ class OnlineRecognizerTransducerImpl : public OnlineRecognizerImpl {
     int32_t chunk_size = model_->ChunkSize();
     int32_t chunk_shift = model_->ChunkShift();
 
+    // Streams in silence are not passed to the encoder
+    std::vector<OnlineStream *> active;
+    active.reserve(n);
+    for (int32_t i = 0; i != n; ++i) {
+      if (IsSilentChunk(ss[i], chunk_size)) {
+        SkipChunk(ss[i], chunk_shift);
+      } else {
+        active.push_back(ss[i]);
+      }
+    }
+
+    if (active.empty()) {
+      return;
+    }
+
+    ss = active.data();
+    n = static_cast<int32_t>(active.size());
+
     int32_t feature_dim = ss[0]->FeatureDim();
 
     std::vector<OnlineTransducerDecoderResult> results(n);
@@ -439,6 +457,25 @@ class OnlineRecognizerTransducerImpl : public OnlineRecognizerImpl {
   }
 
  private:
+  // Advance the stream by one chunk of silence. Encoder states are kept
+  // and the chunk is counted as blank frames for endpoint detection.
+  void SkipChunk(OnlineStream *s, int32_t chunk_shift) const {
+    s->GetNumProcessedFrames() += chunk_shift;
+
+    // subsampling factor is 4
+    int32_t num_frames = chunk_shift / 4;
+
+    auto &r = s->GetResult();
+    r.frame_offset += num_frames;
+    r.num_trailing_blanks += num_frames;
+
+    // for modified_beam_search, r.num_trailing_blanks is taken from
+    // the best hypothesis after decoding the next chunk
+    for (auto &p : r.hyps) {
+      p.second.num_trailing_blanks += num_frames;
+    }
+  }
+
   void InitHotwords() {
     // each line in hotwords_file contains space-separated words
 
@@ -226,6 +226,9 @@ OnlineRecognizer::OnlineRecognizer(Manager *mgr,
                                    const OnlineRecognizerConfig &config)
     : impl_(OnlineRecognizerImpl::Create(mgr, config)) {}
 
+OnlineRecognizer::OnlineRecognizer(std::unique_ptr<OnlineRecognizerImpl> impl)
+    : impl_(std::move(impl)) {}
+
 OnlineRecognizer::~OnlineRecognizer() = default;
 
 std::unique_ptr<OnlineStream> OnlineRecognizer::CreateStream() const {
@@ -167,6 +167,9 @@ class OnlineRecognizer {
   template <typename Manager>
   OnlineRecognizer(Manager *mgr, const OnlineRecognizerConfig &config);
 
+  // Use the given implementation, e.g., a stub in tests.
+  explicit OnlineRecognizer(std::unique_ptr<OnlineRecognizerImpl> impl);
+
   ~OnlineRecognizer();
 
   /// Create a stream for decoding.
@@ -163,8 +163,7 @@ class OnlineRnnLM::Impl {
 
  private:
   void Init(const OnlineLMConfig &config) {
-    sess_ = std::make_unique<Ort::Session>(
-        env_, SHERPA_ONNX_TO_ORT_PATH(config_.model), sess_opts_);
+    sess_ = CreateSession(env_, config_.model, sess_opts_, &mapped_model_);
 
     GetInputNames(sess_.get(), &input_names_, &input_names_ptr_);
     GetOutputNames(sess_.get(), &output_names_, &output_names_ptr_);
@@ -216,6 +215,8 @@ class OnlineRnnLM::Impl {
   Ort::SessionOptions sess_opts_;
   Ort::AllocatorWithDefaultOptions allocator_;
 
+  // Non-null if the model is memory mapped. It must outlive sess_
+  std::unique_ptr<MappedFile> mapped_model_;
   std::unique_ptr<Ort::Session> sess_;
 
   std::vector<std::string> input_names_;
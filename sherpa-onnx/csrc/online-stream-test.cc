@@ -0,0 +1,83 @@
+// sherpa-onnx/csrc/online-stream-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/online-stream.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace sherpa_onnx {
+
+// With the default config, a block is 160 samples (10 ms) and a frame
+// of 25 ms covers 3 blocks, i.e., frame i covers blocks i, i + 1, i + 2
+static constexpr int32_t kBlockSize = 160;
+
+// Each block is either silent or has an energy of about -6 dB
+static void AcceptBlocks(OnlineStream *s, const std::vector<bool> &is_loud) {
+  std::vector<float> samples;
+  samples.reserve(is_loud.size() * kBlockSize);
+  for (bool loud : is_loud) {
+    samples.insert(samples.end(), kBlockSize, loud ? 0.5f : 0.0f);
+  }
+  s->AcceptWaveform(16000, samples.data(), samples.size());
+}
+
+static std::vector<bool> MakeBlocks(int32_t num_silent, int32_t num_loud) {
+  std::vector<bool> ans(num_silent, false);
+  ans.resize(num_silent + num_loud, true);
+  return ans;
+}
+
+TEST(OnlineStream, GetMaxEnergyDb) {
+  OnlineStream s;
+
+  // blocks 0-49 are silent, blocks 50-59 are loud and blocks 60-109
+  // are silent
+  AcceptBlocks(&s, MakeBlocks(50, 10));
+  AcceptBlocks(&s, MakeBlocks(50, 0));
+
+  EXPECT_LT(s.GetMaxEnergyDb(0, 48), -90);   // blocks 0-49
+  EXPECT_NEAR(s.GetMaxEnergyDb(0, 49), -6.02, 0.01);  // blocks 0-50
+  EXPECT_NEAR(s.GetMaxEnergyDb(59, 1), -6.02, 0.01);  // blocks 59-61
+  EXPECT_LT(s.GetMaxEnergyDb(60, 48), -90);  // blocks 60-109
+
+  // Frames 100-109 need blocks 100-111, which are not received yet
+  EXPECT_EQ(s.GetMaxEnergyDb(100, 10), 0);
+  EXPECT_EQ(s.GetMaxEnergyDb(60, 49), 0);
+}
+
+TEST(OnlineStream, GetMaxEnergyDbAfterReset) {
+  OnlineStream s;
+
+  AcceptBlocks(&s, MakeBlocks(50, 10));
+  AcceptBlocks(&s, MakeBlocks(50, 0));
+
+  // Frame 0 is frame 40 before the reset
+  s.GetNumProcessedFrames() = 40;
+  s.Reset();
+
+  EXPECT_LT(s.GetMaxEnergyDb(0, 8), -90);             // blocks 40-49
+  EXPECT_NEAR(s.GetMaxEnergyDb(0, 9), -6.02, 0.01);   // blocks 40-50
+  EXPECT_NEAR(s.GetMaxEnergyDb(19, 1), -6.02, 0.01);  // blocks 59-61
+  EXPECT_LT(s.GetMaxEnergyDb(20, 48), -90);           // blocks 60-109
+  EXPECT_EQ(s.GetMaxEnergyDb(20, 49), 0);
+
+  // Frame 0 is frame 70 before the first reset
+  s.GetNumProcessedFrames() = 30;
+  s.Reset();
+
+  EXPECT_LT(s.GetMaxEnergyDb(0, 38), -90);  // blocks 70-109
+  EXPECT_EQ(s.GetMaxEnergyDb(0, 39), 0);
+
+  // blocks 110-119 are silent and blocks 120-124 are loud
+  AcceptBlocks(&s, MakeBlocks(10, 5));
+
+  EXPECT_LT(s.GetMaxEnergyDb(0, 48), -90);            // blocks 70-119
+  EXPECT_NEAR(s.GetMaxEnergyDb(0, 49), -6.02, 0.01);  // blocks 70-120
+  EXPECT_NEAR(s.GetMaxEnergyDb(52, 1), -6.02, 0.01);  // blocks 122-124
+  EXPECT_EQ(s.GetMaxEnergyDb(53, 1), 0);
+}
+
+}  // namespace sherpa_onnx
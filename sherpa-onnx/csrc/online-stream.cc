@@ -3,6 +3,8 @@
 // Copyright (c)  2023  Xiaomi Corporation
 #include "sherpa-onnx/csrc/online-stream.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -19,11 +21,19 @@ class OnlineStream::Impl {
  public:
   explicit Impl(const FeatureExtractorConfig &config,
                 ContextGraphPtr context_graph)
-      : feat_extractor_(config), context_graph_(std::move(context_graph)) {}
+      : feat_extractor_(config),
+        context_graph_(std::move(context_graph)),
+        frame_shift_ms_(config.frame_shift_ms),
+        // number of extra energy blocks covered by a frame
+        num_extra_blocks_(std::max<int32_t>(
+            0, static_cast<int32_t>(std::ceil(config.frame_length_ms /
+                                              config.frame_shift_ms)) -
+                   1)) {}
 
   void AcceptWaveform(int32_t sampling_rate, const float *waveform, int32_t n) {
     std::lock_guard<std::mutex> lock(mutex_);
     feat_extractor_.AcceptWaveform(sampling_rate, waveform, n);
+    AccumulateEnergy(sampling_rate, waveform, n);
   }
 
   void InputFinished() const {
@@ -51,6 +61,29 @@ class OnlineStream::Impl {
     // we don't reset the feature extractor
     start_frame_index_ += num_processed_frames_;
     num_processed_frames_ = 0;
+
+    // energies of blocks before start_frame_index_ are never used again
+    int32_t num_unused = std::min<int32_t>(
+        start_frame_index_ - energy_offset_, block_energy_db_.size());
+    if (num_unused > 0) {
+      block_energy_db_.erase(block_energy_db_.begin(),
+                             block_energy_db_.begin() + num_unused);
+      energy_offset_ += num_unused;
+    }
+  }
+
+  float GetMaxEnergyDb(int32_t frame_index, int32_t n) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int32_t begin = frame_index + start_frame_index_ - energy_offset_;
+    int32_t end = begin + n + num_extra_blocks_;
+
+    if (begin < 0 || end > static_cast<int32_t>(block_energy_db_.size())) {
+      // Not all of the audio has been received. Treat it as non-silent.
+      return 0;
+    }
+
+    return *std::max_element(block_energy_db_.begin() + begin,
+                             block_energy_db_.begin() + end);
   }
 
   int32_t &GetNumProcessedFrames() {
@@ -197,6 +230,29 @@ class OnlineStream::Impl {
   }
 
  private:
+  // Split the input audio into blocks of frame_shift_ms_ and save the
+  // energy of each block in dB relative to full scale. Feature frame i
+  // covers blocks i, i + 1, ..., i + num_extra_blocks_.
+  void AccumulateEnergy(int32_t sampling_rate, const float *waveform,
+                        int32_t n) {
+    if (block_size_ == 0) {
+      block_size_ = std::max<int32_t>(
+          1, static_cast<int32_t>(sampling_rate * frame_shift_ms_ / 1000));
+    }
+
+    for (int32_t i = 0; i != n; ++i) {
+      block_sum_ += waveform[i] * waveform[i];
+      ++block_count_;
+
+      if (block_count_ == block_size_) {
+        block_energy_db_.push_back(10 * std::log10(block_sum_ / block_size_ +
+                                                   1e-10));
+        block_sum_ = 0;
+        block_count_ = 0;
+      }
+    }
+  }
+
   FeatureExtractor feat_extractor_;
   mutable std::mutex mutex_;
   /// For contextual-biasing
@@ -226,6 +282,15 @@ class OnlineStream::Impl {
   std::unordered_map<std::string, std::string> options_;
   std::unique_ptr<kaldi_decoder::FasterDecoder> faster_decoder_;
   int32_t faster_decoder_processed_frames_ = 0;
+
+  // for silence detection. See GetMaxEnergyDb()
+  float frame_shift_ms_ = 10;
+  int32_t num_extra_blocks_ = 0;
+  int32_t block_size_ = 0;  // number of input samples per block
+  double block_sum_ = 0;
+  int32_t block_count_ = 0;
+  std::vector<float> block_energy_db_;
+  int32_t energy_offset_ = 0;  // frame index of block_energy_db_[0]
 };
 
 OnlineStream::OnlineStream(const FeatureExtractorConfig &config /*= {}*/,
@@ -234,6 +299,10 @@ OnlineStream::OnlineStream(const FeatureExtractorConfig &config /*= {}*/,
 
 OnlineStream::~OnlineStream() = default;
 
+float OnlineStream::GetMaxEnergyDb(int32_t frame_index, int32_t n) const {
+  return impl_->GetMaxEnergyDb(frame_index, n);
+}
+
 void OnlineStream::AcceptWaveform(int32_t sampling_rate, const float *waveform,
                                   int32_t n) const {
   impl_->AcceptWaveform(sampling_rate, waveform, n);
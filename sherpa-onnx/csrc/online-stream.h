@@ -63,6 +63,18 @@ class OnlineStream {
    */
   std::vector<float> GetFrames(int32_t frame_index, int32_t n) const;
 
+  /** Get the maximum energy of the input audio covered by n frames
+   * starting from the given frame index.
+   *
+   * The energy is computed over blocks of frame_shift_ms and is in dB
+   * relative to full scale, i.e., it is 0 for a full-scale square wave
+   * and about -100 for digital silence.
+   *
+   * @return Return 0 if not all of the audio for the given frames has
+   *         been received.
+   */
+  float GetMaxEnergyDb(int32_t frame_index, int32_t n) const;
+
   void Reset();
 
   int32_t FeatureDim() const;
@@ -5,6 +5,7 @@
 #include "sherpa-onnx/csrc/online-websocket-server-impl.h"
 #include "sherpa-onnx/csrc/macros.h"
 
+#include <chrono>  // NOLINT
 #include <iostream>
 #include <memory>
 #include <string>
@@ -42,6 +43,10 @@ void OnlineWebsocketServerConfig::Register(sherpa_onnx::ParseOptions *po) {
   po->Register("log-file", &log_file,
                "Path to the log file. Logs are "
                "appended to this file");
+
+  po->Register("enable-metrics", &enable_metrics,
+               "If true, metrics in the text format of Prometheus are "
+               "served over HTTP at /metrics on the same port.");
 }
 
 void OnlineWebsocketServerConfig::Validate() const {
@@ -53,6 +58,40 @@ OnlineWebsocketDecoder::OnlineWebsocketDecoder(OnlineWebsocketServer *server)
       config_(server->GetConfig().decoder_config),
       timer_(server->GetWorkContext()) {
   recognizer_ = std::make_unique<OnlineRecognizer>(config_.recognizer_config);
+
+  auto &metrics = server->GetMetrics();
+
+  metrics.AddGauge("sherpa_onnx_streams", "Number of streams being processed",
+                   [this]() {
+                     std::lock_guard<std::mutex> lock(mutex_);
+                     return static_cast<double>(connections_.size());
+                   });
+
+  metrics.AddGauge("sherpa_onnx_ready_streams",
+                   "Number of streams waiting in the queue for decoding",
+                   [this]() {
+                     std::lock_guard<std::mutex> lock(mutex_);
+                     return static_cast<double>(ready_connections_.size());
+                   });
+
+  batch_size_ = metrics.AddHistogram(
+      "sherpa_onnx_decode_batch_size",
+      "Number of streams decoded together by DecodeStreams()",
+      {1, 2, 4, 8, 16, 32, 64});
+
+  decode_duration_ = metrics.AddHistogram(
+      "sherpa_onnx_decode_duration_seconds",
+      "Time of a call to DecodeStreams(), i.e., the latency of a chunk",
+      {0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5});
+
+  decode_seconds_ = metrics.AddCounter("sherpa_onnx_decode_seconds_total",
+                                       "Time spent in DecodeStreams()");
+
+  audio_seconds_ = metrics.AddCounter(
+      "sherpa_onnx_audio_seconds_total",
+      "Duration of received audio. The real-time factor is "
+      "rate(sherpa_onnx_decode_seconds_total) / "
+      "rate(sherpa_onnx_audio_seconds_total)");
 }
 
 std::shared_ptr<Connection> OnlineWebsocketDecoder::GetOrCreateConnection(
@@ -76,6 +115,7 @@ void OnlineWebsocketDecoder::AcceptWaveform(std::shared_ptr<Connection> c) {
   while (!c->samples.empty()) {
     const auto &s = c->samples.front();
     c->s->AcceptWaveform(sample_rate, s.data(), s.size());
+    audio_seconds_->Inc(s.size() / sample_rate);
     c->samples.pop_front();
   }
 }
@@ -88,6 +128,7 @@ void OnlineWebsocketDecoder::InputFinished(std::shared_ptr<Connection> c) {
   while (!c->samples.empty()) {
     const auto &s = c->samples.front();
     c->s->AcceptWaveform(sample_rate, s.data(), s.size());
+    audio_seconds_->Inc(s.size() / sample_rate);
     c->samples.pop_front();
   }
 
@@ -203,7 +244,17 @@ void OnlineWebsocketDecoder::Decode() {
   }
 
   lock.unlock();
+
+  auto start = std::chrono::steady_clock::now();
   recognizer_->DecodeStreams(s_vec.data(), s_vec.size());
+  float elapsed_seconds = std::chrono::duration<float>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+
+  batch_size_->Observe(s_vec.size());
+  decode_duration_->Observe(elapsed_seconds);
+  decode_seconds_->Inc(elapsed_seconds);
+
   lock.lock();
 
   for (auto c : c_vec) {
@@ -247,6 +298,20 @@ OnlineWebsocketServer::OnlineWebsocketServer(
       [this](connection_hdl hdl, server::message_ptr msg) {
         OnMessage(hdl, msg);
       });
+
+  metrics_.AddGauge("sherpa_onnx_active_connections",
+                    "Number of active websocket connections", [this]() {
+                      std::lock_guard<std::mutex> lock(mutex_);
+                      return static_cast<double>(connections_.size());
+                    });
+
+  metrics_.AddGauge("sherpa_onnx_resident_memory_bytes",
+                    "Resident memory of the server process",
+                    []() { return GetResidentMemoryBytes(); });
+
+  if (config_.enable_metrics) {
+    server_.set_http_handler([this](connection_hdl hdl) { OnHttp(hdl); });
+  }
 }
 
 void OnlineWebsocketServer::Run(uint16_t port) {
@@ -350,6 +415,20 @@ void OnlineWebsocketServer::OnMessage(connection_hdl hdl,
   }
 }
 
+void OnlineWebsocketServer::OnHttp(connection_hdl hdl) {
+  auto con = server_.get_con_from_hdl(hdl);
+
+  if (con->get_resource() != "/metrics") {
+    con->set_status(websocketpp::http::status_code::not_found);
+    con->set_body("Not found\n");
+    return;
+  }
+
+  con->set_status(websocketpp::http::status_code::ok);
+  con->append_header("Content-Type", "text/plain; version=0.0.4");
+  con->set_body(metrics_.ToString());
+}
+
 void OnlineWebsocketServer::Close(connection_hdl hdl,
                                   websocketpp::close::status::value code,
                                   const std::string &reason) {
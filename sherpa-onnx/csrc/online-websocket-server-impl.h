@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "asio.hpp"  // NOLINT
+#include "sherpa-onnx/csrc/metrics.h"
 #include "sherpa-onnx/csrc/online-recognizer.h"
 #include "sherpa-onnx/csrc/online-stream.h"
 #include "sherpa-onnx/csrc/parse-options.h"
@@ -116,6 +117,12 @@ class OnlineWebsocketDecoder {
   // If we are decoding a stream, we put it in the active_ set so that
   // only one thread can decode a stream at a time.
   std::set<connection_hdl, std::owner_less<connection_hdl>> active_;
+
+  // Owned by the server
+  Histogram *batch_size_;
+  Histogram *decode_duration_;
+  Counter *decode_seconds_;
+  Counter *audio_seconds_;
 };
 
 struct OnlineWebsocketServerConfig {
@@ -123,6 +130,9 @@ struct OnlineWebsocketServerConfig {
 
   std::string log_file = "./log.txt";
 
+  // If true, serve metrics at http://<host>:<port>/metrics
+  bool enable_metrics = false;
+
   void Register(sherpa_onnx::ParseOptions *po);
   void Validate() const;
 };
@@ -139,6 +149,7 @@ class OnlineWebsocketServer {
   asio::io_context &GetConnectionContext() { return io_conn_; }
   asio::io_context &GetWorkContext() { return io_work_; }
   server &GetServer() { return server_; }
+  MetricsRegistry &GetMetrics() { return metrics_; }
 
   void Send(connection_hdl hdl, const std::string &text);
 
@@ -156,6 +167,9 @@ class OnlineWebsocketServer {
 
   void OnMessage(connection_hdl hdl, server::message_ptr msg);
 
+  // Handle plain HTTP requests. Only /metrics is supported.
+  void OnHttp(connection_hdl hdl);
+
   // Close a websocket connection with given code and reason
   void Close(connection_hdl hdl, websocketpp::close::status::value code,
              const std::string &reason);
@@ -169,6 +183,8 @@ class OnlineWebsocketServer {
   std::ofstream log_;
   sherpa_onnx::TeeStream tee_;
 
+  MetricsRegistry metrics_;
+
   OnlineWebsocketDecoder decoder_;
 
   mutable std::mutex mutex_;
@@ -43,16 +43,16 @@ OnlineZipformer2TransducerModel::OnlineZipformer2TransducerModel(
       joiner_sess_opts_(GetSessionOptions(config, "joiner")),
       config_(config),
       allocator_{} {
-  encoder_sess_ = std::make_unique<Ort::Session>(
-      env_, SHERPA_ONNX_TO_ORT_PATH(config.transducer.encoder), encoder_sess_opts_);
+  encoder_sess_ = CreateSession(env_, config.transducer.encoder,
+                                encoder_sess_opts_, &mapped_encoder_);
   InitEncoder(nullptr, 0);
 
-  decoder_sess_ = std::make_unique<Ort::Session>(
-      env_, SHERPA_ONNX_TO_ORT_PATH(config.transducer.decoder), decoder_sess_opts_);
+  decoder_sess_ = CreateSession(env_, config.transducer.decoder,
+                                decoder_sess_opts_, &mapped_decoder_);
   InitDecoder(nullptr, 0);
 
-  joiner_sess_ = std::make_unique<Ort::Session>(
-      env_, SHERPA_ONNX_TO_ORT_PATH(config.transducer.joiner), joiner_sess_opts_);
+  joiner_sess_ = CreateSession(env_, config.transducer.joiner,
+                               joiner_sess_opts_, &mapped_joiner_);
   InitJoiner(nullptr, 0);
 }
 
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "onnxruntime_cxx_api.h"  // NOLINT
+#include "sherpa-onnx/csrc/file-utils.h"
 #include "sherpa-onnx/csrc/online-model-config.h"
 #include "sherpa-onnx/csrc/online-transducer-model.h"
 
@@ -67,6 +68,11 @@ class OnlineZipformer2TransducerModel : public OnlineTransducerModel {
 
   Ort::AllocatorWithDefaultOptions allocator_;
 
+  // Non-null if the models are memory mapped. They must outlive the sessions
+  std::unique_ptr<MappedFile> mapped_encoder_;
+  std::unique_ptr<MappedFile> mapped_decoder_;
+  std::unique_ptr<MappedFile> mapped_joiner_;
+
   std::unique_ptr<Ort::Session> encoder_sess_;
   std::unique_ptr<Ort::Session> decoder_sess_;
   std::unique_ptr<Ort::Session> joiner_sess_;
@@ -5,6 +5,7 @@
 #define SHERPA_ONNX_CSRC_PHRASE_MATCHER_H_
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -19,6 +20,12 @@ class PhraseMatcher {
                                // should live longer than this instance
                 const std::vector<std::string> &words, bool debug = false,
                 int32_t max_search_len = 10);
+
+  // contains(w) returns true if w is in the lexicon.
+  PhraseMatcher(std::function<bool(const std::string &)> contains,
+                const std::vector<std::string> &words, bool debug = false,
+                int32_t max_search_len = 10);
+
   ~PhraseMatcher();
 
   std::vector<std::string>::const_iterator begin() const;
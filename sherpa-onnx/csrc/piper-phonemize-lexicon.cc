@@ -28,6 +28,7 @@
 #include "phoneme_ids.hpp"  // NOLINT
 #include "phonemize.hpp"    // NOLINT
 #include "sherpa-onnx/csrc/file-utils.h"
+#include "sherpa-onnx/csrc/lru-cache.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/text-utils.h"
 
@@ -59,11 +60,52 @@ static std::string ToString(char32_t cp) {
   return result;
 }
 
+namespace {
+
+// espeak-ng keeps global state, so only one thread can call into it at a
+// time. To reduce the contention, phonemes of recently phonemized texts
+// are cached. Callers pass either a single word or a whole text, so it
+// works as a word-level cache for some frontends and as a sentence-level
+// cache for others. The cache is shared by all models in the process.
+using EspeakPhonemeCache =
+    LruCache<std::string, std::vector<std::vector<piper::Phoneme>>>;
+
+// Number of cached texts
+constexpr size_t kEspeakPhonemeCacheCapacity = 4096;
+
+// Longer texts are not cached so that the memory usage is bounded
+constexpr size_t kEspeakPhonemeCacheMaxTextLength = 1024;
+
+EspeakPhonemeCache &GetEspeakPhonemeCache() {
+  static EspeakPhonemeCache cache(kEspeakPhonemeCacheCapacity);
+  return cache;
+}
+
+}  // namespace
+
 void CallPhonemizeEspeak(const std::string &text,
                          piper::eSpeakPhonemeConfig &config,  // NOLINT
                          std::vector<std::vector<piper::Phoneme>> *phonemes) {
   static std::mutex espeak_mutex;
 
+  // The result also depends on the phoneme map, which is not part of
+  // the key, so we don't cache it if a phoneme map is given.
+  bool use_cache = config.phonemeMap == nullptr &&
+                   text.size() <= kEspeakPhonemeCacheMaxTextLength;
+
+  std::string key;
+  if (use_cache) {
+    key = config.voice;
+    key.push_back('\0');
+    key.push_back(config.keepLanguageFlags ? '1' : '0');
+    key += text;
+
+    // A cache hit does not need to wait for espeak_mutex
+    if (GetEspeakPhonemeCache().Get(key, phonemes)) {
+      return;
+    }
+  }
+
   // keep multi threads from calling into piper::phonemize_eSpeak
   std::lock_guard<std::mutex> lock(espeak_mutex);
 
@@ -77,6 +119,11 @@ void CallPhonemizeEspeak(const std::string &text,
     SHERPA_ONNX_LOGE("Failed to phonemize '%s' with espeak-ng voice '%s': %s",
                      text.c_str(), config.voice.c_str(), ex.what());
     phonemes->clear();
+    return;
+  }
+
+  if (use_cache) {
+    GetEspeakPhonemeCache().Put(key, *phonemes);
   }
 }
 
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -13,6 +14,7 @@
 #include <vector>
 
 #include "sherpa-onnx/csrc/file-utils.h"
+#include "sherpa-onnx/csrc/global-thread-pool.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/provider.h"
 #include "sherpa-onnx/csrc/text-utils.h"
@@ -143,6 +145,10 @@ Ort::SessionOptions GetSessionOptionsImpl(
 
   SplitProviderAndConfig(provider_str, new_provider_str, config);
 
+  // The model calling this function has created its Ort::Env.
+  // See global-thread-pool.h
+  MarkOrtEnvCreated();
+
   Provider p = StringToProvider(new_provider_str);
 
   Ort::SessionOptions sess_opts;
@@ -198,6 +204,22 @@ Ort::SessionOptions GetSessionOptionsImpl(
     config.erase("EnableCpuMemArena");
   }
 
+  // See global-thread-pool.h
+  if (config.find("UseGlobalThreadPools") != config.end()) {
+    int32_t use_global_thread_pools =
+        ToIntOrDefault(config["UseGlobalThreadPools"], 0);
+    if (use_global_thread_pools == 1) {
+      if (HasGlobalThreadPools()) {
+        sess_opts.DisablePerSessionThreads();
+      } else {
+        SHERPA_ONNX_LOGE(
+            "Ignore UseGlobalThreadPools=1 since InitGlobalThreadPools() "
+            "has not been called");
+      }
+    }
+    config.erase("UseGlobalThreadPools");
+  }
+
   // Keys prefixed with "SessionConfig." are forwarded verbatim (prefix
   // stripped) to Ort::SessionOptions::AddConfigEntry, e.g.,
   //   SessionConfig.mlas.disable_kleidiai=1
@@ -478,6 +500,34 @@ Ort::SessionOptions GetSessionOptions(const OnlineModelConfig &config,
                                &config.provider_config);
 }
 
+std::unique_ptr<Ort::Session> CreateSession(
+    const Ort::Env &env, const std::string &filename,
+    const Ort::SessionOptions &sess_opts, std::unique_ptr<MappedFile> *mapped) {
+  mapped->reset();
+
+  if (EndsWith(filename, ".ort")) {
+    auto file = std::make_unique<MappedFile>(filename);
+    if (file->IsMapped()) {
+      // The entries are added to a copy since callers often pass the same
+      // options for several models, and adding an existing key again
+      // makes onnxruntime print a warning.
+      Ort::SessionOptions opts = sess_opts.Clone();
+
+      // See onnxruntime_session_options_config_keys.h
+      opts.AddConfigEntry("session.use_ort_model_bytes_directly", "1");
+      opts.AddConfigEntry("session.use_ort_model_bytes_for_initializers", "1");
+
+      auto sess = std::make_unique<Ort::Session>(env, file->Data(),
+                                                 file->Size(), opts);
+      *mapped = std::move(file);
+      return sess;
+    }
+  }
+
+  return std::make_unique<Ort::Session>(env, SHERPA_ONNX_TO_ORT_PATH(filename),
+                                        sess_opts);
+}
+
 Ort::SessionOptions GetSessionOptions(const OfflineLMConfig &config) {
   return GetSessionOptionsImpl(config.lm_num_threads, config.lm_provider);
 }
@@ -5,9 +5,11 @@
 #ifndef SHERPA_ONNX_CSRC_SESSION_H_
 #define SHERPA_ONNX_CSRC_SESSION_H_
 
+#include <memory>
 #include <string>
 
 #include "onnxruntime_cxx_api.h"  // NOLINT
+#include "sherpa-onnx/csrc/file-utils.h"
 #include "sherpa-onnx/csrc/offline-lm-config.h"
 #include "sherpa-onnx/csrc/online-lm-config.h"
 #include "sherpa-onnx/csrc/online-model-config.h"
@@ -34,6 +36,27 @@ Ort::SessionOptions GetSessionOptions(const T &config) {
   return GetSessionOptionsImpl(config.num_threads, config.provider);
 }
 
+/** Create a session from a model file.
+ *
+ * Models in ORT format (*.ort) are memory mapped and onnxruntime is told to
+ * use the mapped bytes directly, also for initializers, so that weights are
+ * neither read into a temporary buffer nor copied. The mapping is returned
+ * in *mapped and must outlive the returned session.
+ *
+ * Other models are loaded by path so that onnxruntime can resolve external
+ * data relative to the model file.
+ *
+ * @param env The onnxruntime environment.
+ * @param filename Path to the model.
+ * @param sess_opts Session options. It is not changed, so the same options
+ *                  can be used for several sessions.
+ * @param mapped On return, it contains the mapped model or nullptr if
+ *               the model is loaded by path.
+ */
+std::unique_ptr<Ort::Session> CreateSession(
+    const Ort::Env &env, const std::string &filename,
+    const Ort::SessionOptions &sess_opts, std::unique_ptr<MappedFile> *mapped);
+
 }  // namespace sherpa_onnx
 
 #endif  // SHERPA_ONNX_CSRC_SESSION_H_
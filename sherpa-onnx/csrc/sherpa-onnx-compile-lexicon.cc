@@ -0,0 +1,140 @@
+// sherpa-onnx/csrc/sherpa-onnx-compile-lexicon.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#include <stdio.h>
+
+#include <chrono>  // NOLINT
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sherpa-onnx/csrc/binary-lexicon.h"
+#include "sherpa-onnx/csrc/file-utils.h"
+#include "sherpa-onnx/csrc/macros.h"
+#include "sherpa-onnx/csrc/parse-options.h"
+#include "sherpa-onnx/csrc/symbol-table.h"
+#include "sherpa-onnx/csrc/text-utils.h"
+
+int main(int32_t argc, char *argv[]) {
+  const char *kUsageMessage = R"usage(
+Convert lexicon.txt of a TTS model to a binary lexicon, which can be
+memory mapped and used without parsing it at startup.
+
+Usage:
+
+./bin/sherpa-onnx-compile-lexicon \
+  --tokens=./kokoro-multi-lang-v1_0/tokens.txt \
+  ./kokoro-multi-lang-v1_0/lexicon-us-en.txt,./kokoro-multi-lang-v1_0/lexicon-zh.txt \
+  ./kokoro-multi-lang-v1_0/lexicon.bin
+
+Then pass lexicon.bin to --kokoro-lexicon, --matcha-lexicon or --vits-lexicon
+in place of the text lexicon.
+
+If multiple lexicon files are given (separated by comma), the first
+pronunciation of a word wins, which is the same as passing them to
+the TTS model directly.
+
+Please use the same tokens.txt that is passed to the TTS model.
+)usage";
+
+  sherpa_onnx::ParseOptions po(kUsageMessage);
+  std::string tokens;
+  po.Register("tokens", &tokens, "Path to tokens.txt");
+  po.Read(argc, argv);
+
+  if (po.NumArgs() != 2) {
+    fprintf(stderr,
+            "Error: Please provide the input lexicon and the output "
+            "filename.\n\n");
+    po.PrintUsage();
+    SHERPA_ONNX_EXIT(EXIT_FAILURE);
+  }
+
+  if (tokens.empty() || !sherpa_onnx::FileExists(tokens)) {
+    fprintf(stderr, "Please provide --tokens\n");
+    SHERPA_ONNX_EXIT(EXIT_FAILURE);
+  }
+
+  const auto begin = std::chrono::steady_clock::now();
+
+  std::unordered_map<std::string, int32_t> token2id;
+  {
+    auto is = sherpa_onnx::OpenInputFile(tokens);
+    token2id = sherpa_onnx::ReadTokens(is);
+  }
+
+  std::vector<std::string> files;
+  sherpa_onnx::SplitStringToVector(po.GetArg(1), ",", false, &files);
+
+  std::unordered_map<std::string, std::vector<int32_t>> word2ids;
+  int32_t num_skipped = 0;
+
+  for (const auto &f : files) {
+    auto is = sherpa_onnx::OpenInputFile(f);
+    if (!is) {
+      fprintf(stderr, "Failed to open '%s'\n", f.c_str());
+      SHERPA_ONNX_EXIT(EXIT_FAILURE);
+    }
+
+    std::string line;
+    std::string word;
+    std::string token;
+    std::vector<std::string> token_list;
+
+    while (std::getline(is, line)) {
+      std::istringstream iss(line);
+      token_list.clear();
+
+      if (!(iss >> word)) {
+        continue;
+      }
+
+      sherpa_onnx::ToLowerCase(&word);
+
+      if (word2ids.count(word)) {
+        continue;
+      }
+
+      while (iss >> token) {
+        token_list.push_back(std::move(token));
+      }
+
+      auto ids = sherpa_onnx::ConvertTokensToIds(token2id, token_list);
+
+      // Same as the parser in ./kokoro-multi-lang-lexicon.cc, which keeps
+      // 呣 with an empty pronunciation so that it is not split into
+      // characters or passed to espeak. For the other lexicons, a word
+      // without token IDs produces no tokens either way.
+      if (ids.empty() && word != "呣") {
+        num_skipped += 1;
+        continue;
+      }
+
+      word2ids.insert({std::move(word), std::move(ids)});
+    }
+  }
+
+  std::string output = po.GetArg(2);
+  auto os = sherpa_onnx::OpenOutputFile(output, std::ios::binary);
+  if (!sherpa_onnx::BinaryLexicon::Write(
+          word2ids, static_cast<int32_t>(token2id.size()), os)) {
+    fprintf(stderr, "Failed to write '%s'\n", output.c_str());
+    SHERPA_ONNX_EXIT(EXIT_FAILURE);
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  float elapsed_seconds =
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - begin)
+          .count() /
+      1000.;
+
+  fprintf(stderr, "Number of words: %d\n",
+          static_cast<int32_t>(word2ids.size()));
+  fprintf(stderr, "Number of skipped words: %d\n", num_skipped);
+  fprintf(stderr, "Elapsed seconds: %.3f s\n", elapsed_seconds);
+  fprintf(stderr, "Saved to %s\n", output.c_str());
+
+  return 0;
+}
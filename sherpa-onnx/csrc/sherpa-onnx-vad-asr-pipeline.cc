@@ -0,0 +1,160 @@
+// sherpa-onnx/csrc/sherpa-onnx-vad-asr-pipeline.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "sherpa-onnx/csrc/macros.h"
+#include "sherpa-onnx/csrc/parse-options.h"
+#include "sherpa-onnx/csrc/resample.h"
+#include "sherpa-onnx/csrc/vad-asr-pipeline.h"
+#include "sherpa-onnx/csrc/wave-reader.h"
+
+int main(int32_t argc, char *argv[]) {
+  const char *kUsageMessage = R"usage(
+Speech recognition of several audio files at the same time using
+VAD + a non-streaming model. Each file is fed from its own thread as if it
+were a live source, and speech segments of all files are decoded together
+in batches of similar length.
+
+Usage:
+
+Note you can download silero_vad.onnx using
+
+wget https://github.com/k2-fsa/sherpa-onnx/releases/download/asr-models/silero_vad.onnx
+
+  ./bin/sherpa-onnx-vad-asr-pipeline \
+    --silero-vad-model=/path/to/silero_vad.onnx \
+    --tokens=/path/to/tokens.txt \
+    --encoder=/path/to/encoder.onnx \
+    --decoder=/path/to/decoder.onnx \
+    --joiner=/path/to/joiner.onnx \
+    --num-threads=1 \
+    --pipeline-num-workers=2 \
+    --pipeline-max-batch-size=8 \
+    /path/to/foo.wav \
+    /path/to/bar.wav
+
+Any non-streaming model supported by ./bin/sherpa-onnx-offline can be used.
+Please see ./bin/sherpa-onnx-vad-with-offline-asr --help for examples.
+
+The input wav files should be of single channel, 16-bit PCM encoded wave
+files; their sampling rate can be arbitrary.
+)usage";
+
+  sherpa_onnx::ParseOptions po(kUsageMessage);
+  sherpa_onnx::VadAsrPipelineConfig config;
+  config.Register(&po);
+
+  po.Read(argc, argv);
+  if (po.NumArgs() < 1) {
+    fprintf(stderr, "Error: Please provide at least 1 wave file.\n\n");
+    po.PrintUsage();
+    SHERPA_ONNX_EXIT(EXIT_FAILURE);
+  }
+
+  fprintf(stderr, "%s\n", config.ToString().c_str());
+
+  if (!config.Validate()) {
+    fprintf(stderr, "Errors in config!\n");
+    return -1;
+  }
+
+  int32_t sample_rate = config.vad_config.sample_rate;
+
+  std::vector<std::vector<float>> waves;
+  float total_duration = 0;
+  for (int32_t i = 1; i <= po.NumArgs(); ++i) {
+    std::string wave_filename = po.GetArg(i);
+
+    int32_t sampling_rate = -1;
+    bool is_ok = false;
+    auto samples = sherpa_onnx::ReadWave(wave_filename, &sampling_rate, &is_ok);
+    if (!is_ok) {
+      fprintf(stderr, "Failed to read '%s'\n", wave_filename.c_str());
+      return -1;
+    }
+
+    if (sampling_rate != sample_rate) {
+      float min_freq = std::min<int32_t>(sampling_rate, sample_rate);
+      float lowpass_cutoff = 0.99 * 0.5 * min_freq;
+
+      int32_t lowpass_filter_width = 6;
+      auto resampler = std::make_unique<sherpa_onnx::LinearResample>(
+          sampling_rate, sample_rate, lowpass_cutoff, lowpass_filter_width);
+      std::vector<float> out_samples;
+      resampler->Resample(samples.data(), samples.size(), true, &out_samples);
+      samples = std::move(out_samples);
+    }
+
+    total_duration += samples.size() / static_cast<float>(sample_rate);
+    waves.push_back(std::move(samples));
+  }
+
+  fprintf(stderr, "Creating recognizer ...\n");
+  sherpa_onnx::VadAsrPipeline pipeline(config);
+  fprintf(stderr, "Recognizer created!\n");
+
+  const auto begin = std::chrono::steady_clock::now();
+
+  std::mutex mutex;  // for printing results
+  std::vector<int32_t> sources;
+  for (int32_t i = 0; i != static_cast<int32_t>(waves.size()); ++i) {
+    std::string name = po.GetArg(i + 1);
+    sources.push_back(pipeline.AddSource(
+        [&mutex, name](int32_t, const sherpa_onnx::VadAsrSegmentResult &r) {
+          if (r.result.text.empty()) {
+            return;
+          }
+
+          std::lock_guard<std::mutex> lock(mutex);
+          fprintf(stdout, "%s %.3f -- %.3f: %s\n", name.c_str(), r.start,
+                  r.start + r.duration, r.result.text.c_str());
+        }));
+  }
+
+  int32_t window_size = config.vad_config.silero_vad.window_size;
+
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i != static_cast<int32_t>(waves.size()); ++i) {
+    threads.emplace_back([&, i]() {
+      const auto &samples = waves[i];
+      int32_t n = static_cast<int32_t>(samples.size());
+      for (int32_t k = 0; k < n; k += window_size) {
+        pipeline.AcceptWaveform(sources[i], samples.data() + k,
+                                std::min(window_size, n - k));
+      }
+      pipeline.InputFinished(sources[i]);
+    });
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  pipeline.Wait();
+
+  const auto end = std::chrono::steady_clock::now();
+
+  float elapsed_seconds =
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - begin)
+          .count() /
+      1000.;
+
+  fprintf(stderr, "Number of files: %d\n", static_cast<int32_t>(waves.size()));
+  fprintf(stderr, "Elapsed seconds: %.3f s\n", elapsed_seconds);
+  float rtf = elapsed_seconds / total_duration;
+  fprintf(stderr, "Real time factor (RTF): %.3f / %.3f = %.3f\n",
+          elapsed_seconds, total_duration, rtf);
+
+  return 0;
+}
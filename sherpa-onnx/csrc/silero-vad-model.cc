@@ -35,8 +35,8 @@ class SileroVadModel::Impl {
         sess_opts_(GetSessionOptions(config)),
         allocator_{},
         sample_rate_(config.sample_rate) {
-    sess_ = std::make_unique<Ort::Session>(
-        env_, SHERPA_ONNX_TO_ORT_PATH(config.silero_vad.model), sess_opts_);
+    sess_ = CreateSession(env_, config.silero_vad.model, sess_opts_,
+                          &mapped_model_);
     Init(nullptr, 0);
 
     if (sample_rate_ != 16000) {
@@ -455,6 +455,8 @@ class SileroVadModel::Impl {
   Ort::SessionOptions sess_opts_;
   Ort::AllocatorWithDefaultOptions allocator_;
 
+  // Non-null if the model is memory mapped. It must outlive sess_
+  std::unique_ptr<MappedFile> mapped_model_;
   std::unique_ptr<Ort::Session> sess_;
 
   std::vector<std::string> input_names_;
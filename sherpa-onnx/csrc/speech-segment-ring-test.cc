@@ -0,0 +1,112 @@
+// sherpa-onnx/csrc/speech-segment-ring-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/speech-segment-ring.h"
+
+#include <algorithm>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace sherpa_onnx {
+
+static void PushSegment(SpeechSegmentRing *ring, int32_t start,
+                        const std::vector<float> &v) {
+  float *p = ring->Reserve(v.size());
+  ASSERT_NE(p, nullptr);
+  std::copy(v.begin(), v.end(), p);
+  ring->Commit(start, v.size());
+}
+
+TEST(SpeechSegmentRing, PushAndRelease) {
+  SpeechSegmentRing ring(10, 4);
+  EXPECT_TRUE(ring.Empty());
+
+  PushSegment(&ring, 100, {1, 2, 3});
+  PushSegment(&ring, 200, {4, 5, 6, 7});
+  EXPECT_EQ(ring.NumSegments(), 2);
+
+  auto v = ring.Front();
+  EXPECT_EQ(v.start, 100);
+  EXPECT_EQ(v.n, 3);
+  EXPECT_EQ(v.samples[0], 1);
+  EXPECT_EQ(v.samples[2], 3);
+  ring.Release();
+
+  v = ring.Front();
+  EXPECT_EQ(v.start, 200);
+  EXPECT_EQ(v.n, 4);
+  EXPECT_EQ(v.samples[3], 7);
+  ring.Release();
+
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(SpeechSegmentRing, WrapAround) {
+  SpeechSegmentRing ring(10, 4);
+
+  PushSegment(&ring, 0, {1, 2, 3, 4, 5, 6});
+
+  // Only 4 free samples at the end and the beginning is still in use
+  EXPECT_EQ(ring.Reserve(5), nullptr);
+
+  ring.Release();
+
+  // It does not fit at the end, so it is placed at the beginning
+  PushSegment(&ring, 1, {7, 8, 9, 10, 11});
+
+  auto v = ring.Front();
+  EXPECT_EQ(v.start, 1);
+  EXPECT_EQ(v.n, 5);
+  for (int32_t i = 0; i != v.n; ++i) {
+    EXPECT_EQ(v.samples[i], 7 + i);
+  }
+}
+
+TEST(SpeechSegmentRing, MaxNumSegments) {
+  SpeechSegmentRing ring(100, 2);
+  PushSegment(&ring, 0, {1});
+  PushSegment(&ring, 1, {2});
+  EXPECT_EQ(ring.Reserve(1), nullptr);
+
+  ring.Release();
+  EXPECT_NE(ring.Reserve(1), nullptr);
+}
+
+TEST(SpeechSegmentRing, ProducerConsumer) {
+  SpeechSegmentRing ring(64, 8);
+  int32_t num_segments = 10000;
+
+  std::thread producer([&ring, num_segments]() {
+    for (int32_t i = 0; i != num_segments; ++i) {
+      int32_t n = i % 13 + 1;
+      float *p = nullptr;
+      while ((p = ring.Reserve(n)) == nullptr) {
+        std::this_thread::yield();
+      }
+      std::fill(p, p + n, static_cast<float>(i));
+      ring.Commit(i, n);
+    }
+  });
+
+  for (int32_t i = 0; i != num_segments; ++i) {
+    while (ring.Empty()) {
+      std::this_thread::yield();
+    }
+
+    auto v = ring.Front();
+    ASSERT_EQ(v.start, i);
+    ASSERT_EQ(v.n, i % 13 + 1);
+    for (int32_t k = 0; k != v.n; ++k) {
+      ASSERT_EQ(v.samples[k], static_cast<float>(i));
+    }
+    ring.Release();
+  }
+
+  producer.join();
+  EXPECT_TRUE(ring.Empty());
+}
+
+}  // namespace sherpa_onnx
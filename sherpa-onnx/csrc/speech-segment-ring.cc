@@ -0,0 +1,127 @@
+// sherpa-onnx/csrc/speech-segment-ring.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/speech-segment-ring.h"
+
+#include "sherpa-onnx/csrc/macros.h"
+
+namespace sherpa_onnx {
+
+SpeechSegmentRing::SpeechSegmentRing(int32_t capacity,
+                                     int32_t max_num_segments) {
+  if (capacity <= 0 || max_num_segments <= 0) {
+    SHERPA_ONNX_LOGE(
+        "Please specify a positive capacity and max_num_segments. Given: %d, "
+        "%d",
+        capacity, max_num_segments);
+    SHERPA_ONNX_EXIT(-1);
+  }
+
+  buffer_.resize(capacity);
+  entries_.resize(max_num_segments);
+}
+
+float *SpeechSegmentRing::Reserve(int32_t n) {
+  int64_t capacity = buffer_.size();
+  if (n <= 0 || n > capacity) {
+    return nullptr;
+  }
+
+  int64_t num_entries = entries_.size();
+  if (entry_tail_.load(std::memory_order_relaxed) -
+          entry_head_.load(std::memory_order_acquire) >=
+      num_entries) {
+    return nullptr;
+  }
+
+  int64_t w = write_pos_.load(std::memory_order_relaxed);
+  int64_t offset = w % capacity;
+  if (offset + n > capacity) {
+    // skip the remaining space so that the segment is contiguous
+    w += capacity - offset;
+    offset = 0;
+  }
+
+  if (w + n - read_pos_.load(std::memory_order_acquire) > capacity) {
+    return nullptr;
+  }
+
+  reserved_pos_ = w;
+
+  return buffer_.data() + offset;
+}
+
+void SpeechSegmentRing::Commit(int32_t start, int32_t n) {
+  if (reserved_pos_ == -1) {
+    SHERPA_ONNX_LOGE("Please call Reserve() before calling Commit()");
+    return;
+  }
+
+  int64_t tail = entry_tail_.load(std::memory_order_relaxed);
+
+  Entry &e = entries_[tail % static_cast<int64_t>(entries_.size())];
+  e.start = start;
+  e.begin = reserved_pos_;
+  e.n = n;
+
+  write_pos_.store(reserved_pos_ + n, std::memory_order_relaxed);
+  reserved_pos_ = -1;
+
+  // Make the samples and the entry visible to the consumer
+  entry_tail_.store(tail + 1, std::memory_order_release);
+}
+
+bool SpeechSegmentRing::Empty() const {
+  return entry_head_.load(std::memory_order_relaxed) ==
+         entry_tail_.load(std::memory_order_acquire);
+}
+
+SpeechSegmentView SpeechSegmentRing::Front() const {
+  SpeechSegmentView ans;
+  if (Empty()) {
+    SHERPA_ONNX_LOGE(
+        "Make sure you call this method only when Empty() returns false; "
+        "Return an empty segment");
+    return ans;
+  }
+
+  int64_t head = entry_head_.load(std::memory_order_relaxed);
+  const Entry &e = entries_[head % static_cast<int64_t>(entries_.size())];
+
+  ans.start = e.start;
+  ans.samples = buffer_.data() + e.begin % static_cast<int64_t>(buffer_.size());
+  ans.n = e.n;
+
+  return ans;
+}
+
+void SpeechSegmentRing::Release() {
+  if (Empty()) {
+    SHERPA_ONNX_LOGE("There are no segments to release");
+    return;
+  }
+
+  int64_t head = entry_head_.load(std::memory_order_relaxed);
+  const Entry &e = entries_[head % static_cast<int64_t>(entries_.size())];
+
+  // Everything before the end of this segment, including the space skipped
+  // for it, can be reused by the producer.
+  read_pos_.store(e.begin + e.n, std::memory_order_release);
+  entry_head_.store(head + 1, std::memory_order_release);
+}
+
+int32_t SpeechSegmentRing::NumSegments() const {
+  return static_cast<int32_t>(entry_tail_.load(std::memory_order_acquire) -
+                              entry_head_.load(std::memory_order_acquire));
+}
+
+void SpeechSegmentRing::Reset() {
+  write_pos_.store(0);
+  entry_tail_.store(0);
+  read_pos_.store(0);
+  entry_head_.store(0);
+  reserved_pos_ = -1;
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,95 @@
+// sherpa-onnx/csrc/speech-segment-ring.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#ifndef SHERPA_ONNX_CSRC_SPEECH_SEGMENT_RING_H_
+#define SHERPA_ONNX_CSRC_SPEECH_SEGMENT_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace sherpa_onnx {
+
+// A view of a speech segment stored inside a SpeechSegmentRing.
+//
+// samples points into the ring and stays valid until the segment
+// is released with SpeechSegmentRing::Release().
+struct SpeechSegmentView {
+  int32_t start = -1;  // in samples
+  const float *samples = nullptr;
+  int32_t n = 0;  // number of samples
+};
+
+// A fixed-capacity ring of speech segments.
+//
+// It is safe to use it from exactly one producer thread (Reserve() and
+// Commit()) and one consumer thread (Empty(), Front() and Release())
+// at the same time without any locks. No memory is allocated after
+// construction.
+//
+// Samples of a segment are always contiguous. If a segment does not fit
+// into the remaining space at the end of the buffer, it is placed at the
+// beginning and the remaining space is skipped.
+class SpeechSegmentRing {
+ public:
+  // @param capacity Number of samples the ring can hold
+  // @param max_num_segments Maximum number of segments the ring can hold
+  SpeechSegmentRing(int32_t capacity, int32_t max_num_segments);
+
+  // Producer side.
+  //
+  // Return a pointer to n writable samples, or nullptr if there is not
+  // enough free space. The returned memory is not visible to the consumer
+  // until Commit() is called.
+  float *Reserve(int32_t n);
+
+  // Publish the n samples returned by the last Reserve(n) as a segment.
+  //
+  // @param start Start of the segment in samples
+  void Commit(int32_t start, int32_t n);
+
+  // Consumer side.
+  bool Empty() const;
+
+  // It is an error to call it if Empty() returns true.
+  SpeechSegmentView Front() const;
+
+  // Give the memory of the oldest segment back to the producer.
+  // Segments must be released in the order they are returned by Front().
+  void Release();
+
+  // Number of segments that are committed but not released
+  int32_t NumSegments() const;
+
+  // Drop all segments. Neither the producer nor the consumer can
+  // be running when this method is called.
+  void Reset();
+
+  int32_t Capacity() const { return static_cast<int32_t>(buffer_.size()); }
+
+ private:
+  struct Entry {
+    int32_t start = 0;
+    int64_t begin = 0;  // linear index into buffer_
+    int32_t n = 0;
+  };
+
+  std::vector<float> buffer_;
+  std::vector<Entry> entries_;
+
+  // Linear indexes; always increasing; never wrap around.
+  // Written only by the producer.
+  std::atomic<int64_t> write_pos_{0};
+  std::atomic<int64_t> entry_tail_{0};
+
+  // Written only by the consumer.
+  std::atomic<int64_t> read_pos_{0};
+  std::atomic<int64_t> entry_head_{0};
+
+  // Position returned by the last Reserve(). Used only by the producer.
+  int64_t reserved_pos_ = -1;
+};
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_SPEECH_SEGMENT_RING_H_
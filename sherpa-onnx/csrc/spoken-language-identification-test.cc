@@ -0,0 +1,123 @@
+// sherpa-onnx/csrc/spoken-language-identification-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/spoken-language-identification.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sherpa-onnx/csrc/file-utils.h"
+#include "sherpa-onnx/csrc/macros.h"
+#include "sherpa-onnx/csrc/offline-recognizer.h"
+#include "sherpa-onnx/csrc/offline-whisper-model.h"
+#include "sherpa-onnx/csrc/wave-reader.h"
+
+namespace sherpa_onnx {
+
+// Please download
+// https://github.com/k2-fsa/sherpa-onnx/releases/download/asr-models/sherpa-onnx-whisper-tiny.tar.bz2
+// and extract it to /tmp for testing
+static const char dir[] = "/tmp/sherpa-onnx-whisper-tiny";
+
+TEST(SpokenLanguageIdentification, KeepEncoderOutput) {
+  std::string encoder = std::string(dir) + "/tiny-encoder.onnx";
+  std::string decoder = std::string(dir) + "/tiny-decoder.onnx";
+  std::string tokens = std::string(dir) + "/tiny-tokens.txt";
+  std::string wave_filename = std::string(dir) + "/test_wavs/0.wav";
+
+  if (!FileExists(encoder) || !FileExists(decoder) || !FileExists(tokens) ||
+      !FileExists(wave_filename)) {
+    SHERPA_ONNX_LOGE(
+        "No test data found, skipping KeepEncoderOutput(). You can download "
+        "the test data from "
+        "https://github.com/k2-fsa/sherpa-onnx/releases/download/asr-models/"
+        "sherpa-onnx-whisper-tiny.tar.bz2 and extract it to /tmp");
+    return;
+  }
+
+  int32_t sampling_rate = -1;
+  bool is_ok = false;
+  std::vector<float> samples =
+      ReadWave(wave_filename, &sampling_rate, &is_ok);
+  ASSERT_TRUE(is_ok);
+
+  SpokenLanguageIdentificationConfig slid_config;
+  slid_config.whisper.encoder = encoder;
+  slid_config.whisper.decoder = decoder;
+  SpokenLanguageIdentification slid(slid_config);
+
+  OfflineRecognizerConfig asr_config;
+  asr_config.model_config.whisper.encoder = encoder;
+  asr_config.model_config.whisper.decoder = decoder;
+  asr_config.model_config.tokens = tokens;
+  asr_config.model_config.num_threads = 1;
+  OfflineRecognizer recognizer(asr_config);
+
+  // The first 3 streams are of the same length, so they are decoded in
+  // the same batch and the batched encoder output is split for them.
+  // The last stream is decoded alone.
+  std::vector<int32_t> lengths = {
+      static_cast<int32_t>(samples.size()),
+      static_cast<int32_t>(samples.size()),
+      static_cast<int32_t>(samples.size()),
+      static_cast<int32_t>(samples.size() / 2),
+  };
+
+  std::vector<std::unique_ptr<OfflineStream>> streams;
+  std::vector<OfflineStream *> ss;
+  for (int32_t n : lengths) {
+    streams.push_back(slid.CreateStream());
+    streams.back()->SetOption("keep_encoder_output", "1");
+    streams.back()->AcceptWaveform(sampling_rate, samples.data(), n);
+    ss.push_back(streams.back().get());
+  }
+
+  std::vector<std::string> langs =
+      slid.Compute(ss.data(), static_cast<int32_t>(ss.size()));
+  for (const auto &lang : langs) {
+    EXPECT_EQ(lang, "en");
+  }
+
+  // The same number of frames as used by the recognizer
+  int32_t feat_dim = ss[0]->FeatureDim();
+  std::vector<std::string> keys;
+  for (auto s : ss) {
+    int32_t num_frames = s->GetFrames().size() / feat_dim;
+    int32_t actual_frames = std::min(num_frames + 1000, 3000);
+    keys.push_back(OfflineWhisperModel::EncoderOutputKey(encoder,
+                                                         actual_frames));
+  }
+
+  for (int32_t i = 0; i != static_cast<int32_t>(ss.size()); ++i) {
+    std::vector<Ort::Value> out = ss[i]->TakeEncoderOutput(keys[i]);
+    ASSERT_EQ(out.size(), 2);
+
+    // (n_text_layer, 1, n_audio_ctx, n_text_state)
+    EXPECT_EQ(out[0].GetTensorTypeAndShapeInfo().GetShape()[1], 1);
+    EXPECT_EQ(out[1].GetTensorTypeAndShapeInfo().GetShape()[1], 1);
+
+    // put it back for the recognizer
+    ss[i]->SetEncoderOutput(keys[i], std::move(out));
+  }
+
+  recognizer.DecodeStreams(ss.data(), static_cast<int32_t>(ss.size()));
+
+  for (int32_t i = 0; i != static_cast<int32_t>(ss.size()); ++i) {
+    // the recognizer has used the cached encoder output
+    EXPECT_TRUE(ss[i]->TakeEncoderOutput(keys[i]).empty());
+
+    // and the result is the same as the one without the cache
+    auto s = recognizer.CreateStream();
+    s->AcceptWaveform(sampling_rate, samples.data(), lengths[i]);
+    recognizer.DecodeStream(s.get());
+
+    EXPECT_EQ(ss[i]->GetResult().text, s->GetResult().text);
+    EXPECT_FALSE(s->GetResult().text.empty());
+  }
+}
+
+}  // namespace sherpa_onnx
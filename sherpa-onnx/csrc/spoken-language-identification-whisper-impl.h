@@ -6,6 +6,7 @@
 #define SHERPA_ONNX_CSRC_SPOKEN_LANGUAGE_IDENTIFICATION_WHISPER_IMPL_H_
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <utility>
@@ -16,6 +17,7 @@
 #include "android/asset_manager_jni.h"
 #endif
 
+#include "sherpa-onnx/csrc/bucket-by-length.h"
 #include "sherpa-onnx/csrc/offline-whisper-model.h"
 #include "sherpa-onnx/csrc/macros.h"
 #include "sherpa-onnx/csrc/spoken-language-identification-impl.h"
@@ -94,6 +96,18 @@ class SpokenLanguageIdentificationWhisperImpl
     try {
       auto cross_kv = model_->ForwardEncoder(std::move(mel));
       int32_t lang_id = model_->DetectLanguage(cross_kv.first, cross_kv.second);
+
+      if (s->GetOptionInt("keep_encoder_output")) {
+        // so that a whisper recognizer with the same encoder can decode
+        // this stream without running the encoder again
+        std::vector<Ort::Value> out;
+        out.push_back(std::move(cross_kv.first));
+        out.push_back(std::move(cross_kv.second));
+        s->SetEncoderOutput(OfflineWhisperModel::EncoderOutputKey(
+                                config_.whisper.encoder, actual_frames),
+                            std::move(out));
+      }
+
       const auto &id2lang = model_->GetID2Lang();
       if (id2lang.count(lang_id)) {
         return id2lang.at(lang_id);
@@ -113,7 +127,157 @@ class SpokenLanguageIdentificationWhisperImpl
     }
   }
 
+  std::vector<std::string> Compute(OfflineStream **ss,
+                                   int32_t n) const override {
+    int32_t max_num_frames = 3000;
+
+    int32_t tail_padding_frames = 1000;
+    if (config_.whisper.tail_paddings > 0) {
+      tail_padding_frames = config_.whisper.tail_paddings;
+    }
+
+    std::vector<std::vector<float>> features_vec(n);
+    std::vector<int32_t> num_frames(n);
+    std::vector<int32_t> actual_frames(n);
+
+    int32_t feat_dim = n > 0 ? ss[0]->FeatureDim() : 0;
+
+    for (int32_t i = 0; i != n; ++i) {
+      features_vec[i] = ss[i]->GetFrames();
+      num_frames[i] = features_vec[i].size() / feat_dim;
+
+      // we use 50 here so that there will be some zero tail paddings
+      if (num_frames[i] >= max_num_frames - 50) {
+        SHERPA_ONNX_LOGE(
+            "Only waves less than 30 seconds are supported. We process only "
+            "the first 30 seconds and discard the remaining data");
+        num_frames[i] = max_num_frames - 50;
+      }
+
+      model_->NormalizeFeatures(features_vec[i].data(), num_frames[i],
+                                feat_dim);
+
+      actual_frames[i] =
+          std::min(num_frames[i] + tail_padding_frames, max_num_frames);
+    }
+
+    std::vector<std::string> ans(n);
+
+    // Streams in a batch are zero-padded to the same number of frames,
+    // which is the same as using a few more tail padding frames.
+    //
+    // Streams that keep the encoder output are batched only with streams
+    // of the same number of frames, so that the cached output is the same
+    // as the one a whisper recognizer would compute.
+    std::vector<int32_t> keep_indexes;
+    std::vector<int32_t> other_indexes;
+    for (int32_t i = 0; i != n; ++i) {
+      if (ss[i]->GetOptionInt("keep_encoder_output")) {
+        keep_indexes.push_back(i);
+      } else {
+        other_indexes.push_back(i);
+      }
+    }
+
+    std::vector<std::vector<int32_t>> batches;
+    for (const auto *indexes : {&keep_indexes, &other_indexes}) {
+      std::vector<int32_t> lengths;
+      lengths.reserve(indexes->size());
+      for (int32_t i : *indexes) {
+        lengths.push_back(actual_frames[i]);
+      }
+
+      float max_ratio = indexes == &keep_indexes ? 1 : 1.2;
+      for (auto &batch : BucketByLength(lengths, kMaxBatchSize, max_ratio)) {
+        for (auto &i : batch) {
+          i = (*indexes)[i];
+        }
+        batches.push_back(std::move(batch));
+      }
+    }
+
+    const auto &id2lang = model_->GetID2Lang();
+
+    for (const auto &batch : batches) {
+      int32_t batch_size = static_cast<int32_t>(batch.size());
+      int32_t frames = actual_frames[batch.back()];
+
+      std::array<int64_t, 3> shape{batch_size, frames, feat_dim};
+
+      Ort::Value mel = Ort::Value::CreateTensor<float>(
+          model_->Allocator(), shape.data(), shape.size());
+
+      float *p_mel = mel.GetTensorMutableData<float>();
+      std::fill_n(p_mel, batch_size * frames * feat_dim, 0);
+
+      for (int32_t b = 0; b != batch_size; ++b) {
+        const auto &f = features_vec[batch[b]];
+        std::copy(f.data(), f.data() + num_frames[batch[b]] * feat_dim,
+                  p_mel + b * frames * feat_dim);
+      }
+
+      mel = Transpose12(model_->Allocator(), &mel);
+
+      try {
+        auto cross_kv = model_->ForwardEncoder(std::move(mel));
+        std::vector<int32_t> lang_ids =
+            model_->DetectLanguages(cross_kv.first, cross_kv.second);
+
+        for (int32_t b = 0; b != batch_size; ++b) {
+          if (id2lang.count(lang_ids[b])) {
+            ans[batch[b]] = id2lang.at(lang_ids[b]);
+          } else {
+            SHERPA_ONNX_LOGE("Unknown language ID: %d. Return an empty string.",
+                             lang_ids[b]);
+          }
+        }
+
+        if (ss[batch[0]]->GetOptionInt("keep_encoder_output")) {
+          // so that a whisper recognizer with the same encoder can decode
+          // these streams without running the encoder again
+          KeepEncoderOutput(ss, batch, frames, std::move(cross_kv.first),
+                            std::move(cross_kv.second));
+        }
+      } catch (const Ort::Exception &ex) {
+        SHERPA_ONNX_LOGE(
+            "\n\nCaught exception:\n\n%s\n\nReturn empty results for %d "
+            "streams. Number of input frames: %d, Current tail paddings: %d. "
+            "If you see a lot of such exceptions, please consider using a "
+            "larger --whisper-tail-paddings",
+            ex.what(), batch_size, frames, tail_padding_frames);
+      }
+    }
+
+    return ans;
+  }
+
  private:
+  static constexpr int32_t kMaxBatchSize = 8;
+
+  void KeepEncoderOutput(OfflineStream **ss, const std::vector<int32_t> &batch,
+                         int32_t num_frames, Ort::Value cross_k,
+                         Ort::Value cross_v) const {
+    std::string key =
+        OfflineWhisperModel::EncoderOutputKey(config_.whisper.encoder,
+                                              num_frames);
+
+    if (batch.size() == 1) {
+      std::vector<Ort::Value> out;
+      out.push_back(std::move(cross_k));
+      out.push_back(std::move(cross_v));
+      ss[batch[0]]->SetEncoderOutput(key, std::move(out));
+      return;
+    }
+
+    auto split = model_->SplitEncoderOutput(cross_k, cross_v);
+    for (int32_t b = 0; b != static_cast<int32_t>(split.size()); ++b) {
+      std::vector<Ort::Value> out;
+      out.push_back(std::move(split[b].first));
+      out.push_back(std::move(split[b].second));
+      ss[batch[b]]->SetEncoderOutput(key, std::move(out));
+    }
+  }
+
   void Check() const {
     if (!model_->IsMultiLingual()) {
       SHERPA_ONNX_LOGE(
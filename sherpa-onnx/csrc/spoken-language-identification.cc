@@ -128,4 +128,9 @@ std::string SpokenLanguageIdentification::Compute(OfflineStream *s) const {
   return impl_->Compute(s);
 }
 
+std::vector<std::string> SpokenLanguageIdentification::Compute(
+    OfflineStream **ss, int32_t n) const {
+  return impl_->Compute(ss, n);
+}
+
 }  // namespace sherpa_onnx
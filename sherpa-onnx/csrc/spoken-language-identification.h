@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #if __ANDROID_API__ >= 9
 #include "android/asset_manager.h"
@@ -88,8 +89,19 @@ class SpokenLanguageIdentification {
   // Return a string containing the language, e.g., en, zh, de,
   // etc.
   // Note: en is for English, zh is for Chinese, de is for German, etc.
+  //
+  // For whisper models, if the option keep_encoder_output of the stream is
+  // set to 1, the encoder output is kept in the stream. Passing the stream
+  // to an OfflineRecognizer using the same whisper encoder and tail paddings
+  // then skips the encoder.
   std::string Compute(OfflineStream *s) const;
 
+  // Process n streams in batches. Streams of similar lengths are put into
+  // the same batch.
+  //
+  // ans[i] contains the language of ss[i]
+  std::vector<std::string> Compute(OfflineStream **ss, int32_t n) const;
+
  private:
   std::unique_ptr<SpokenLanguageIdentificationImpl> impl_;
 };
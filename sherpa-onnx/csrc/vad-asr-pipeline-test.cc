@@ -0,0 +1,211 @@
+// sherpa-onnx/csrc/vad-asr-pipeline-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/vad-asr-pipeline.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace sherpa_onnx {
+
+static int32_t NumFrames(const OfflineStream *s) {
+  return static_cast<int32_t>(s->GetFrames().size()) / s->FeatureDim();
+}
+
+static SpeechSegment MakeSegment(int32_t start, float duration) {
+  SpeechSegment segment;
+  segment.start = start;
+  segment.samples.resize(static_cast<int32_t>(duration * 16000));
+  for (int32_t i = 0; i != static_cast<int32_t>(segment.samples.size());
+       ++i) {
+    segment.samples[i] = (i % 100) / 1000.0f;
+  }
+
+  return segment;
+}
+
+static std::unique_ptr<OfflineStream> CreateStream() {
+  return std::make_unique<OfflineStream>();
+}
+
+TEST(VadAsrPipeline, OrderedDeliveryPerSource) {
+  VadAsrPipelineConfig config;
+  config.num_workers = 4;
+  config.max_batch_size = 1;
+
+  // Longer segments take longer to decode, so their results are ready
+  // after those of later, shorter segments.
+  VadAsrPipeline pipeline(
+      config, CreateStream, [](OfflineStream **ss, int32_t n) {
+        for (int32_t i = 0; i != n; ++i) {
+          int32_t num_frames = NumFrames(ss[i]);
+          std::this_thread::sleep_for(std::chrono::milliseconds(num_frames));
+
+          OfflineRecognitionResult r;
+          r.text = std::to_string(num_frames);
+          ss[i]->SetResult(r);
+        }
+      });
+
+  std::vector<float> durations = {1.5, 0.2, 0.3, 1.2, 0.2, 0.5};
+
+  std::mutex mutex;
+  std::map<int32_t, std::vector<VadAsrSegmentResult>> results;
+
+  std::vector<int32_t> sources;
+  for (int32_t i = 0; i != 3; ++i) {
+    sources.push_back(pipeline.AddSource(
+        [&mutex, &results](int32_t source_id, const VadAsrSegmentResult &r) {
+          std::lock_guard<std::mutex> lock(mutex);
+          results[source_id].push_back(r);
+        }));
+  }
+
+  for (int32_t i = 0; i != static_cast<int32_t>(durations.size()); ++i) {
+    for (int32_t k = 0; k != static_cast<int32_t>(sources.size()); ++k) {
+      // use a different order of segments for each source
+      float d = durations[(i + k) % durations.size()];
+      pipeline.AcceptSegment(sources[k], MakeSegment(i * 32000, d));
+    }
+  }
+
+  for (auto s : sources) {
+    pipeline.InputFinished(s);
+  }
+
+  pipeline.Wait();
+
+  ASSERT_EQ(results.size(), sources.size());
+  for (int32_t k = 0; k != static_cast<int32_t>(sources.size()); ++k) {
+    const auto &v = results[sources[k]];
+    ASSERT_EQ(v.size(), durations.size());
+
+    for (int32_t i = 0; i != static_cast<int32_t>(v.size()); ++i) {
+      EXPECT_EQ(v[i].index, i);
+      EXPECT_FLOAT_EQ(v[i].start, i * 2.0f);
+      EXPECT_NEAR(v[i].duration, durations[(i + k) % durations.size()],
+                  1e-4);
+      EXPECT_FALSE(v[i].result.text.empty());
+    }
+  }
+}
+
+TEST(VadAsrPipeline, LengthBucketedBatching) {
+  VadAsrPipelineConfig config;
+  config.num_workers = 1;
+  config.max_batch_size = 3;
+  config.max_length_ratio = 1.5;
+  config.min_segment_duration = 0.1;
+
+  std::promise<void> started;
+  std::promise<void> release;
+  std::shared_future<void> release_future = release.get_future().share();
+
+  std::mutex mutex;
+  std::vector<std::vector<int32_t>> batches;  // number of frames
+
+  VadAsrPipeline pipeline(
+      config, CreateStream, [&](OfflineStream **ss, int32_t n) {
+        std::vector<int32_t> batch;
+        for (int32_t i = 0; i != n; ++i) {
+          batch.push_back(NumFrames(ss[i]));
+          ss[i]->SetResult({});
+        }
+
+        bool is_first = false;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          batches.push_back(batch);
+          is_first = batches.size() == 1;
+        }
+
+        if (is_first) {
+          // keep the only worker busy until all segments are queued
+          started.set_value();
+          release_future.wait();
+        }
+      });
+
+  int32_t num_results = 0;
+  int32_t source = pipeline.AddSource(
+      [&num_results](int32_t, const VadAsrSegmentResult &) { ++num_results; });
+
+  pipeline.AcceptSegment(source, MakeSegment(0, 1.0f));
+  started.get_future().wait();
+
+  // too short, discarded
+  pipeline.AcceptSegment(source, MakeSegment(0, 0.05f));
+
+  for (float d : {1.0f, 3.0f, 1.1f, 3.2f, 1.2f, 3.1f, 1.0f}) {
+    pipeline.AcceptSegment(source, MakeSegment(0, d));
+  }
+  pipeline.InputFinished(source);
+
+  release.set_value();
+  pipeline.Wait();
+
+  EXPECT_EQ(num_results, 8);
+
+  // The oldest queued segment is decoded together with the following
+  // segments of similar length, at most max_batch_size of them.
+  ASSERT_EQ(batches.size(), 4);
+  EXPECT_EQ(batches[0].size(), 1);
+  EXPECT_EQ(batches[1].size(), 3);
+  EXPECT_EQ(batches[2].size(), 3);
+  EXPECT_EQ(batches[3].size(), 1);
+
+  for (const auto &b : batches) {
+    int32_t min_frames = *std::min_element(b.begin(), b.end());
+    int32_t max_frames = *std::max_element(b.begin(), b.end());
+    EXPECT_LE(max_frames, config.max_length_ratio * min_frames);
+  }
+
+  // segments of about 1 second, then those of about 3 seconds
+  EXPECT_LT(batches[1][0], 150);
+  EXPECT_GT(batches[2][0], 250);
+}
+
+TEST(VadAsrPipeline, CallbackFeedsSameSource) {
+  VadAsrPipelineConfig config;
+  config.num_workers = 2;
+
+  VadAsrPipeline pipeline(config, CreateStream,
+                          [](OfflineStream **ss, int32_t n) {
+                            for (int32_t i = 0; i != n; ++i) {
+                              ss[i]->SetResult({});
+                            }
+                          });
+
+  // Each result queues the next segment of the same source from the
+  // callback, which must not deadlock
+  std::vector<int32_t> indexes;
+  int32_t source = -1;
+  source = pipeline.AddSource(
+      [&](int32_t source_id, const VadAsrSegmentResult &r) {
+        EXPECT_EQ(source_id, source);
+        indexes.push_back(r.index);
+
+        if (r.index < 4) {
+          pipeline.AcceptSegment(source_id, MakeSegment(0, 0.5f));
+        } else {
+          pipeline.InputFinished(source_id);
+        }
+      });
+
+  pipeline.AcceptSegment(source, MakeSegment(0, 0.5f));
+  pipeline.Wait();
+
+  EXPECT_EQ(indexes, (std::vector<int32_t>{0, 1, 2, 3, 4}));
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,462 @@
+// sherpa-onnx/csrc/vad-asr-pipeline.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/vad-asr-pipeline.h"
+
+#include <algorithm>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sherpa-onnx/csrc/macros.h"
+
+namespace sherpa_onnx {
+
+void VadAsrPipelineConfig::Register(ParseOptions *po) {
+  vad_config.Register(po);
+  asr_config.Register(po);
+
+  po->Register("pipeline-num-workers", &num_workers,
+               "Number of threads decoding speech segments");
+
+  po->Register("pipeline-max-batch-size", &max_batch_size,
+               "Maximum number of speech segments decoded together");
+
+  po->Register("pipeline-max-length-ratio", &max_length_ratio,
+               "Speech segments in a batch differ in length by at most this "
+               "factor");
+
+  po->Register("pipeline-min-segment-duration", &min_segment_duration,
+               "Speech segments shorter than this value (in seconds) are "
+               "discarded");
+
+  po->Register("pipeline-vad-buffer-size", &vad_buffer_size_in_seconds,
+               "Size of the VAD buffer of each audio source in seconds");
+}
+
+bool VadAsrPipelineConfig::Validate() const {
+  if (!vad_config.Validate()) {
+    return false;
+  }
+
+  if (!asr_config.Validate()) {
+    return false;
+  }
+
+  if (num_workers < 1) {
+    SHERPA_ONNX_LOGE("--pipeline-num-workers should be >= 1. Given: %d",
+                     num_workers);
+    return false;
+  }
+
+  if (max_batch_size < 1) {
+    SHERPA_ONNX_LOGE("--pipeline-max-batch-size should be >= 1. Given: %d",
+                     max_batch_size);
+    return false;
+  }
+
+  if (max_length_ratio < 1) {
+    SHERPA_ONNX_LOGE("--pipeline-max-length-ratio should be >= 1. Given: %.3f",
+                     max_length_ratio);
+    return false;
+  }
+
+  if (vad_buffer_size_in_seconds <= 0) {
+    SHERPA_ONNX_LOGE("--pipeline-vad-buffer-size should be > 0. Given: %.3f",
+                     vad_buffer_size_in_seconds);
+    return false;
+  }
+
+  return true;
+}
+
+std::string VadAsrPipelineConfig::ToString() const {
+  std::ostringstream os;
+
+  os << "VadAsrPipelineConfig(";
+  os << "vad_config=" << vad_config.ToString() << ", ";
+  os << "asr_config=" << asr_config.ToString() << ", ";
+  os << "num_workers=" << num_workers << ", ";
+  os << "max_batch_size=" << max_batch_size << ", ";
+  os << "max_length_ratio=" << max_length_ratio << ", ";
+  os << "min_segment_duration=" << min_segment_duration << ", ";
+  os << "vad_buffer_size_in_seconds=" << vad_buffer_size_in_seconds << ")";
+
+  return os.str();
+}
+
+class VadAsrPipeline::Impl {
+ public:
+  explicit Impl(const VadAsrPipelineConfig &config)
+      : config_(config),
+        recognizer_(std::make_unique<OfflineRecognizer>(config.asr_config)) {
+    create_stream_ = [this]() { return recognizer_->CreateStream(); };
+    decode_streams_ = [this](OfflineStream **ss, int32_t n) {
+      recognizer_->DecodeStreams(ss, n);
+    };
+
+    StartWorkers();
+  }
+
+  Impl(const VadAsrPipelineConfig &config,
+       VadAsrCreateStreamFunc create_stream,
+       VadAsrDecodeStreamsFunc decode_streams)
+      : config_(config),
+        create_stream_(std::move(create_stream)),
+        decode_streams_(std::move(decode_streams)) {
+    StartWorkers();
+  }
+
+  ~Impl() {
+    Wait();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto &t : workers_) {
+      t.join();
+    }
+  }
+
+  int32_t AddSource(VadAsrResultCallback callback) {
+    auto source = std::make_shared<Source>();
+    source->callback = std::move(callback);
+
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    source->id = next_source_id_++;
+    sources_[source->id] = source;
+
+    return source->id;
+  }
+
+  void AcceptWaveform(int32_t source_id, const float *samples, int32_t n) {
+    auto source = GetSource(source_id);
+    if (!source) {
+      return;
+    }
+
+    // The VAD is created on first use so that sources fed by
+    // AcceptSegment() do not need one
+    if (!source->vad) {
+      source->vad = std::make_unique<VoiceActivityDetector>(
+          config_.vad_config, config_.vad_buffer_size_in_seconds);
+    }
+
+    source->vad->AcceptWaveform(samples, n);
+    QueueSegments(source);
+  }
+
+  void AcceptSegment(int32_t source_id, const SpeechSegment &segment) {
+    auto source = GetSource(source_id);
+    if (!source) {
+      return;
+    }
+
+    QueueSegment(source, segment);
+  }
+
+  void InputFinished(int32_t source_id) {
+    auto source = GetSource(source_id);
+    if (!source) {
+      return;
+    }
+
+    if (source->vad) {
+      source->vad->Flush();
+      QueueSegments(source);
+    }
+
+    bool done = false;
+    {
+      std::lock_guard<std::mutex> lock(source->mutex);
+      source->input_finished = true;
+      done = !source->delivering &&
+             source->next_index == source->num_segments;
+    }
+
+    if (done) {
+      RemoveSource(source_id);
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return num_unfinished_ == 0; });
+  }
+
+  const VadAsrPipelineConfig &GetConfig() const { return config_; }
+
+ private:
+  struct Source {
+    int32_t id = 0;
+    std::unique_ptr<VoiceActivityDetector> vad;  // may be nullptr
+    VadAsrResultCallback callback;
+
+    // The following members are protected by mutex
+    std::mutex mutex;
+    int32_t num_segments = 0;
+    int32_t next_index = 0;  // index of the next result to deliver
+    bool input_finished = false;
+
+    // true while a worker is calling the callback. Other workers only
+    // add their results to pending, so that the callback is never called
+    // concurrently and results are delivered in order.
+    bool delivering = false;
+
+    // results that cannot be delivered yet since an earlier segment
+    // is still being decoded
+    std::map<int32_t, VadAsrSegmentResult> pending;
+  };
+
+  struct Job {
+    std::shared_ptr<Source> source;
+    int32_t index = 0;
+    int32_t start = 0;        // in samples
+    int32_t num_samples = 0;  // used to group segments of similar length
+    std::unique_ptr<OfflineStream> stream;
+  };
+
+  std::shared_ptr<Source> GetSource(int32_t source_id) {
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    auto it = sources_.find(source_id);
+    if (it == sources_.end()) {
+      SHERPA_ONNX_LOGE("Unknown source: %d", source_id);
+      return nullptr;
+    }
+
+    return it->second;
+  }
+
+  void RemoveSource(int32_t source_id) {
+    std::lock_guard<std::mutex> lock(sources_mutex_);
+    sources_.erase(source_id);
+  }
+
+  void StartWorkers() {
+    workers_.reserve(config_.num_workers);
+    for (int32_t i = 0; i != config_.num_workers; ++i) {
+      workers_.emplace_back([this]() { Worker(); });
+    }
+  }
+
+  void QueueSegments(const std::shared_ptr<Source> &source) {
+    auto &vad = source->vad;
+    while (!vad->Empty()) {
+      QueueSegment(source, vad->Front());
+      vad->Pop();
+    }
+  }
+
+  void QueueSegment(const std::shared_ptr<Source> &source,
+                    const SpeechSegment &segment) {
+    int32_t sample_rate = config_.vad_config.sample_rate;
+    int32_t min_num_samples = config_.min_segment_duration * sample_rate;
+
+    int32_t n = static_cast<int32_t>(segment.samples.size());
+    if (n < min_num_samples) {
+      return;
+    }
+
+    Job job;
+    job.source = source;
+    job.start = segment.start;
+    job.num_samples = n;
+
+    // Features are computed here so that the workers only run the model
+    job.stream = create_stream_();
+    job.stream->AcceptWaveform(sample_rate, segment.samples.data(), n);
+
+    {
+      std::lock_guard<std::mutex> lock(source->mutex);
+      job.index = source->num_segments++;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(job));
+      ++num_unfinished_;
+    }
+    cv_.notify_one();
+  }
+
+  // Take the oldest job and other queued jobs of similar length.
+  // Must be called with mutex_ held.
+  std::vector<Job> TakeBatch() {
+    std::vector<Job> batch;
+    batch.reserve(config_.max_batch_size);
+
+    float n0 = queue_.front().num_samples;
+    for (auto it = queue_.begin();
+         it != queue_.end() &&
+         static_cast<int32_t>(batch.size()) < config_.max_batch_size;) {
+      float n = it->num_samples;
+      if (std::max(n, n0) <= config_.max_length_ratio * std::min(n, n0)) {
+        batch.push_back(std::move(*it));
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    return batch;
+  }
+
+  void Worker() {
+    while (true) {
+      std::vector<Job> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+          return;
+        }
+
+        batch = TakeBatch();
+      }
+
+      std::vector<OfflineStream *> ss(batch.size());
+      for (int32_t i = 0; i != static_cast<int32_t>(batch.size()); ++i) {
+        ss[i] = batch[i].stream.get();
+      }
+
+      decode_streams_(ss.data(), ss.size());
+
+      for (auto &job : batch) {
+        Deliver(&job);
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        num_unfinished_ -= batch.size();
+        if (num_unfinished_ == 0) {
+          done_cv_.notify_all();
+        }
+      }
+    }
+  }
+
+  void Deliver(Job *job) {
+    float sample_rate = config_.vad_config.sample_rate;
+
+    VadAsrSegmentResult r;
+    r.index = job->index;
+    r.start = job->start / sample_rate;
+    r.duration = job->num_samples / sample_rate;
+    r.result = job->stream->GetResult();
+
+    job->stream.reset();
+
+    auto &source = job->source;
+    std::unique_lock<std::mutex> lock(source->mutex);
+    source->pending.emplace(r.index, std::move(r));
+
+    if (source->delivering) {
+      // The thread delivering results of this source will deliver it
+      return;
+    }
+    source->delivering = true;
+
+    while (true) {
+      std::vector<VadAsrSegmentResult> ready;
+      auto it = source->pending.begin();
+      while (it != source->pending.end() && it->first == source->next_index) {
+        ready.push_back(std::move(it->second));
+        ++source->next_index;
+        it = source->pending.erase(it);
+      }
+
+      if (ready.empty()) {
+        break;
+      }
+
+      // The callback may feed the same source or take a long time, so it
+      // is called without holding the lock
+      lock.unlock();
+      if (source->callback) {
+        for (const auto &result : ready) {
+          source->callback(source->id, result);
+        }
+      }
+      lock.lock();
+    }
+
+    source->delivering = false;
+    bool done = source->input_finished &&
+                source->next_index == source->num_segments;
+    lock.unlock();
+
+    if (done) {
+      RemoveSource(source->id);
+    }
+  }
+
+ private:
+  VadAsrPipelineConfig config_;
+
+  // nullptr if the user provides create_stream_ and decode_streams_
+  std::unique_ptr<OfflineRecognizer> recognizer_;
+  VadAsrCreateStreamFunc create_stream_;
+  VadAsrDecodeStreamsFunc decode_streams_;
+
+  std::mutex sources_mutex_;
+  std::unordered_map<int32_t, std::shared_ptr<Source>> sources_;
+  int32_t next_source_id_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable done_cv_;
+  std::deque<Job> queue_;
+  int32_t num_unfinished_ = 0;  // queued or being decoded
+  bool stop_ = false;
+
+  std::vector<std::thread> workers_;
+};
+
+VadAsrPipeline::VadAsrPipeline(const VadAsrPipelineConfig &config)
+    : impl_(std::make_unique<Impl>(config)) {}
+
+VadAsrPipeline::VadAsrPipeline(const VadAsrPipelineConfig &config,
+                               VadAsrCreateStreamFunc create_stream,
+                               VadAsrDecodeStreamsFunc decode_streams)
+    : impl_(std::make_unique<Impl>(config, std::move(create_stream),
+                                   std::move(decode_streams))) {}
+
+VadAsrPipeline::~VadAsrPipeline() = default;
+
+int32_t VadAsrPipeline::AddSource(VadAsrResultCallback callback) {
+  return impl_->AddSource(std::move(callback));
+}
+
+void VadAsrPipeline::AcceptWaveform(int32_t source_id, const float *samples,
+                                    int32_t n) {
+  impl_->AcceptWaveform(source_id, samples, n);
+}
+
+void VadAsrPipeline::AcceptSegment(int32_t source_id,
+                                   const SpeechSegment &segment) {
+  impl_->AcceptSegment(source_id, segment);
+}
+
+void VadAsrPipeline::InputFinished(int32_t source_id) {
+  impl_->InputFinished(source_id);
+}
+
+void VadAsrPipeline::Wait() { impl_->Wait(); }
+
+const VadAsrPipelineConfig &VadAsrPipeline::GetConfig() const {
+  return impl_->GetConfig();
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,136 @@
+// sherpa-onnx/csrc/vad-asr-pipeline.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+#ifndef SHERPA_ONNX_CSRC_VAD_ASR_PIPELINE_H_
+#define SHERPA_ONNX_CSRC_VAD_ASR_PIPELINE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "sherpa-onnx/csrc/offline-recognizer.h"
+#include "sherpa-onnx/csrc/parse-options.h"
+#include "sherpa-onnx/csrc/vad-model-config.h"
+#include "sherpa-onnx/csrc/voice-activity-detector.h"
+
+namespace sherpa_onnx {
+
+struct VadAsrPipelineConfig {
+  VadModelConfig vad_config;
+  OfflineRecognizerConfig asr_config;
+
+  // Number of threads decoding speech segments
+  int32_t num_workers = 2;
+
+  // Maximum number of segments decoded together
+  int32_t max_batch_size = 8;
+
+  // Segments in a batch differ in length by at most this factor. It limits
+  // the amount of padding in a batch.
+  float max_length_ratio = 1.5;
+
+  // Segments shorter than this (in seconds) are discarded
+  float min_segment_duration = 0.1;
+
+  // Size of the VAD buffer of each source in seconds
+  float vad_buffer_size_in_seconds = 60;
+
+  VadAsrPipelineConfig() = default;
+
+  VadAsrPipelineConfig(const VadModelConfig &vad_config,
+                       const OfflineRecognizerConfig &asr_config,
+                       int32_t num_workers, int32_t max_batch_size,
+                       float max_length_ratio, float min_segment_duration,
+                       float vad_buffer_size_in_seconds)
+      : vad_config(vad_config),
+        asr_config(asr_config),
+        num_workers(num_workers),
+        max_batch_size(max_batch_size),
+        max_length_ratio(max_length_ratio),
+        min_segment_duration(min_segment_duration),
+        vad_buffer_size_in_seconds(vad_buffer_size_in_seconds) {}
+
+  void Register(ParseOptions *po);
+  bool Validate() const;
+
+  std::string ToString() const;
+};
+
+struct VadAsrSegmentResult {
+  // Index of the segment within its source, starting from 0
+  int32_t index = 0;
+
+  // Start time of the segment in seconds
+  float start = 0;
+
+  // Duration of the segment in seconds
+  float duration = 0;
+
+  OfflineRecognitionResult result;
+};
+
+// Invoked from a worker thread. For a given source, it is invoked
+// once per segment in the order of the segments and never concurrently.
+using VadAsrResultCallback =
+    std::function<void(int32_t source_id, const VadAsrSegmentResult &result)>;
+
+// Create a stream for a speech segment
+using VadAsrCreateStreamFunc = std::function<std::unique_ptr<OfflineStream>()>;
+
+// Decode the given streams and set their results
+using VadAsrDecodeStreamsFunc =
+    std::function<void(OfflineStream **streams, int32_t n)>;
+
+// It runs a VAD for each audio source and decodes the speech segments
+// of all sources with a shared OfflineRecognizer. Segments of similar
+// length are decoded together with OfflineRecognizer::DecodeStreams()
+// on a pool of worker threads.
+//
+// Different sources can be fed from different threads. Calls for the
+// same source must not overlap.
+class VadAsrPipeline {
+ public:
+  explicit VadAsrPipeline(const VadAsrPipelineConfig &config);
+
+  // Like the above constructor, but segments are decoded with the given
+  // functions instead of an OfflineRecognizer created from
+  // config.asr_config, e.g., to share a recognizer with other code.
+  // decode_streams is called from the worker threads concurrently.
+  VadAsrPipeline(const VadAsrPipelineConfig &config,
+                 VadAsrCreateStreamFunc create_stream,
+                 VadAsrDecodeStreamsFunc decode_streams);
+
+  // It waits until all queued segments are decoded
+  ~VadAsrPipeline();
+
+  // Return the ID of the new source.
+  int32_t AddSource(VadAsrResultCallback callback);
+
+  // @param samples Samples at config.vad_config.sample_rate, normalized to
+  //                the range [-1, 1]
+  void AcceptWaveform(int32_t source_id, const float *samples, int32_t n);
+
+  // Queue a speech segment found by the caller, e.g., with its own VAD.
+  // Segments passed this way are decoded in the same way as segments
+  // found by AcceptWaveform(). Do not mix the two for the same source.
+  void AcceptSegment(int32_t source_id, const SpeechSegment &segment);
+
+  // Call it when there is no more audio for the given source. The last
+  // segment is queued and the source is removed once all its results are
+  // delivered.
+  void InputFinished(int32_t source_id);
+
+  // Block until all queued segments are decoded and their results
+  // delivered.
+  void Wait();
+
+  const VadAsrPipelineConfig &GetConfig() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_VAD_ASR_PIPELINE_H_
@@ -0,0 +1,160 @@
+// sherpa-onnx/csrc/vocoder-batcher.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/vocoder-batcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sherpa_onnx {
+
+class VocoderBatcher::Impl {
+ public:
+  Impl(std::unique_ptr<Vocoder> vocoder, int32_t max_batch_size,
+       int32_t max_wait_ms)
+      : vocoder_(std::move(vocoder)),
+        max_batch_size_(std::max(max_batch_size, 1)),
+        max_wait_ms_(std::max(max_wait_ms, 0)) {
+    worker_ = std::thread([this]() { Loop(); });
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  std::vector<float> Run(Ort::Value mel) {
+    Request r;
+    r.mel = std::move(mel);
+    r.num_frames = r.mel.GetTensorTypeAndShapeInfo().GetShape()[2];
+
+    auto f = r.promise.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(&r);
+    }
+    cv_.notify_all();
+
+    return f.get();
+  }
+
+  int32_t HopLength() const { return vocoder_->HopLength(); }
+
+ private:
+  struct Request {
+    Ort::Value mel{nullptr};
+    int64_t num_frames = 0;
+    std::promise<std::vector<float>> promise;
+  };
+
+  void Loop() {
+    while (true) {
+      std::vector<Request *> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stopped_ || !queue_.empty(); });
+
+        if (stopped_ && queue_.empty()) {
+          return;
+        }
+
+        if (static_cast<int32_t>(queue_.size()) < max_batch_size_ &&
+            max_wait_ms_ > 0) {
+          cv_.wait_for(lock, std::chrono::milliseconds(max_wait_ms_), [this] {
+            return stopped_ ||
+                   static_cast<int32_t>(queue_.size()) >= max_batch_size_;
+          });
+        }
+
+        while (!queue_.empty() &&
+               static_cast<int32_t>(batch.size()) < max_batch_size_) {
+          batch.push_back(queue_.front());
+          queue_.pop_front();
+        }
+      }
+
+      // Sort by length so that mels of similar lengths are put into the
+      // same sub-batch. A mel joins the current sub-batch only if it has at
+      // least half the frames of the longest one, to bound padding.
+      std::sort(batch.begin(), batch.end(),
+                [](const Request *a, const Request *b) {
+                  return a->num_frames > b->num_frames;
+                });
+
+      int32_t start = 0;
+      int32_t n = static_cast<int32_t>(batch.size());
+      while (start < n) {
+        int32_t end = start + 1;
+        while (end < n &&
+               batch[end]->num_frames * 2 >= batch[start]->num_frames) {
+          ++end;
+        }
+
+        Process(batch.data() + start, end - start);
+        start = end;
+      }
+    }
+  }
+
+  void Process(Request **requests, int32_t n) const {
+    std::vector<Ort::Value> mels;
+    mels.reserve(n);
+    for (int32_t i = 0; i != n; ++i) {
+      mels.push_back(std::move(requests[i]->mel));
+    }
+
+    std::vector<std::vector<float>> samples;
+    try {
+      samples = vocoder_->RunBatch(std::move(mels));
+    } catch (...) {
+      for (int32_t i = 0; i != n; ++i) {
+        requests[i]->promise.set_exception(std::current_exception());
+      }
+      return;
+    }
+
+    for (int32_t i = 0; i != n; ++i) {
+      requests[i]->promise.set_value(std::move(samples[i]));
+    }
+  }
+
+ private:
+  std::unique_ptr<Vocoder> vocoder_;
+  int32_t max_batch_size_;
+  int32_t max_wait_ms_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request *> queue_;
+  bool stopped_ = false;
+
+  std::thread worker_;
+};
+
+VocoderBatcher::VocoderBatcher(std::unique_ptr<Vocoder> vocoder,
+                               int32_t max_batch_size, int32_t max_wait_ms)
+    : impl_(std::make_unique<Impl>(std::move(vocoder), max_batch_size,
+                                   max_wait_ms)) {}
+
+VocoderBatcher::~VocoderBatcher() = default;
+
+std::vector<float> VocoderBatcher::Run(Ort::Value mel) const {
+  return impl_->Run(std::move(mel));
+}
+
+int32_t VocoderBatcher::HopLength() const { return impl_->HopLength(); }
+
+}  // namespace sherpa_onnx
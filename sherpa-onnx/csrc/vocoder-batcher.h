@@ -0,0 +1,48 @@
+// sherpa-onnx/csrc/vocoder-batcher.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#ifndef SHERPA_ONNX_CSRC_VOCODER_BATCHER_H_
+#define SHERPA_ONNX_CSRC_VOCODER_BATCHER_H_
+
+#include <memory>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"  // NOLINT
+#include "sherpa-onnx/csrc/vocoder.h"
+
+namespace sherpa_onnx {
+
+// It collects mels passed to Run() from different threads, e.g., from
+// concurrent OfflineTts::Generate() calls, and runs them through the
+// wrapped vocoder in a single batch.
+//
+// Run() blocks until the audio samples of the given mel are available.
+class VocoderBatcher : public Vocoder {
+ public:
+  /**
+   * @param vocoder The vocoder to run. It must accept batch_size > 1.
+   * @param max_batch_size Maximum number of mels in a batch.
+   * @param max_wait_ms  After the first mel of a batch arrives, wait at most
+   *                     this number of milliseconds for more mels.
+   */
+  VocoderBatcher(std::unique_ptr<Vocoder> vocoder, int32_t max_batch_size,
+                 int32_t max_wait_ms);
+
+  ~VocoderBatcher() override;
+
+  /** @param mel A float32 tensor of shape (1, feat_dim, num_frames).
+   *  @return Return a float32 vector containing audio samples.
+   */
+  std::vector<float> Run(Ort::Value mel) const override;
+
+  int32_t HopLength() const override;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace sherpa_onnx
+
+#endif  // SHERPA_ONNX_CSRC_VOCODER_BATCHER_H_
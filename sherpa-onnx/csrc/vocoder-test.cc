@@ -0,0 +1,172 @@
+// sherpa-onnx/csrc/vocoder-test.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/csrc/vocoder.h"
+
+#include <array>
+#include <memory>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sherpa-onnx/csrc/onnx-utils.h"
+#include "sherpa-onnx/csrc/vocoder-batcher.h"
+
+namespace sherpa_onnx {
+
+namespace {
+
+// Each audio sample depends only on the mel frame it belongs to. Like a
+// vocoder using a centered ISTFT, it returns (num_frames - 1) * hop
+// samples if center is true.
+class FakeVocoder : public Vocoder {
+ public:
+  FakeVocoder(int32_t hop, bool center) : hop_(hop), center_(center) {}
+
+  std::vector<float> Run(Ort::Value mel) const override {
+    auto shape = mel.GetTensorTypeAndShapeInfo().GetShape();
+    int64_t batch_size = shape[0];
+    int64_t feat_dim = shape[1];
+    int64_t num_frames = shape[2];
+    int64_t num_samples = (center_ ? num_frames - 1 : num_frames) * hop_;
+
+    const float *p = mel.GetTensorData<float>();
+
+    std::vector<float> ans;
+    for (int64_t b = 0; b != batch_size; ++b) {
+      for (int64_t i = 0; i != num_samples; ++i) {
+        int64_t t = i / hop_;
+        float sum = 0;
+        for (int64_t d = 0; d != feat_dim; ++d) {
+          sum += p[d * num_frames + t] * (d + 1);
+        }
+        ans.push_back(sum + (i % hop_) * 0.01f);
+      }
+      p += feat_dim * num_frames;
+    }
+
+    return ans;
+  }
+
+  int32_t HopLength() const override { return center_ ? hop_ : 0; }
+
+ private:
+  int32_t hop_;
+  bool center_;
+};
+
+Ort::Value MakeMel(int32_t feat_dim, int32_t num_frames, int32_t seed) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::array<int64_t, 3> shape = {1, feat_dim, num_frames};
+  Ort::Value mel =
+      Ort::Value::CreateTensor<float>(allocator, shape.data(), shape.size());
+
+  float *p = mel.GetTensorMutableData<float>();
+  for (int32_t i = 0; i != feat_dim * num_frames; ++i) {
+    p[i] = ((i * 7 + seed * 13) % 17) * 0.5f - 4;
+  }
+
+  return mel;
+}
+
+void TestRunBatch(bool center) {
+  FakeVocoder vocoder(4, center);
+
+  std::vector<int32_t> num_frames = {5, 9, 3, 9};
+  std::vector<Ort::Value> mels;
+  for (int32_t i = 0; i != static_cast<int32_t>(num_frames.size()); ++i) {
+    mels.push_back(MakeMel(3, num_frames[i], i));
+  }
+
+  auto ans = vocoder.RunBatch(std::move(mels));
+  ASSERT_EQ(ans.size(), num_frames.size());
+
+  for (int32_t i = 0; i != static_cast<int32_t>(num_frames.size()); ++i) {
+    auto expected = vocoder.Run(MakeMel(3, num_frames[i], i));
+    EXPECT_EQ(ans[i], expected) << i;
+  }
+}
+
+void TestRunChunked(bool center) {
+  FakeVocoder vocoder(4, center);
+
+  for (int32_t num_frames : {1, 2, 7, 20}) {
+    for (int32_t chunk_size : {1, 3, 8, 30}) {
+      for (int32_t overlap : {0, 1, 4}) {
+        auto expected = vocoder.Run(MakeMel(3, num_frames, 0));
+
+        std::vector<float> samples;
+        float last_progress = 0;
+        bool ok = vocoder.RunChunked(
+            MakeMel(3, num_frames, 0), chunk_size, overlap,
+            [&](const float *p, int32_t n, float progress) -> int32_t {
+              samples.insert(samples.end(), p, p + n);
+              last_progress = progress;
+              return 1;
+            });
+
+        EXPECT_TRUE(ok);
+        EXPECT_EQ(last_progress, 1);
+        ASSERT_EQ(samples.size(), expected.size())
+            << num_frames << " " << chunk_size << " " << overlap;
+
+        for (int32_t i = 0; i != static_cast<int32_t>(samples.size()); ++i) {
+          EXPECT_NEAR(samples[i], expected[i], 1e-5) << i;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Vocoder, RunBatch) { TestRunBatch(/*center*/ false); }
+
+TEST(Vocoder, RunBatchCentered) { TestRunBatch(/*center*/ true); }
+
+TEST(Vocoder, RunChunked) { TestRunChunked(/*center*/ false); }
+
+TEST(Vocoder, RunChunkedCentered) { TestRunChunked(/*center*/ true); }
+
+TEST(Vocoder, RunChunkedStop) {
+  FakeVocoder vocoder(4, /*center*/ true);
+
+  int32_t num_calls = 0;
+  bool ok = vocoder.RunChunked(MakeMel(3, 20, 0), 5, 2,
+                               [&](const float *, int32_t, float) -> int32_t {
+                                 ++num_calls;
+                                 return num_calls < 2;
+                               });
+
+  EXPECT_FALSE(ok);
+  EXPECT_EQ(num_calls, 2);
+}
+
+TEST(VocoderBatcher, SameAsUnbatched) {
+  FakeVocoder vocoder(4, /*center*/ true);
+  VocoderBatcher batcher(std::make_unique<FakeVocoder>(4, /*center*/ true),
+                         /*max_batch_size*/ 4, /*max_wait_ms*/ 20);
+
+  EXPECT_EQ(batcher.HopLength(), 4);
+
+  int32_t num_threads = 8;
+  std::vector<std::vector<float>> results(num_threads);
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i != num_threads; ++i) {
+    threads.emplace_back([&batcher, &results, i]() {
+      results[i] = batcher.Run(MakeMel(3, 3 + i * 2, i));
+    });
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  for (int32_t i = 0; i != num_threads; ++i) {
+    EXPECT_EQ(results[i], vocoder.Run(MakeMel(3, 3 + i * 2, i))) << i;
+  }
+}
+
+}  // namespace sherpa_onnx
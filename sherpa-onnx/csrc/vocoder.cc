@@ -4,7 +4,14 @@
 
 #include "sherpa-onnx/csrc/vocoder.h"
 
+#include <algorithm>
+#include <array>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 #if __ANDROID_API__ >= 9
@@ -22,6 +29,7 @@
 #include "sherpa-onnx/csrc/onnx-utils.h"
 #include "sherpa-onnx/csrc/session.h"
 #include "sherpa-onnx/csrc/text-utils.h"
+#include "sherpa-onnx/csrc/vocoder-batcher.h"
 #include "sherpa-onnx/csrc/vocos-vocoder.h"
 
 namespace sherpa_onnx {
@@ -175,14 +183,210 @@ std::unique_ptr<Vocoder> Vocoder::Create(Manager *mgr,
   }
 }
 
+std::vector<std::vector<float>> Vocoder::RunBatch(
+    std::vector<Ort::Value> mels) const {
+  int32_t batch_size = static_cast<int32_t>(mels.size());
+  if (batch_size == 0) {
+    return {};
+  }
+
+  if (batch_size == 1) {
+    return {Run(std::move(mels[0]))};
+  }
+
+  std::vector<int64_t> num_frames(batch_size);
+  int64_t feat_dim = mels[0].GetTensorTypeAndShapeInfo().GetShape()[1];
+  for (int32_t i = 0; i != batch_size; ++i) {
+    num_frames[i] = mels[i].GetTensorTypeAndShapeInfo().GetShape()[2];
+  }
+  int64_t max_num_frames =
+      *std::max_element(num_frames.begin(), num_frames.end());
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::array<int64_t, 3> shape = {batch_size, feat_dim, max_num_frames};
+  Ort::Value batch =
+      Ort::Value::CreateTensor<float>(allocator, shape.data(), shape.size());
+
+  // Pad with the smallest value of each bin so that the padded frames
+  // are silence and have as little effect as possible on the last real
+  // frames.
+  float *dst = batch.GetTensorMutableData<float>();
+  for (int32_t i = 0; i != batch_size; ++i) {
+    const float *src = mels[i].GetTensorData<float>();
+    int64_t t = num_frames[i];
+    for (int64_t d = 0; d != feat_dim; ++d) {
+      std::copy(src, src + t, dst);
+      std::fill(dst + t, dst + max_num_frames, *std::min_element(src, src + t));
+
+      src += t;
+      dst += max_num_frames;
+    }
+  }
+
+  std::vector<float> samples = Run(std::move(batch));
+
+  int64_t num_samples_per_utt = samples.size() / batch_size;
+
+  int64_t hop = HopLength();
+  if (hop <= 0) {
+    hop = num_samples_per_utt / max_num_frames;
+  }
+
+  // The number of samples is an affine function of the number of frames,
+  // e.g., (num_frames - 1) * hop for vocoders using a centered ISTFT, so
+  // each padded frame accounts for exactly hop samples.
+  std::vector<std::vector<float>> ans(batch_size);
+  for (int32_t i = 0; i != batch_size; ++i) {
+    int64_t n = std::max<int64_t>(
+        num_samples_per_utt - (max_num_frames - num_frames[i]) * hop, 0);
+    auto start = samples.begin() + i * num_samples_per_utt;
+    ans[i] = std::vector<float>(start, start + n);
+  }
+
+  return ans;
+}
+
+bool Vocoder::RunChunked(Ort::Value mel, int32_t chunk_size, int32_t overlap,
+                         const VocoderChunkCallback &callback) const {
+  std::vector<int64_t> shape = mel.GetTensorTypeAndShapeInfo().GetShape();
+  int64_t feat_dim = shape[1];
+  int64_t num_frames = shape[2];
+
+  const float *p = mel.GetTensorData<float>();
+
+  chunk_size = std::max(chunk_size, 1);
+  overlap = std::max(overlap, 0);
+
+  Ort::AllocatorWithDefaultOptions allocator;
+
+  int64_t hop = HopLength();
+
+  // Audio samples of the right context of the previous chunk
+  std::vector<float> tail;
+
+  for (int64_t start = 0; start < num_frames; start += chunk_size) {
+    int64_t end = std::min<int64_t>(start + chunk_size, num_frames);
+
+    // frames [left, right) are sent to the vocoder.
+    //
+    // At least one frame of right context is used since a vocoder using a
+    // centered ISTFT needs the next frame for the last hop samples of a
+    // frame.
+    int64_t left = std::max<int64_t>(start - overlap, 0);
+    int64_t right = std::min<int64_t>(end + std::max(overlap, 1), num_frames);
+
+    std::array<int64_t, 3> chunk_shape = {1, feat_dim, right - left};
+    Ort::Value chunk = Ort::Value::CreateTensor<float>(
+        allocator, chunk_shape.data(), chunk_shape.size());
+
+    float *dst = chunk.GetTensorMutableData<float>();
+    for (int64_t d = 0; d != feat_dim; ++d) {
+      const float *src = p + d * num_frames;
+      std::copy(src + left, src + right, dst);
+      dst += right - left;
+    }
+
+    std::vector<float> audio = Run(std::move(chunk));
+
+    if (hop <= 0) {
+      hop = audio.size() / (right - left);
+    }
+
+    // samples for frames [start, right)
+    int64_t offset = std::min<int64_t>((start - left) * hop, audio.size());
+    std::vector<float> cur(audio.begin() + offset, audio.end());
+
+    // The last chunk may have fewer samples than frames * hop, e.g.,
+    // a centered ISTFT returns (num_frames - 1) * hop samples.
+    int64_t num_own_samples =
+        std::min<int64_t>((end - start) * hop, cur.size());
+
+    int64_t n = std::min<int64_t>(tail.size(), num_own_samples);
+    for (int64_t i = 0; i != n; ++i) {
+      float w = (i + 0.5f) / n;
+      cur[i] = tail[i] * (1 - w) + cur[i] * w;
+    }
+
+    tail.assign(cur.begin() + num_own_samples, cur.end());
+
+    if (!callback(cur.data(), static_cast<int32_t>(num_own_samples),
+                  end * 1.0f / num_frames)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Vocoders shared via CreateShared(), keyed by the model filename and
+// the options that affect how it is run.
+static std::mutex shared_vocoders_mutex;
+static std::map<std::string, std::weak_ptr<Vocoder>> shared_vocoders;
+
+static std::string SharedVocoderKey(const OfflineTtsModelConfig &config) {
+  std::ostringstream os;
+  os << (config.matcha.vocoder.empty() ? config.zipvoice.vocoder
+                                       : config.matcha.vocoder)
+     << "|" << config.num_threads << "|" << config.provider << "|"
+     << config.vocoder_batch_size << "|" << config.vocoder_batch_wait_ms;
+  return os.str();
+}
+
+template <typename F>
+static std::shared_ptr<Vocoder> GetOrCreateSharedVocoder(
+    const OfflineTtsModelConfig &config, F create) {
+  if (config.vocoder_batch_size <= 1) {
+    return create();
+  }
+
+  auto key = SharedVocoderKey(config);
+
+  std::lock_guard<std::mutex> lock(shared_vocoders_mutex);
+  auto ans = shared_vocoders[key].lock();
+  if (ans) {
+    return ans;
+  }
+
+  auto vocoder = create();
+  if (!vocoder) {
+    return nullptr;
+  }
+
+  ans = std::make_shared<VocoderBatcher>(std::move(vocoder),
+                                         config.vocoder_batch_size,
+                                         config.vocoder_batch_wait_ms);
+  shared_vocoders[key] = ans;
+
+  return ans;
+}
+
+std::shared_ptr<Vocoder> Vocoder::CreateShared(
+    const OfflineTtsModelConfig &config) {
+  return GetOrCreateSharedVocoder(config,
+                                  [&config]() { return Create(config); });
+}
+
+template <typename Manager>
+std::shared_ptr<Vocoder> Vocoder::CreateShared(
+    Manager *mgr, const OfflineTtsModelConfig &config) {
+  return GetOrCreateSharedVocoder(
+      config, [mgr, &config]() { return Create(mgr, config); });
+}
+
 #if __ANDROID_API__ >= 9
 template std::unique_ptr<Vocoder> Vocoder::Create(
     AAssetManager *mgr, const OfflineTtsModelConfig &config);
+
+template std::shared_ptr<Vocoder> Vocoder::CreateShared(
+    AAssetManager *mgr, const OfflineTtsModelConfig &config);
 #endif
 
 #if __OHOS__
 template std::unique_ptr<Vocoder> Vocoder::Create(
     NativeResourceManager *mgr, const OfflineTtsModelConfig &config);
+
+template std::shared_ptr<Vocoder> Vocoder::CreateShared(
+    NativeResourceManager *mgr, const OfflineTtsModelConfig &config);
 #endif
 
 }  // namespace sherpa_onnx
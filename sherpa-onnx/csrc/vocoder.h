@@ -5,6 +5,7 @@
 #ifndef SHERPA_ONNX_CSRC_VOCODER_H_
 #define SHERPA_ONNX_CSRC_VOCODER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -14,6 +15,11 @@
 
 namespace sherpa_onnx {
 
+// It is called with the audio samples of a chunk and the fraction of mel
+// frames vocoded so far. If it returns 0, vocoding stops.
+using VocoderChunkCallback = std::function<int32_t(
+    const float * /*samples*/, int32_t /*n*/, float /*progress*/)>;
+
 class Vocoder {
  public:
   virtual ~Vocoder() = default;
@@ -24,10 +30,60 @@ class Vocoder {
   static std::unique_ptr<Vocoder> Create(Manager *mgr,
                                          const OfflineTtsModelConfig &config);
 
+  /** Like Create(), but if config.vocoder_batch_size > 1, the returned
+   *  vocoder is shared by all callers in the process that use the same
+   *  vocoder model, and concurrent Run() calls from them are batched.
+   *  See ./vocoder-batcher.h
+   */
+  static std::shared_ptr<Vocoder> CreateShared(
+      const OfflineTtsModelConfig &config);
+
+  template <typename Manager>
+  static std::shared_ptr<Vocoder> CreateShared(
+      Manager *mgr, const OfflineTtsModelConfig &config);
+
   /** @param mel A float32 tensor of shape (batch_size, feat_dim, num_frames).
-   *  @return Return a float32 vector containing audio samples..
+   *  @return Return a float32 vector containing audio samples. If
+   *          batch_size > 1, samples of different utterances are
+   *          concatenated and each utterance has the same number of samples.
    */
   virtual std::vector<float> Run(Ort::Value mel) const = 0;
+
+  /** Return the number of audio samples per mel frame. Return 0 if it is
+   *  not known, in which case it is assumed that Run() returns exactly
+   *  hop_length samples for each frame.
+   */
+  virtual int32_t HopLength() const { return 0; }
+
+  /** Run the vocoder on mels of different lengths with a single call of
+   *  Run().
+   *
+   *  Shorter mels are padded with silence, i.e., with the smallest value
+   *  of each mel bin, and the audio samples for the padded frames are
+   *  discarded, so ans[i] has as many samples as Run(mels[i]) would return.
+   *
+   *  @param mels mels[i] is a float32 tensor of shape (1, feat_dim, T_i).
+   *  @return Return ans[i] containing audio samples for mels[i].
+   */
+  std::vector<std::vector<float>> RunBatch(std::vector<Ort::Value> mels) const;
+
+  /** Run the vocoder over chunk_size mel frames at a time and pass the
+   *  audio samples of each chunk to the callback as soon as they are ready.
+   *
+   *  Each chunk sees `overlap` extra frames of context on both sides, and
+   *  at least one frame on the right. The audio of the right context of a
+   *  chunk is cross-faded with the start of the next chunk to avoid clicks
+   *  at chunk boundaries. The number of samples passed to the callback in
+   *  total equals the number of samples returned by Run(mel).
+   *
+   *  @param mel A float32 tensor of shape (1, feat_dim, num_frames).
+   *  @param chunk_size Number of mel frames per chunk. Must be > 0.
+   *  @param overlap Number of context frames on each side of a chunk.
+   *  @param callback It is called once per chunk.
+   *  @return Return false if the callback asked to stop; true otherwise.
+   */
+  bool RunChunked(Ort::Value mel, int32_t chunk_size, int32_t overlap,
+                  const VocoderChunkCallback &callback) const;
 };
 
 }  // namespace sherpa_onnx
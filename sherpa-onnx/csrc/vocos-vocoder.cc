@@ -81,35 +81,9 @@ class VocosVocoder::Impl {
 
     std::vector<int64_t> shape = out[0].GetTensorTypeAndShapeInfo().GetShape();
 
-    if (shape[0] != 1) {
-      SHERPA_ONNX_LOGE("Support only batch size 1, given: %d",
-                       static_cast<int32_t>(shape[0]));
-      SHERPA_ONNX_EXIT(-1);
-    }
-
-    knf::StftResult stft_result;
-    stft_result.num_frames = shape[2];
-    stft_result.real.resize(shape[1] * shape[2]);
-    stft_result.imag.resize(shape[1] * shape[2]);
-
-    // stft_result.real: (num_frames, n_fft/2+1), flattened in row major
-
-    // mag.shape: (batch_size, n_fft/2+1, num_frames)
-    const float *p_mag = out[0].GetTensorData<float>();
-    const float *p_x = out[1].GetTensorData<float>();
-    const float *p_y = out[2].GetTensorData<float>();
-
-    for (int32_t frame_index = 0; frame_index < static_cast<int32_t>(shape[2]);
-         ++frame_index) {
-      for (int32_t bin = 0; bin < static_cast<int32_t>(shape[1]); ++bin) {
-        stft_result.real[frame_index * shape[1] + bin] =
-            p_mag[bin * shape[2] + frame_index] *
-            p_x[bin * shape[2] + frame_index];
-        stft_result.imag[frame_index * shape[1] + bin] =
-            p_mag[bin * shape[2] + frame_index] *
-            p_y[bin * shape[2] + frame_index];
-      }
-    }
+    int64_t batch_size = shape[0];
+    int64_t num_bins = shape[1];
+    int64_t num_frames = shape[2];
 
     knf::StftConfig stft_config;
     stft_config.n_fft = meta_.n_fft;
@@ -121,9 +95,52 @@ class VocosVocoder::Impl {
     stft_config.pad_mode = meta_.pad_mode;
 
     knf::IStft istft(stft_config);
-    return istft.Compute(stft_result);
+
+    // mag.shape: (batch_size, n_fft/2+1, num_frames)
+    const float *p_mag = out[0].GetTensorData<float>();
+    const float *p_x = out[1].GetTensorData<float>();
+    const float *p_y = out[2].GetTensorData<float>();
+
+    std::vector<float> ans;
+
+    // Utterances in a batch are padded to the same number of frames, so
+    // each of them produces the same number of samples.
+    for (int64_t b = 0; b != batch_size; ++b) {
+      knf::StftResult stft_result;
+      stft_result.num_frames = num_frames;
+      stft_result.real.resize(num_bins * num_frames);
+      stft_result.imag.resize(num_bins * num_frames);
+
+      // stft_result.real: (num_frames, n_fft/2+1), flattened in row major
+      for (int32_t frame_index = 0;
+           frame_index < static_cast<int32_t>(num_frames); ++frame_index) {
+        for (int32_t bin = 0; bin < static_cast<int32_t>(num_bins); ++bin) {
+          stft_result.real[frame_index * num_bins + bin] =
+              p_mag[bin * num_frames + frame_index] *
+              p_x[bin * num_frames + frame_index];
+          stft_result.imag[frame_index * num_bins + bin] =
+              p_mag[bin * num_frames + frame_index] *
+              p_y[bin * num_frames + frame_index];
+        }
+      }
+
+      auto samples = istft.Compute(stft_result);
+      if (batch_size == 1) {
+        return samples;
+      }
+
+      ans.insert(ans.end(), samples.begin(), samples.end());
+
+      p_mag += num_bins * num_frames;
+      p_x += num_bins * num_frames;
+      p_y += num_bins * num_frames;
+    }
+
+    return ans;
   }
 
+  int32_t HopLength() const { return meta_.hop_length; }
+
  private:
   void Init(void *model_data, size_t model_data_length) {
     if (model_data) {
@@ -211,6 +228,8 @@ std::vector<float> VocosVocoder::Run(Ort::Value mel) const {
   return impl_->Run(std::move(mel));
 }
 
+int32_t VocosVocoder::HopLength() const { return impl_->HopLength(); }
+
 #if __ANDROID_API__ >= 9
 template VocosVocoder::VocosVocoder(AAssetManager *mgr,
                                     const OfflineTtsModelConfig &config);
@@ -21,6 +21,7 @@
 
 #include "sherpa-onnx/csrc/circular-buffer.h"
 #include "sherpa-onnx/csrc/macros.h"
+#include "sherpa-onnx/csrc/speech-segment-ring.h"
 #include "sherpa-onnx/csrc/vad-model.h"
 
 namespace sherpa_onnx {
@@ -97,27 +98,15 @@ class VoiceActivityDetector::Impl {
         start_ = std::max(buffer_.Tail() - 2 * model_->WindowSize() -
                               model_->MinSpeechDurationSamples(),
                           buffer_.Head());
-        cur_segment_.start = start_;
       }
-      int32_t num_samples = buffer_.Tail() - start_ - 1;
-      cur_segment_.samples = buffer_.Get(start_, num_samples);
     } else {
       // non-speech
 
-      cur_segment_.start = -1;
-      cur_segment_.samples.clear();
-
       if (start_ != -1 && buffer_.Size()) {
         // end of speech, save the speech segment
         int32_t end = buffer_.Tail() - model_->MinSilenceDurationSamples();
 
-        std::vector<float> s = buffer_.Get(start_, end - start_);
-        SpeechSegment segment;
-
-        segment.start = start_;
-        segment.samples = std::move(s);
-
-        segments_.push(std::move(segment));
+        SaveSegment(start_, end - start_);
 
         buffer_.Pop(end - buffer_.Head());
       }
@@ -135,15 +124,36 @@ class VoiceActivityDetector::Impl {
     }
   }
 
-  bool Empty() const { return segments_.empty(); }
+  bool Empty() const { return ring_ ? ring_->Empty() : segments_.empty(); }
+
+  void Pop() {
+    if (ring_) {
+      SHERPA_ONNX_LOGE("Please use ReleaseFrontView() with the segment ring");
+      return;
+    }
+
+    segments_.pop();
+  }
 
-  void Pop() { segments_.pop(); }
+  void Clear() {
+    if (ring_) {
+      while (!ring_->Empty()) {
+        ring_->Release();
+      }
+      return;
+    }
 
-  void Clear() { std::queue<SpeechSegment>().swap(segments_); }
+    std::queue<SpeechSegment>().swap(segments_);
+  }
 
   const SpeechSegment &Front() const {
     static SpeechSegment tmp;
 
+    if (ring_) {
+      SHERPA_ONNX_LOGE("Please use FrontView() with the segment ring");
+      return tmp;
+    }
+
     if (Empty()) {
       SHERPA_ONNX_LOGE(
           "Make sure you call this method only when Empty() returns false; "
@@ -154,17 +164,41 @@ class VoiceActivityDetector::Impl {
     return segments_.front();
   }
 
+  void EnableSegmentRing(float ring_size_in_seconds,
+                         int32_t max_num_segments) {
+    ring_ = std::make_unique<SpeechSegmentRing>(
+        ring_size_in_seconds * config_.sample_rate, max_num_segments);
+  }
+
+  SpeechSegmentView FrontView() const {
+    if (!ring_) {
+      SHERPA_ONNX_LOGE("Please call EnableSegmentRing() first");
+      return {};
+    }
+
+    return ring_->Front();
+  }
+
+  void ReleaseFrontView() {
+    if (!ring_) {
+      SHERPA_ONNX_LOGE("Please call EnableSegmentRing() first");
+      return;
+    }
+
+    ring_->Release();
+  }
+
   void Reset() {
     std::queue<SpeechSegment>().swap(segments_);
+    if (ring_) {
+      ring_->Reset();
+    }
 
     model_->Reset();
     buffer_.Reset();
     last_.clear();
 
     start_ = -1;
-
-    cur_segment_.start = -1;
-    cur_segment_.samples.clear();
   }
 
   void Flush() {
@@ -177,29 +211,54 @@ class VoiceActivityDetector::Impl {
       return;
     }
 
-    std::vector<float> s = buffer_.Get(start_, end - start_);
-
-    SpeechSegment segment;
-
-    segment.start = start_;
-    segment.samples = std::move(s);
-
-    segments_.push(std::move(segment));
+    SaveSegment(start_, end - start_);
 
     buffer_.Pop(end - buffer_.Head());
     start_ = -1;
-
-    cur_segment_.start = -1;
-    cur_segment_.samples.clear();
   }
 
   bool IsSpeechDetected() const { return start_ != -1; }
 
-  SpeechSegment CurrentSpeechSegment() const { return cur_segment_; }
+  SpeechSegment CurrentSpeechSegment() const {
+    SpeechSegment ans;
+    ans.start = start_;
+
+    // Computed on demand so that we don't copy the ongoing segment
+    // for every window
+    if (start_ != -1) {
+      ans.samples = buffer_.Get(start_, buffer_.Tail() - start_ - 1);
+    }
+
+    return ans;
+  }
 
   const VadModelConfig &GetConfig() const { return config_; }
 
  private:
+  void SaveSegment(int32_t start, int32_t n) {
+    if (!ring_) {
+      SpeechSegment segment;
+
+      segment.start = start;
+      segment.samples = buffer_.Get(start, n);
+
+      segments_.push(std::move(segment));
+      return;
+    }
+
+    float *dst = ring_->Reserve(n);
+    if (!dst) {
+      SHERPA_ONNX_LOGE(
+          "The segment ring is full. Drop a segment of %d samples starting at "
+          "%d. Please release segments faster or use a larger ring",
+          n, start);
+      return;
+    }
+
+    buffer_.Get(start, n, dst);
+    ring_->Commit(start, n);
+  }
+
   void Init() {
     if (!config_.silero_vad.model.empty()) {
       max_utterance_length_ =
@@ -216,8 +275,8 @@ class VoiceActivityDetector::Impl {
  private:
   std::queue<SpeechSegment> segments_;
 
-  // it is empty if no speech is detected
-  SpeechSegment cur_segment_;
+  // If not null, segments are saved here instead of in segments_
+  std::unique_ptr<SpeechSegmentRing> ring_;
 
   std::unique_ptr<VadModel> model_;
   VadModelConfig config_;
@@ -257,6 +316,17 @@ const SpeechSegment &VoiceActivityDetector::Front() const {
   return impl_->Front();
 }
 
+void VoiceActivityDetector::EnableSegmentRing(float ring_size_in_seconds,
+                                              int32_t max_num_segments) {
+  impl_->EnableSegmentRing(ring_size_in_seconds, max_num_segments);
+}
+
+SpeechSegmentView VoiceActivityDetector::FrontView() const {
+  return impl_->FrontView();
+}
+
+void VoiceActivityDetector::ReleaseFrontView() { impl_->ReleaseFrontView(); }
+
 void VoiceActivityDetector::Reset() const { impl_->Reset(); }
 
 void VoiceActivityDetector::Flush() const { impl_->Flush(); }
@@ -7,6 +7,7 @@
 #include <memory>
 #include <vector>
 
+#include "sherpa-onnx/csrc/speech-segment-ring.h"
 #include "sherpa-onnx/csrc/vad-model-config.h"
 
 namespace sherpa_onnx {
@@ -40,6 +41,25 @@ class VoiceActivityDetector {
   // methods of VoiceActivityDetector.
   const SpeechSegment &Front() const;
 
+  // Save detected segments in a fixed-capacity ring instead of a queue.
+  // Segments are then accessed with FrontView() and ReleaseFrontView(),
+  // which avoids a copy and a memory allocation per segment.
+  //
+  // AcceptWaveform() and Flush() may run in one thread while Empty(),
+  // FrontView() and ReleaseFrontView() run in another thread.
+  //
+  // It must be called before the first call to AcceptWaveform().
+  // If the ring is full, new segments are dropped.
+  void EnableSegmentRing(float ring_size_in_seconds,
+                         int32_t max_num_segments = 128);
+
+  // It is an error to call FrontView() if Empty() returns true.
+  //
+  // The returned view is valid until ReleaseFrontView() is called.
+  SpeechSegmentView FrontView() const;
+
+  void ReleaseFrontView();
+
   bool IsSpeechDetected() const;
 
   // It is empty if IsSpeechDetected() returns false
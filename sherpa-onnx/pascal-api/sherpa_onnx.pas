@@ -141,6 +141,7 @@ type
     VocabJson: AnsiString;
     TokenScoresJson: AnsiString;
     VoiceEmbeddingCacheCapacity: Integer;
+    VoiceEmbeddingCacheDir: AnsiString;
 
     function ToString: AnsiString;
     class operator Initialize({$IFDEF FPC}var{$ELSE}out{$ENDIF} Dest: TSherpaOnnxOfflineTtsPocketModelConfig);
@@ -1210,6 +1211,7 @@ type
     VocabJson: PAnsiChar;
     TokenScoresJson: PAnsiChar;
     VoiceEmbeddingCacheCapacity: cint32;
+    VoiceEmbeddingCacheDir: PAnsiChar;
   end;
 
   SherpaOnnxOfflineTtsSupertonicModelConfig = record
@@ -2905,10 +2907,12 @@ begin
     'TextConditioner := %s, ' +
     'VocabJson := %s, ' +
     'TokenScoresJson := %s, ' +
-    'VoiceEmbeddingCacheCapacity := %d' +
+    'VoiceEmbeddingCacheCapacity := %d, ' +
+    'VoiceEmbeddingCacheDir := %s' +
     ')',
     [Self.LmFlow, Self.LmMain, Self.Encoder, Self.Decoder, Self.TextConditioner,
-     Self.VocabJson, Self.TokenScoresJson, Self.VoiceEmbeddingCacheCapacity]);
+     Self.VocabJson, Self.TokenScoresJson, Self.VoiceEmbeddingCacheCapacity,
+     Self.VoiceEmbeddingCacheDir]);
 end;
 
 function TSherpaOnnxOfflineTtsSupertonicModelConfig.ToString: AnsiString;
@@ -3028,6 +3032,7 @@ begin
   C.Model.Pocket.VocabJson := PAnsiChar(Config.Model.Pocket.VocabJson);
   C.Model.Pocket.TokenScoresJson := PAnsiChar(Config.Model.Pocket.TokenScoresJson);
   C.Model.Pocket.VoiceEmbeddingCacheCapacity := Config.Model.Pocket.VoiceEmbeddingCacheCapacity;
+  C.Model.Pocket.VoiceEmbeddingCacheDir := PAnsiChar(Config.Model.Pocket.VoiceEmbeddingCacheDir);
 
   C.Model.Supertonic.DurationPredictor := PAnsiChar(Config.Model.Supertonic.DurationPredictor);
   C.Model.Supertonic.TextEncoder := PAnsiChar(Config.Model.Supertonic.TextEncoder);
@@ -5,6 +5,7 @@
 #include "sherpa-onnx/python/csrc/audio-tagging.h"
 
 #include <string>
+#include <vector>
 
 #include "sherpa-onnx/csrc/audio-tagging.h"
 
@@ -62,6 +63,20 @@ Returns:
   A list of AudioEvent objects.
 )doc";
 
+static constexpr const char *kAudioTaggingComputeBatchDoc = R"doc(
+Compute audio tagging results for a list of streams. Streams of similar
+lengths are processed together.
+
+Args:
+  ss:
+    A list of streams containing audio data.
+  top_k:
+    Number of top results to return. -1 means use the config value.
+
+Returns:
+  A list. The i-th entry is a list of AudioEvent objects for ss[i].
+)doc";
+
 static void PybindOfflineZipformerAudioTaggingModelConfig(py::module *m) {
   using PyClass = OfflineZipformerAudioTaggingModelConfig;
   py::class_<PyClass>(*m, "OfflineZipformerAudioTaggingModelConfig")
@@ -134,8 +149,22 @@ void PybindAudioTagging(py::module *m) {
       .def("create_stream", &PyClass::CreateStream,
            py::call_guard<py::gil_scoped_release>(),
            kAudioTaggingCreateStreamDoc)
-      .def("compute", &PyClass::Compute, py::arg("s"), py::arg("top_k") = -1,
-           py::call_guard<py::gil_scoped_release>(), kAudioTaggingComputeDoc);
+      .def(
+          "compute",
+          [](const PyClass &self, OfflineStream *s, int32_t top_k) {
+            return self.Compute(s, top_k);
+          },
+          py::arg("s"), py::arg("top_k") = -1,
+          py::call_guard<py::gil_scoped_release>(), kAudioTaggingComputeDoc)
+      .def(
+          "compute_batch",
+          [](const PyClass &self, std::vector<OfflineStream *> ss,
+             int32_t top_k) {
+            return self.Compute(ss.data(), ss.size(), top_k);
+          },
+          py::arg("ss"), py::arg("top_k") = -1,
+          py::call_guard<py::gil_scoped_release>(),
+          kAudioTaggingComputeBatchDoc);
 }
 
 }  // namespace sherpa_onnx
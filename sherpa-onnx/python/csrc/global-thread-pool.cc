@@ -0,0 +1,60 @@
+// sherpa-onnx/python/csrc/global-thread-pool.cc
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#include "sherpa-onnx/python/csrc/global-thread-pool.h"
+
+#include "sherpa-onnx/csrc/global-thread-pool.h"
+
+namespace sherpa_onnx {
+
+static constexpr const char *kGlobalThreadPoolConfigInitDoc = R"doc(
+Configuration for the onnxruntime thread pools shared by all models
+that opt in.
+
+Args:
+  intra_op_num_threads:
+    Number of threads of the shared intra-op pool. 0 means one thread
+    per physical core.
+  inter_op_num_threads:
+    Number of threads of the shared inter-op pool.
+  allow_spinning:
+    If False, idle threads block instead of spinning.
+)doc";
+
+static constexpr const char *kInitGlobalThreadPoolsDoc = R"doc(
+Create onnxruntime thread pools shared by all models that opt in.
+
+It must be called before any model is created. A model opts in with
+``UseGlobalThreadPools=1`` in its provider config file, e.g.,
+``provider="cpu:/path/to/config.txt"``. Its ``num_threads`` is then
+ignored.
+
+Args:
+  config:
+    An instance of GlobalThreadPoolConfig.
+
+Return:
+  False if the config is invalid, the pools have already been created,
+  or a model has already been created.
+)doc";
+
+void PybindGlobalThreadPool(py::module *m) {
+  using PyClass = GlobalThreadPoolConfig;
+  py::class_<PyClass>(*m, "GlobalThreadPoolConfig")
+      .def(py::init<int32_t, int32_t, bool>(),
+           py::arg("intra_op_num_threads") = 0,
+           py::arg("inter_op_num_threads") = 1,
+           py::arg("allow_spinning") = true, kGlobalThreadPoolConfigInitDoc)
+      .def_readwrite("intra_op_num_threads", &PyClass::intra_op_num_threads)
+      .def_readwrite("inter_op_num_threads", &PyClass::inter_op_num_threads)
+      .def_readwrite("allow_spinning", &PyClass::allow_spinning)
+      .def("validate", &PyClass::Validate)
+      .def("__str__", &PyClass::ToString);
+
+  m->def("init_global_thread_pools", &InitGlobalThreadPools,
+         py::arg("config"), kInitGlobalThreadPoolsDoc);
+  m->def("has_global_thread_pools", &HasGlobalThreadPools);
+}
+
+}  // namespace sherpa_onnx
@@ -0,0 +1,16 @@
+// sherpa-onnx/python/csrc/global-thread-pool.h
+//
+// Copyright (c)  2026  Xiaomi Corporation
+
+#ifndef SHERPA_ONNX_PYTHON_CSRC_GLOBAL_THREAD_POOL_H_
+#define SHERPA_ONNX_PYTHON_CSRC_GLOBAL_THREAD_POOL_H_
+
+#include "sherpa-onnx/python/csrc/sherpa-onnx.h"
+
+namespace sherpa_onnx {
+
+void PybindGlobalThreadPool(py::module *m);
+
+}
+
+#endif  // SHERPA_ONNX_PYTHON_CSRC_GLOBAL_THREAD_POOL_H_
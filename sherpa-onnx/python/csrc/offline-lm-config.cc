@@ -23,6 +23,7 @@ void PybindOfflineLMConfig(py::module *m) {
       .def_readwrite("scale", &PyClass::scale)
       .def_readwrite("lm_provider", &PyClass::lm_provider)
       .def_readwrite("lm_num_threads", &PyClass::lm_num_threads)
+      .def_readwrite("lm_lazy_init", &PyClass::lm_lazy_init)
       .def_readwrite("lodr_fst", &PyClass::lodr_fst)
       .def_readwrite("lodr_scale", &PyClass::lodr_scale)
       .def_readwrite("lodr_backoff_id", &PyClass::lodr_backoff_id)
@@ -29,6 +29,18 @@ Returns:
   The text with punctuation added.
 )doc";
 
+static constexpr const char *kOfflinePunctuationAddPunctuationBatchDoc = R"doc(
+Add punctuation to a list of texts. Texts are processed by the model
+together, which is faster than calling add_punctuation() for each of them.
+
+Args:
+  texts:
+    A list of input texts without punctuation.
+
+Returns:
+  A list containing the texts with punctuation added.
+)doc";
+
 static void PybindOfflinePunctuationModelConfig(py::module *m) {
   using PyClass = OfflinePunctuationModelConfig;
   py::class_<PyClass>(*m, "OfflinePunctuationModelConfig")
@@ -52,6 +64,7 @@ static void PybindOfflinePunctuationConfig(py::module *m) {
       .def(py::init<>())
       .def(py::init<const OfflinePunctuationModelConfig &>(), py::arg("model"))
       .def_readwrite("model", &PyClass::model)
+      .def_readwrite("lazy_init", &PyClass::lazy_init)
       .def("validate", &PyClass::Validate)
       .def("__str__", &PyClass::ToString);
 }
@@ -66,7 +79,10 @@ void PybindOfflinePunctuation(py::module *m) {
            kOfflinePunctuationInitDoc)
       .def("add_punctuation", &PyClass::AddPunctuation, py::arg("text"),
            py::call_guard<py::gil_scoped_release>(),
-           kOfflinePunctuationAddPunctuationDoc);
+           kOfflinePunctuationAddPunctuationDoc)
+      .def("add_punctuation_batch", &PyClass::AddPunctuationBatch,
+           py::arg("texts"), py::call_guard<py::gil_scoped_release>(),
+           kOfflinePunctuationAddPunctuationBatchDoc);
 }
 
 }  // namespace sherpa_onnx
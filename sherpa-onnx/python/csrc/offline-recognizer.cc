@@ -97,6 +97,27 @@ Args:
     A list of OfflineStream instances to decode.
 )doc";
 
+static constexpr const char *kDecodeWaveformsDoc = R"doc(
+Feed one waveform into each stream and decode all of the streams.
+
+The GIL is released for both feature extraction and decoding.
+float32 C-contiguous arrays are read without copying.
+
+Args:
+  ss:
+    A list of OfflineStream instances. They should not have accepted
+    any audio yet.
+  sample_rate:
+    Sample rate of all of the waveforms.
+  waveforms:
+    A list of 1-D float32 arrays normalized to the range [-1, 1].
+    ``waveforms[i]`` is fed into ``ss[i]``.
+
+Return:
+  A list of OfflineRecognitionResult. The i-th entry is the result
+  of ``ss[i]``.
+)doc";
+
 static constexpr const char *kSetConfigDoc = R"doc(
 Update the recognizer configuration at runtime.
 
@@ -167,7 +188,51 @@ void PybindOfflineRecognizer(py::module *m) {
             self.DecodeStreams(ss.data(), ss.size());
           },
           py::arg("ss"), kDecodeStreamsDoc,
-          py::call_guard<py::gil_scoped_release>());
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "decode_waveforms",
+          [](const PyClass &self, std::vector<OfflineStream *> ss,
+             int32_t sample_rate,
+             const std::vector<py::array_t<float, py::array::c_style |
+                                                      py::array::forcecast>>
+                 &waveforms) {
+            if (ss.size() != waveforms.size()) {
+              throw py::value_error(
+                  "The number of streams and waveforms should be equal. "
+                  "Given " +
+                  std::to_string(ss.size()) + " vs " +
+                  std::to_string(waveforms.size()));
+            }
+
+            for (const auto &w : waveforms) {
+              if (w.ndim() != 1) {
+                throw py::value_error(
+                    "Expect 1-D waveforms. Given dim: " +
+                    std::to_string(w.ndim()));
+              }
+            }
+
+            std::vector<OfflineRecognitionResult> ans(ss.size());
+
+            // waveforms keeps the arrays alive, so their buffers can
+            // be used without the GIL
+            py::gil_scoped_release release;
+
+            for (size_t i = 0; i != ss.size(); ++i) {
+              ss[i]->AcceptWaveform(sample_rate, waveforms[i].data(),
+                                    waveforms[i].size());
+            }
+
+            self.DecodeStreams(ss.data(), ss.size());
+
+            for (size_t i = 0; i != ss.size(); ++i) {
+              ans[i] = ss[i]->GetResult();
+            }
+
+            return ans;
+          },
+          py::arg("ss"), py::arg("sample_rate"), py::arg("waveforms"),
+          kDecodeWaveformsDoc);
 }
 
 }  // namespace sherpa_onnx
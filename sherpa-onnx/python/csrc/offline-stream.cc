@@ -111,7 +111,9 @@ void PybindOfflineStream(py::module *m) {
       .def(
           "accept_waveform",
           [](PyClass &self, float sample_rate,
-             const std::vector<float> &waveform) {
+             const py::array_t<float, py::array::c_style |
+                                          py::array::forcecast> &waveform) {
+            // float32 contiguous arrays are passed without a copy
             self.AcceptWaveform(sample_rate, waveform.data(), waveform.size());
           },
           py::arg("sample_rate"), py::arg("waveform"), kAcceptWaveformUsage,
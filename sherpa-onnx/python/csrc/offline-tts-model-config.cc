@@ -57,6 +57,8 @@ void PybindOfflineTtsModelConfig(py::module *m) {
       .def_readwrite("num_threads", &PyClass::num_threads)
       .def_readwrite("debug", &PyClass::debug)
       .def_readwrite("provider", &PyClass::provider)
+      .def_readwrite("vocoder_batch_size", &PyClass::vocoder_batch_size)
+      .def_readwrite("vocoder_batch_wait_ms", &PyClass::vocoder_batch_wait_ms)
       .def("__str__", &PyClass::ToString);
 }
 
@@ -58,6 +58,7 @@ static void PybindOfflineTtsConfig(py::module *m) {
       .def_readwrite("rule_fars", &PyClass::rule_fars)
       .def_readwrite("max_num_sentences", &PyClass::max_num_sentences)
       .def_readwrite("silence_scale", &PyClass::silence_scale)
+      .def_readwrite("max_concurrency", &PyClass::max_concurrency)
       .def("validate", &PyClass::Validate)
       .def("__str__", &PyClass::ToString);
 }
@@ -24,6 +24,7 @@ void PybindOnlineLMConfig(py::module *m) {
       .def_readwrite("scale", &PyClass::scale)
       .def_readwrite("lm_provider", &PyClass::lm_provider)
       .def_readwrite("lm_num_threads", &PyClass::lm_num_threads)
+      .def_readwrite("lm_lazy_init", &PyClass::lm_lazy_init)
       .def_readwrite("shallow_fusion", &PyClass::shallow_fusion)
       .def_readwrite("lodr_fst", &PyClass::lodr_fst)
       .def_readwrite("lodr_scale", &PyClass::lodr_scale)
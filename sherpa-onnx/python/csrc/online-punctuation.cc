@@ -29,6 +29,19 @@ Returns:
   The text with punctuation and proper casing.
 )doc";
 
+static constexpr const char
+    *kOnlinePunctuationAddPunctuationWithCaseBatchDoc = R"doc(
+Add punctuation and restore casing for a list of texts. Texts are processed
+by the model together.
+
+Args:
+  texts:
+    A list of input texts without punctuation.
+
+Returns:
+  A list containing the texts with punctuation and proper casing.
+)doc";
+
 static void PybindOnlinePunctuationModelConfig(py::module *m) {
   using PyClass = OnlinePunctuationModelConfig;
   py::class_<PyClass>(*m, "OnlinePunctuationModelConfig")
@@ -70,7 +83,11 @@ void PybindOnlinePunctuation(py::module *m) {
            kOnlinePunctuationInitDoc)
       .def("add_punctuation_with_case", &PyClass::AddPunctuationWithCase,
            py::arg("text"), py::call_guard<py::gil_scoped_release>(),
-           kOnlinePunctuationAddPunctuationWithCaseDoc);
+           kOnlinePunctuationAddPunctuationWithCaseDoc)
+      .def("add_punctuation_with_case_batch",
+           &PyClass::AddPunctuationWithCaseBatch, py::arg("texts"),
+           py::call_guard<py::gil_scoped_release>(),
+           kOnlinePunctuationAddPunctuationWithCaseBatchDoc);
 }
 
 }  // namespace sherpa_onnx
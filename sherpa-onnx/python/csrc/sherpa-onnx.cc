@@ -10,6 +10,7 @@
 #include "sherpa-onnx/python/csrc/display.h"
 #include "sherpa-onnx/python/csrc/endpoint.h"
 #include "sherpa-onnx/python/csrc/features.h"
+#include "sherpa-onnx/python/csrc/global-thread-pool.h"
 #include "sherpa-onnx/python/csrc/homophone-replacer.h"
 #include "sherpa-onnx/python/csrc/keyword-spotter.h"
 #include "sherpa-onnx/python/csrc/offline-ctc-fst-decoder-config.h"
@@ -124,6 +125,7 @@ PYBIND11_MODULE(_sherpa_onnx, m) {
   PybindOnlineSpeechDenoiser(&m);
   PybindOfflineSourceSeparation(&m);
   PybindVersion(&m);
+  PybindGlobalThreadPool(&m);
 }
 
 }  // namespace sherpa_onnx
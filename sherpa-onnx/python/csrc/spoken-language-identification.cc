@@ -5,6 +5,7 @@
 #include "sherpa-onnx/python/csrc/spoken-language-identification.h"
 
 #include <string>
+#include <vector>
 
 #include "sherpa-onnx/csrc/spoken-language-identification.h"
 
@@ -36,6 +37,19 @@ Returns:
   A string representing the identified language code.
 )doc";
 
+static constexpr const char *kSpokenLanguageIdentificationComputeBatchDoc =
+    R"doc(
+Identify the language of the audio in each of the given streams. Streams
+of similar lengths are processed together.
+
+Args:
+  ss:
+    A list of streams containing audio data.
+
+Returns:
+  A list of language codes. The i-th entry is for ss[i].
+)doc";
+
 static void PybindSpokenLanguageIdentificationWhisperConfig(py::module *m) {
   using PyClass = SpokenLanguageIdentificationWhisperConfig;
 
@@ -81,9 +95,18 @@ void PybindSpokenLanguageIdentification(py::module *m) {
       .def("create_stream", &PyClass::CreateStream,
            py::call_guard<py::gil_scoped_release>(),
            kSpokenLanguageIdentificationCreateStreamDoc)
-      .def("compute", &PyClass::Compute, py::arg("s"),
-           py::call_guard<py::gil_scoped_release>(),
-           kSpokenLanguageIdentificationComputeDoc);
+      .def(
+          "compute",
+          [](const PyClass &self, OfflineStream *s) { return self.Compute(s); },
+          py::arg("s"), py::call_guard<py::gil_scoped_release>(),
+          kSpokenLanguageIdentificationComputeDoc)
+      .def(
+          "compute_batch",
+          [](const PyClass &self, std::vector<OfflineStream *> ss) {
+            return self.Compute(ss.data(), ss.size());
+          },
+          py::arg("ss"), py::call_guard<py::gil_scoped_release>(),
+          kSpokenLanguageIdentificationComputeBatchDoc);
 }
 
 }  // namespace sherpa_onnx
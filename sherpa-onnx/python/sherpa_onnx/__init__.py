@@ -10,6 +10,7 @@ from sherpa_onnx.lib._sherpa_onnx import (
     FastClusteringConfig,
     FeatureExtractorConfig,
     GenerationConfig,
+    GlobalThreadPoolConfig,
     HomophoneReplacerConfig,
     OfflineCanaryModelConfig,
     OfflineCohereTranscribeModelConfig,
@@ -85,6 +86,8 @@ from sherpa_onnx.lib._sherpa_onnx import (
     VoiceActivityDetector,
     git_date,
     git_sha1,
+    has_global_thread_pools,
+    init_global_thread_pools,
     onnxruntime_version,
     version,
     write_wave,
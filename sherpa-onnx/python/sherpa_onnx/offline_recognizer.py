@@ -24,6 +24,7 @@ from sherpa_onnx.lib._sherpa_onnx import (
 )
 from sherpa_onnx.lib._sherpa_onnx import OfflineRecognizer as _Recognizer
 from sherpa_onnx.lib._sherpa_onnx import (
+    OfflineRecognitionResult,
     OfflineRecognizerConfig,
     OfflineSenseVoiceModelConfig,
     OfflineStream,
@@ -1906,3 +1907,48 @@ class OfflineRecognizer(object):
                 print(s.result.text)
         """
         self.recognizer.decode_streams(ss)
+
+    def decode_waveforms(
+        self,
+        sample_rate: int,
+        waveforms: List,
+        hotwords: Optional[List[str]] = None,
+    ) -> List[OfflineRecognitionResult]:
+        """Run speech recognition on a batch of waveforms.
+
+        It creates one stream per waveform, then extracts features and
+        decodes all of the streams in a single call with the GIL released.
+        It is much faster than looping over the waveforms in Python when
+        there are many of them. float32 C-contiguous arrays are read
+        without copying.
+
+        Args:
+          sample_rate:
+            Sample rate of all of the waveforms.
+          waveforms:
+            A list of 1-D float32 arrays normalized to the range [-1, 1].
+          hotwords:
+            Optional list of hotwords strings, one per waveform. See
+            :meth:`create_stream`.
+
+        Returns:
+          A list of recognition results. The i-th entry is the result of
+          ``waveforms[i]``.
+
+        Example::
+
+            results = recognizer.decode_waveforms(16000, [audio1, audio2])
+            for r in results:
+                print(r.text)
+        """
+        if hotwords is None:
+            ss = [self.recognizer.create_stream() for _ in waveforms]
+        else:
+            if len(hotwords) != len(waveforms):
+                raise ValueError(
+                    f"len(hotwords) should be equal to len(waveforms). "
+                    f"Given {len(hotwords)} vs {len(waveforms)}"
+                )
+            ss = [self.recognizer.create_stream(h) for h in hotwords]
+
+        return self.recognizer.decode_waveforms(ss, sample_rate, waveforms)
@@ -192,6 +192,57 @@ class TestOfflineRecognizer(unittest.TestCase):
         print(s2.result.text)
         print(s3.result.text)
 
+    def test_paraformer_decode_waveforms(self):
+        model = f"{d}/sherpa-onnx-paraformer-zh-2023-09-14/model.int8.onnx"
+
+        tokens = f"{d}/sherpa-onnx-paraformer-zh-2023-09-14/tokens.txt"
+        wave0 = f"{d}/sherpa-onnx-paraformer-zh-2023-09-14/test_wavs/0.wav"
+        wave1 = f"{d}/sherpa-onnx-paraformer-zh-2023-09-14/test_wavs/1.wav"
+        wave2 = f"{d}/sherpa-onnx-paraformer-zh-2023-09-14/test_wavs/2.wav"
+
+        if not Path(model).is_file():
+            print("skipping test_paraformer_decode_waveforms()")
+            return
+
+        recognizer = sherpa_onnx.OfflineRecognizer.from_paraformer(
+            paraformer=model,
+            tokens=tokens,
+            num_threads=1,
+            provider="cpu",
+        )
+
+        samples0, sample_rate = read_wave(wave0)
+        samples1, _ = read_wave(wave1)
+        samples2, _ = read_wave(wave2)
+
+        # float64 and non-contiguous arrays are converted
+        samples1 = samples1.astype(np.float64)
+        samples2 = np.repeat(samples2, 2)[::2]
+        self.assertFalse(samples2.flags["C_CONTIGUOUS"])
+
+        waveforms = [samples0, samples1, samples2]
+        results = recognizer.decode_waveforms(sample_rate, waveforms)
+        self.assertEqual(len(results), len(waveforms))
+
+        streams = []
+        for samples in waveforms:
+            s = recognizer.create_stream()
+            s.accept_waveform(sample_rate, samples)
+            streams.append(s)
+        recognizer.decode_streams(streams)
+
+        for r, s in zip(results, streams):
+            print(r.text)
+            self.assertEqual(r.text, s.result.text)
+
+        with self.assertRaises(ValueError):
+            recognizer.decode_waveforms(sample_rate, waveforms, hotwords=["a"])
+
+        with self.assertRaises(ValueError):
+            recognizer.decode_waveforms(
+                sample_rate, [np.zeros((2, 100), dtype=np.float32)]
+            )
+
     def test_nemo_ctc_single_file(self):
         for use_int8 in [True, False]:
             if use_int8:
@@ -79,6 +79,7 @@ pub struct OfflineTtsPocketModelConfig {
     pub vocab_json: *const c_char,
     pub token_scores_json: *const c_char,
     pub voice_embedding_cache_capacity: i32,
+    pub voice_embedding_cache_dir: *const c_char,
 }
 
 #[repr(C)]
@@ -290,6 +290,7 @@ pub struct OfflineTtsPocketModelConfig {
     pub vocab_json: Option<String>,
     pub token_scores_json: Option<String>,
     pub voice_embedding_cache_capacity: i32,
+    pub voice_embedding_cache_dir: Option<String>,
 }
 
 impl OfflineTtsPocketModelConfig {
@@ -303,6 +304,7 @@ impl OfflineTtsPocketModelConfig {
             vocab_json: to_c_ptr(&self.vocab_json, cstrings),
             token_scores_json: to_c_ptr(&self.token_scores_json, cstrings),
             voice_embedding_cache_capacity: self.voice_embedding_cache_capacity,
+            voice_embedding_cache_dir: to_c_ptr(&self.voice_embedding_cache_dir, cstrings),
         }
     }
 }
@@ -1131,7 +1131,8 @@ public func sherpaOnnxOfflineTtsPocketModelConfig(
   textConditioner: String = "",
   vocabJson: String = "",
   tokenScoresJson: String = "",
-  voiceEmbeddingCacheCapacity: Int = 50
+  voiceEmbeddingCacheCapacity: Int = 50,
+  voiceEmbeddingCacheDir: String = ""
 ) -> SherpaOnnxOfflineTtsPocketModelConfig {
   return SherpaOnnxOfflineTtsPocketModelConfig(
     lm_flow: toCPointer(lmFlow),
@@ -1141,7 +1142,8 @@ public func sherpaOnnxOfflineTtsPocketModelConfig(
     text_conditioner: toCPointer(textConditioner),
     vocab_json: toCPointer(vocabJson),
     token_scores_json: toCPointer(tokenScoresJson),
-    voice_embedding_cache_capacity: Int32(voiceEmbeddingCacheCapacity)
+    voice_embedding_cache_capacity: Int32(voiceEmbeddingCacheCapacity),
+    voice_embedding_cache_dir: toCPointer(voiceEmbeddingCacheDir)
   )
 }
 
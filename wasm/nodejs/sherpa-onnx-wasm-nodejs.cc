@@ -130,6 +130,8 @@ void PrintOfflineTtsConfig(SherpaOnnxOfflineTtsConfig *tts_config) {
   fprintf(stdout, "token_scores_json: %s\n", pocket->token_scores_json);
   fprintf(stdout, "voice_embedding_cache_capacity: %d\n",
           pocket->voice_embedding_cache_capacity);
+  fprintf(stdout, "voice_embedding_cache_dir: %s\n",
+          pocket->voice_embedding_cache_dir);
 
   fprintf(stdout, "----------supertonic model config----------\n");
   fprintf(stdout, "duration_predictor: %s\n", supertonic->duration_predictor);
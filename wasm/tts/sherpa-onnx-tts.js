@@ -361,14 +361,17 @@ function initSherpaOnnxOfflineTtsPocketModelConfig(config, Module) {
   const vocabJsonLen = Module.lengthBytesUTF8(config.vocabJson || '') + 1;
   const tokenScoresJsonLen =
       Module.lengthBytesUTF8(config.tokenScoresJson || '') + 1;
+  const voiceEmbeddingCacheDirLen =
+      Module.lengthBytesUTF8(config.voiceEmbeddingCacheDir || '') + 1;
 
 
   const n = lmFlowLen + lmMainLen + encoderLen + decoderLen +
-      textConditionerLen + vocabJsonLen + tokenScoresJsonLen;
+      textConditionerLen + vocabJsonLen + tokenScoresJsonLen +
+      voiceEmbeddingCacheDirLen;
 
   const buffer = Module._malloc(n);
 
-  const len = 8 * 4;
+  const len = 9 * 4;
   const ptr = Module._malloc(len);
 
   let offset = 0;
@@ -395,6 +398,11 @@ function initSherpaOnnxOfflineTtsPocketModelConfig(config, Module) {
       config.tokenScoresJson || '', buffer + offset, tokenScoresJsonLen);
   offset += tokenScoresJsonLen;
 
+  Module.stringToUTF8(
+      config.voiceEmbeddingCacheDir || '', buffer + offset,
+      voiceEmbeddingCacheDirLen);
+  offset += voiceEmbeddingCacheDirLen;
+
   offset = 0;
   Module.setValue(ptr + 0 * 4, buffer + offset, 'i8*');
   offset += lmFlowLen;
@@ -424,6 +432,9 @@ function initSherpaOnnxOfflineTtsPocketModelConfig(config, Module) {
           50,
       'i32');
 
+  Module.setValue(ptr + 8 * 4, buffer + offset, 'i8*');
+  offset += voiceEmbeddingCacheDirLen;
+
   return {
     buffer: buffer,
     ptr: ptr,
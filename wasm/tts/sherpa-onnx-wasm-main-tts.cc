@@ -18,7 +18,7 @@ static_assert(sizeof(SherpaOnnxOfflineTtsMatchaModelConfig) == 8 * 4, "");
 static_assert(sizeof(SherpaOnnxOfflineTtsKokoroModelConfig) == 8 * 4, "");
 static_assert(sizeof(SherpaOnnxOfflineTtsKittenModelConfig) == 5 * 4, "");
 static_assert(sizeof(SherpaOnnxOfflineTtsZipvoiceModelConfig) == 10 * 4, "");
-static_assert(sizeof(SherpaOnnxOfflineTtsPocketModelConfig) == 8 * 4, "");
+static_assert(sizeof(SherpaOnnxOfflineTtsPocketModelConfig) == 9 * 4, "");
 static_assert(sizeof(SherpaOnnxOfflineTtsSupertonicModelConfig) == 7 * 4, "");
 static_assert(sizeof(SherpaOnnxOfflineTtsModelConfig) ==
                   sizeof(SherpaOnnxOfflineTtsVitsModelConfig) +
@@ -103,6 +103,8 @@ void MyPrint(SherpaOnnxOfflineTtsConfig *tts_config) {
   fprintf(stdout, "token_scores_json: %s\n", pocket->token_scores_json);
   fprintf(stdout, "voice_embedding_cache_capacity: %d\n",
           pocket->voice_embedding_cache_capacity);
+  fprintf(stdout, "voice_embedding_cache_dir: %s\n",
+          pocket->voice_embedding_cache_dir);
 
   auto supertonic = &tts_model_config->supertonic;
   fprintf(stdout, "----------supertonic model config----------\n");